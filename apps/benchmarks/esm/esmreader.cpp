@@ -0,0 +1,183 @@
+#include <benchmark/benchmark.h>
+
+#include <components/bsa/memorystream.hpp>
+#include <components/esm/records.hpp>
+#include <components/esm3/esmreader.hpp>
+#include <components/to_utf8/to_utf8.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    std::atomic<std::size_t> allocations{ 0 };
+    std::atomic<std::size_t> allocatedBytes{ 0 };
+}
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    allocatedBytes += size;
+    if (void* const result = std::malloc(size == 0 ? 1 : size))
+        return result;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept
+{
+    std::free(ptr);
+}
+
+namespace
+{
+    /// Loads Morrowind.esm, Tribunal.esm and Bloodmoon.esm from directory given by OPENMW_BENCHMARK_DATA environment
+    /// variable, e.g. Morrowind Data Files directory. Missing files are ignored.
+    const std::vector<std::pair<std::filesystem::path, std::vector<char>>>& getContentFiles()
+    {
+        static const std::vector<std::pair<std::filesystem::path, std::vector<char>>> files = [] {
+            std::vector<std::pair<std::filesystem::path, std::vector<char>>> result;
+            const char* const directory = std::getenv("OPENMW_BENCHMARK_DATA");
+            if (directory == nullptr)
+                return result;
+            for (const char* name : { "Morrowind.esm", "Tribunal.esm", "Bloodmoon.esm" })
+            {
+                const std::filesystem::path path = std::filesystem::path(directory) / name;
+                std::ifstream stream(path, std::ios_base::binary);
+                if (!stream)
+                    continue;
+                result.emplace_back(path,
+                    std::vector<char>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()));
+            }
+            return result;
+        }();
+        return files;
+    }
+
+    template <class T>
+    void loadRecord(ESM::ESMReader& reader)
+    {
+        T record;
+        bool isDeleted = false;
+        record.load(reader, isDeleted);
+        benchmark::DoNotOptimize(record);
+    }
+
+    using LoadRecord = void (*)(ESM::ESMReader& reader);
+
+    const std::map<ESM::RecNameInts, LoadRecord>& getLoaders()
+    {
+        static const std::map<ESM::RecNameInts, LoadRecord> loaders{
+            { ESM::REC_ACTI, &loadRecord<ESM::Activator> },
+            { ESM::REC_ALCH, &loadRecord<ESM::Potion> },
+            { ESM::REC_APPA, &loadRecord<ESM::Apparatus> },
+            { ESM::REC_ARMO, &loadRecord<ESM::Armor> },
+            { ESM::REC_BODY, &loadRecord<ESM::BodyPart> },
+            { ESM::REC_BOOK, &loadRecord<ESM::Book> },
+            { ESM::REC_BSGN, &loadRecord<ESM::BirthSign> },
+            { ESM::REC_CELL, &loadRecord<ESM::Cell> },
+            { ESM::REC_CLAS, &loadRecord<ESM::Class> },
+            { ESM::REC_CLOT, &loadRecord<ESM::Clothing> },
+            { ESM::REC_CONT, &loadRecord<ESM::Container> },
+            { ESM::REC_CREA, &loadRecord<ESM::Creature> },
+            { ESM::REC_DIAL, &loadRecord<ESM::Dialogue> },
+            { ESM::REC_DOOR, &loadRecord<ESM::Door> },
+            { ESM::REC_ENCH, &loadRecord<ESM::Enchantment> },
+            { ESM::REC_FACT, &loadRecord<ESM::Faction> },
+            { ESM::REC_GLOB, &loadRecord<ESM::Global> },
+            { ESM::REC_GMST, &loadRecord<ESM::GameSetting> },
+            { ESM::REC_INFO, &loadRecord<ESM::DialInfo> },
+            { ESM::REC_INGR, &loadRecord<ESM::Ingredient> },
+            { ESM::REC_LAND, &loadRecord<ESM::Land> },
+            { ESM::REC_LEVC, &loadRecord<ESM::CreatureLevList> },
+            { ESM::REC_LEVI, &loadRecord<ESM::ItemLevList> },
+            { ESM::REC_LIGH, &loadRecord<ESM::Light> },
+            { ESM::REC_LOCK, &loadRecord<ESM::Lockpick> },
+            { ESM::REC_LTEX, &loadRecord<ESM::LandTexture> },
+            { ESM::REC_MGEF, &loadRecord<ESM::MagicEffect> },
+            { ESM::REC_MISC, &loadRecord<ESM::Miscellaneous> },
+            { ESM::REC_NPC_, &loadRecord<ESM::NPC> },
+            { ESM::REC_PGRD, &loadRecord<ESM::Pathgrid> },
+            { ESM::REC_PROB, &loadRecord<ESM::Probe> },
+            { ESM::REC_RACE, &loadRecord<ESM::Race> },
+            { ESM::REC_REGN, &loadRecord<ESM::Region> },
+            { ESM::REC_REPA, &loadRecord<ESM::Repair> },
+            { ESM::REC_SCPT, &loadRecord<ESM::Script> },
+            { ESM::REC_SKIL, &loadRecord<ESM::Skill> },
+            { ESM::REC_SNDG, &loadRecord<ESM::SoundGenerator> },
+            { ESM::REC_SOUN, &loadRecord<ESM::Sound> },
+            { ESM::REC_SPEL, &loadRecord<ESM::Spell> },
+            { ESM::REC_SSCR, &loadRecord<ESM::StartScript> },
+            { ESM::REC_STAT, &loadRecord<ESM::Static> },
+            { ESM::REC_WEAP, &loadRecord<ESM::Weapon> },
+        };
+        return loaders;
+    }
+
+    void loadContentFile(const std::filesystem::path& path, const std::vector<char>& data,
+        ToUTF8::Utf8Encoder& encoder, std::size_t& records)
+    {
+        auto stream = std::make_unique<Bsa::MemoryInputStream>(data.size());
+        std::memcpy(stream->getRawData(), data.data(), data.size());
+        ESM::ESMReader reader;
+        reader.setEncoder(&encoder);
+        reader.open(std::move(stream), path);
+        const std::map<ESM::RecNameInts, LoadRecord>& loaders = getLoaders();
+        while (reader.hasMoreRecs())
+        {
+            const ESM::NAME name = reader.getRecName();
+            reader.getRecHeader();
+            const auto it = loaders.find(static_cast<ESM::RecNameInts>(name.toInt()));
+            if (it != loaders.end())
+            {
+                it->second(reader);
+                ++records;
+            }
+            // Cell references and unknown records
+            if (reader.hasMoreSubs())
+                reader.skipRecord();
+        }
+    }
+
+    void loadContentFiles(benchmark::State& state)
+    {
+        const auto& files = getContentFiles();
+        if (files.empty())
+        {
+            state.SkipWithError("OPENMW_BENCHMARK_DATA should point to a directory with Morrowind.esm");
+            return;
+        }
+        ToUTF8::Utf8Encoder encoder(ToUTF8::WINDOWS_1252);
+        std::size_t records = 0;
+        const std::size_t allocationsBefore = allocations;
+        const std::size_t allocatedBytesBefore = allocatedBytes;
+        for (auto _ : state)
+            for (const auto& [path, data] : files)
+                loadContentFile(path, data, encoder, records);
+        state.counters["records"]
+            = benchmark::Counter(static_cast<double>(records), benchmark::Counter::kAvgIterations);
+        state.counters["allocations"] = benchmark::Counter(
+            static_cast<double>(allocations - allocationsBefore), benchmark::Counter::kAvgIterations);
+        state.counters["allocatedBytes"] = benchmark::Counter(
+            static_cast<double>(allocatedBytes - allocatedBytesBefore), benchmark::Counter::kAvgIterations);
+    }
+}
+
+BENCHMARK(loadContentFiles)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
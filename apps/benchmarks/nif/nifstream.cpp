@@ -0,0 +1,168 @@
+#include <benchmark/benchmark.h>
+
+#include <components/bsa/memorystream.hpp>
+#include <components/files/conversion.hpp>
+#include <components/misc/strings/lower.hpp>
+#include <components/nif/niffile.hpp>
+#include <components/nif/nifstream.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t valuesCount = 1 << 20;
+
+    std::vector<char> generateData(std::size_t size)
+    {
+        std::minstd_rand random;
+        std::uniform_real_distribution<float> distribution(-1000, 1000);
+        std::vector<char> result(size * sizeof(float));
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const float value = distribution(random);
+            std::memcpy(result.data() + i * sizeof(float), &value, sizeof(float));
+        }
+        return result;
+    }
+
+    Files::IStreamPtr makeMemoryStream(const std::vector<char>& data)
+    {
+        auto result = std::make_unique<Bsa::MemoryInputStream>(data.size());
+        std::memcpy(result->getRawData(), data.data(), data.size());
+        return result;
+    }
+
+    Files::IStreamPtr makeStringStream(const std::vector<char>& data)
+    {
+        return std::make_unique<std::istringstream>(std::string(data.begin(), data.end()));
+    }
+
+    /// Loads all NIF files from directory given by OPENMW_BENCHMARK_DATA environment variable, e.g. Morrowind Data
+    /// Files directory with meshes extracted from the archives.
+    const std::vector<std::pair<std::filesystem::path, std::vector<char>>>& getDataFiles()
+    {
+        static const std::vector<std::pair<std::filesystem::path, std::vector<char>>> files = [] {
+            std::vector<std::pair<std::filesystem::path, std::vector<char>>> result;
+            const char* const directory = std::getenv("OPENMW_BENCHMARK_DATA");
+            if (directory == nullptr)
+                return result;
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(directory))
+            {
+                if (!entry.is_regular_file()
+                    || Misc::StringUtils::lowerCase(Files::pathToUnicodeString(entry.path().extension())) != ".nif")
+                    continue;
+                std::ifstream stream(entry.path(), std::ios_base::binary);
+                result.emplace_back(entry.path(),
+                    std::vector<char>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>()));
+            }
+            return result;
+        }();
+        return files;
+    }
+
+    template <Files::IStreamPtr (*makeStream)(const std::vector<char>&)>
+    void readFloats(benchmark::State& state)
+    {
+        const std::vector<char> data = generateData(valuesCount);
+        Nif::NIFFile file("synthetic");
+        const Nif::Reader reader(file);
+        for (auto _ : state)
+        {
+            Nif::NIFStream stream(reader, makeStream(data));
+            for (std::size_t i = 0; i < valuesCount; ++i)
+                benchmark::DoNotOptimize(stream.getFloat());
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * data.size()));
+    }
+
+    template <Files::IStreamPtr (*makeStream)(const std::vector<char>&)>
+    void readVector3s(benchmark::State& state)
+    {
+        const std::vector<char> data = generateData(valuesCount * 3);
+        Nif::NIFFile file("synthetic");
+        const Nif::Reader reader(file);
+        std::vector<osg::Vec3f> values;
+        for (auto _ : state)
+        {
+            Nif::NIFStream stream(reader, makeStream(data));
+            stream.getVector3s(values, valuesCount);
+            benchmark::DoNotOptimize(values.data());
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * data.size()));
+    }
+
+    template <Files::IStreamPtr (*makeStream)(const std::vector<char>&)>
+    void parseDataFiles(benchmark::State& state)
+    {
+        const auto& files = getDataFiles();
+        if (files.empty())
+        {
+            state.SkipWithError("OPENMW_BENCHMARK_DATA is not set or has no NIF files");
+            return;
+        }
+        std::size_t bytes = 0;
+        for (auto _ : state)
+        {
+            for (const auto& [path, data] : files)
+            {
+                Nif::NIFFile file(path);
+                Nif::Reader reader(file);
+                reader.parse(makeStream(data));
+                benchmark::DoNotOptimize(file.mRecords.data());
+                bytes += data.size();
+            }
+        }
+        state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+        state.SetItemsProcessed(static_cast<std::int64_t>(state.iterations() * files.size()));
+    }
+
+    void readFloatsFromMemoryStream(benchmark::State& state)
+    {
+        readFloats<makeMemoryStream>(state);
+    }
+
+    void readFloatsFromStringStream(benchmark::State& state)
+    {
+        readFloats<makeStringStream>(state);
+    }
+
+    void readVector3sFromMemoryStream(benchmark::State& state)
+    {
+        readVector3s<makeMemoryStream>(state);
+    }
+
+    void readVector3sFromStringStream(benchmark::State& state)
+    {
+        readVector3s<makeStringStream>(state);
+    }
+
+    void parseDataFilesFromMemoryStream(benchmark::State& state)
+    {
+        parseDataFiles<makeMemoryStream>(state);
+    }
+
+    void parseDataFilesFromStringStream(benchmark::State& state)
+    {
+        parseDataFiles<makeStringStream>(state);
+    }
+}
+
+BENCHMARK(readFloatsFromMemoryStream);
+BENCHMARK(readFloatsFromStringStream);
+BENCHMARK(readVector3sFromMemoryStream);
+BENCHMARK(readVector3sFromStringStream);
+BENCHMARK(parseDataFilesFromMemoryStream)->Unit(benchmark::kMillisecond);
+BENCHMARK(parseDataFilesFromStringStream)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
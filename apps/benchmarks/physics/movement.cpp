@@ -0,0 +1,165 @@
+#include <benchmark/benchmark.h>
+
+#include <apps/openmw/mwphysics/movementbatches.hpp>
+
+#include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcher.h>
+#include <BulletCollision/CollisionDispatch/btCollisionObject.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
+#include <BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.h>
+#include <BulletCollision/CollisionShapes/btBoxShape.h>
+#include <BulletCollision/CollisionShapes/btCapsuleShape.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace
+{
+    constexpr float cellSize = 8192;
+    constexpr float pillarsStep = 512;
+    constexpr float timeStep = 1.0f / 60;
+    constexpr std::size_t maxBatchSize = 16;
+
+    struct IgnoreSelfCallback : btCollisionWorld::ClosestConvexResultCallback
+    {
+        const btCollisionObject* mSelf;
+
+        explicit IgnoreSelfCallback(const btCollisionObject* self, const btVector3& from, const btVector3& to)
+            : btCollisionWorld::ClosestConvexResultCallback(from, to)
+            , mSelf(self)
+        {
+        }
+
+        btScalar addSingleResult(btCollisionWorld::LocalConvexResult& result, bool normalInWorldSpace) override
+        {
+            if (result.m_hitCollisionObject == mSelf)
+                return 1;
+            return btCollisionWorld::ClosestConvexResultCallback::addSingleResult(result, normalInWorldSpace);
+        }
+    };
+
+    /// Simplified version of the actor movement: a sweep along the velocity followed by a sweep to the ground,
+    /// both done in the same collision world as the real solver does.
+    class Scene
+    {
+    public:
+        explicit Scene(std::size_t actorsCount)
+            : mDispatcher(&mConfiguration)
+            , mWorld(&mDispatcher, &mBroadphase, &mConfiguration)
+            , mGroundShape(btVector3(cellSize / 2, cellSize / 2, 16))
+            , mPillarShape(btVector3(32, 32, 256))
+            , mActorShape(24, 80)
+        {
+            addStatic(mGroundShape, btVector3(0, 0, -16));
+            for (float x = -cellSize / 2 + pillarsStep / 2; x < cellSize / 2; x += pillarsStep)
+                for (float y = -cellSize / 2 + pillarsStep / 2; y < cellSize / 2; y += pillarsStep)
+                    addStatic(mPillarShape, btVector3(x, y, 256));
+
+            std::minstd_rand random;
+            std::uniform_real_distribution<float> position(-cellSize / 2, cellSize / 2);
+            std::uniform_real_distribution<float> velocity(-300, 300);
+            for (std::size_t i = 0; i < actorsCount; ++i)
+            {
+                auto& object = mActors.emplace_back(std::make_unique<btCollisionObject>());
+                object->setCollisionShape(&mActorShape);
+                object->setWorldTransform(
+                    btTransform(btMatrix3x3::getIdentity(), btVector3(position(random), position(random), 64)));
+                mWorld.addCollisionObject(object.get());
+                mVelocities.emplace_back(velocity(random), velocity(random), 0);
+            }
+            // Simulation order doesn't depend on actor positions
+            std::shuffle(mActors.begin(), mActors.end(), random);
+        }
+
+        std::size_t getActorsCount() const { return mActors.size(); }
+
+        void fillPositions(std::vector<osg::Vec3f>& positions) const
+        {
+            positions.clear();
+            for (const auto& object : mActors)
+            {
+                const btVector3& origin = object->getWorldTransform().getOrigin();
+                positions.emplace_back(origin.x(), origin.y(), origin.z());
+            }
+        }
+
+        void move(std::size_t index)
+        {
+            btCollisionObject& object = *mActors[index];
+            const btTransform from = object.getWorldTransform();
+            btTransform to(from.getBasis(), from.getOrigin() + mVelocities[index] * timeStep);
+
+            IgnoreSelfCallback forward(&object, from.getOrigin(), to.getOrigin());
+            forward.m_collisionFilterGroup = btBroadphaseProxy::DefaultFilter;
+            forward.m_collisionFilterMask = btBroadphaseProxy::AllFilter;
+            mWorld.convexSweepTest(&mActorShape, from, to, forward);
+            if (forward.hasHit())
+            {
+                to.setOrigin(from.getOrigin().lerp(to.getOrigin(), forward.m_closestHitFraction));
+                mVelocities[index] = -mVelocities[index];
+            }
+
+            const btTransform down(to.getBasis(), to.getOrigin() - btVector3(0, 0, 128));
+            IgnoreSelfCallback ground(&object, to.getOrigin(), down.getOrigin());
+            mWorld.convexSweepTest(&mActorShape, to, down, ground);
+            if (ground.hasHit())
+                to.setOrigin(to.getOrigin().lerp(down.getOrigin(), ground.m_closestHitFraction));
+
+            object.setWorldTransform(to);
+            mWorld.updateSingleAabb(&object);
+        }
+
+    private:
+        btDefaultCollisionConfiguration mConfiguration;
+        btCollisionDispatcher mDispatcher;
+        btDbvtBroadphase mBroadphase;
+        btCollisionWorld mWorld;
+        btBoxShape mGroundShape;
+        btBoxShape mPillarShape;
+        btCapsuleShapeZ mActorShape;
+        std::vector<std::unique_ptr<btCollisionObject>> mStatics;
+        std::vector<std::unique_ptr<btCollisionObject>> mActors;
+        std::vector<btVector3> mVelocities;
+
+        void addStatic(btCollisionShape& shape, const btVector3& position)
+        {
+            auto& object = mStatics.emplace_back(std::make_unique<btCollisionObject>());
+            object->setCollisionShape(&shape);
+            object->setWorldTransform(btTransform(btMatrix3x3::getIdentity(), position));
+            mWorld.addCollisionObject(object.get(), btBroadphaseProxy::StaticFilter);
+        }
+    };
+
+    void moveInSimulationOrder(benchmark::State& state)
+    {
+        Scene scene(static_cast<std::size_t>(state.range(0)));
+        for (auto _ : state)
+            for (std::size_t i = 0; i < scene.getActorsCount(); ++i)
+                scene.move(i);
+    }
+
+    void moveInBatches(benchmark::State& state)
+    {
+        Scene scene(static_cast<std::size_t>(state.range(0)));
+        std::vector<osg::Vec3f> positions;
+        MWPhysics::MovementBatches batches;
+        for (auto _ : state)
+        {
+            scene.fillPositions(positions);
+            batches.build(positions, maxBatchSize);
+            for (std::size_t batch = 0; batch < batches.getBatchesCount(); ++batch)
+                for (std::size_t i : batches.getBatch(batch))
+                    scene.move(i);
+        }
+    }
+}
+
+BENCHMARK(moveInSimulationOrder)->Arg(200)->Arg(500)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(moveInBatches)->Arg(200)->Arg(500)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
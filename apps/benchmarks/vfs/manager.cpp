@@ -0,0 +1,190 @@
+#include <benchmark/benchmark.h>
+
+#include <components/vfs/archive.hpp>
+#include <components/vfs/manager.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    constexpr std::size_t filesCount = 500000;
+
+    struct SyntheticFile : VFS::File
+    {
+        std::filesystem::path mPath;
+
+        explicit SyntheticFile(const std::string& path)
+            : mPath(path)
+        {
+        }
+
+        Files::IStreamPtr open() override { return nullptr; }
+
+        std::filesystem::path getPath() override { return mPath; }
+    };
+
+    struct SyntheticArchive : VFS::Archive
+    {
+        std::map<std::string, SyntheticFile> mFiles;
+
+        explicit SyntheticArchive(const std::vector<std::string>& paths)
+        {
+            for (const std::string& path : paths)
+                mFiles.emplace(path, SyntheticFile(path));
+        }
+
+        void listResources(std::map<std::string, VFS::File*>& out, char (*normalize_function)(char)) override
+        {
+            for (auto& [path, file] : mFiles)
+            {
+                std::string normalized = path;
+                std::transform(normalized.begin(), normalized.end(), normalized.begin(), normalize_function);
+                out[normalized] = &file;
+            }
+        }
+
+        bool contains(const std::string& file, char (*normalize_function)(char)) const override
+        {
+            return mFiles.find(file) != mFiles.end();
+        }
+
+        std::string getDescription() const override { return "synthetic"; }
+    };
+
+    template <typename Random>
+    std::string generatePath(Random& random)
+    {
+        static const char* const directories[]
+            = { "Meshes\\", "Textures\\", "Icons\\", "Sound\\Fx\\", "Music\\Explore\\", "Meshes\\x\\", "Meshes\\f\\" };
+        static const char* const extensions[] = { ".nif", ".dds", ".tga", ".wav", ".mp3", ".kf" };
+        std::uniform_int_distribution<std::size_t> directory(0, std::size(directories) - 1);
+        std::uniform_int_distribution<std::size_t> extension(0, std::size(extensions) - 1);
+        std::uniform_int_distribution<std::size_t> length(6, 32);
+        std::uniform_int_distribution<int> letter('a', 'z');
+        std::uniform_int_distribution<int> upper(0, 3);
+        std::string result = directories[directory(random)];
+        const std::size_t nameLength = length(random);
+        for (std::size_t i = 0; i < nameLength; ++i)
+        {
+            const char ch = static_cast<char>(letter(random));
+            result += upper(random) == 0 ? static_cast<char>(ch - 'a' + 'A') : ch;
+        }
+        result += extensions[extension(random)];
+        return result;
+    }
+
+    struct Fixture
+    {
+        std::vector<std::string> mPaths;
+        VFS::Manager mManager{ false };
+
+        Fixture()
+        {
+            std::minstd_rand random;
+            mPaths.reserve(filesCount);
+            std::generate_n(std::back_inserter(mPaths), filesCount, [&] { return generatePath(random); });
+            mManager.addArchive(std::make_unique<SyntheticArchive>(mPaths));
+            mManager.buildIndex();
+        }
+    };
+
+    const Fixture& getFixture()
+    {
+        static const Fixture fixture;
+        return fixture;
+    }
+
+    template <int hitPercentage>
+    void exists(benchmark::State& state)
+    {
+        const Fixture& fixture = getFixture();
+        std::minstd_rand random;
+        std::vector<std::string> names;
+        const std::size_t hits = fixture.mPaths.size() * hitPercentage / 100;
+        std::sample(fixture.mPaths.begin(), fixture.mPaths.end(), std::back_inserter(names), hits, random);
+        std::generate_n(std::back_inserter(names), fixture.mPaths.size() - hits,
+            [&] { return generatePath(random) + ".missing"; });
+        std::shuffle(names.begin(), names.end(), random);
+        std::size_t n = 0;
+
+        for (auto _ : state)
+        {
+            const bool result = fixture.mManager.exists(names[n++ % names.size()]);
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void exists_100hit(benchmark::State& state)
+    {
+        exists<100>(state);
+    }
+
+    void exists_70hit(benchmark::State& state)
+    {
+        exists<70>(state);
+    }
+
+    void getNormalized(benchmark::State& state)
+    {
+        const Fixture& fixture = getFixture();
+        std::minstd_rand random;
+        std::vector<std::string> names;
+        std::sample(fixture.mPaths.begin(), fixture.mPaths.end(), std::back_inserter(names), fixture.mPaths.size(),
+            random);
+        for (std::string& name : names)
+            name = fixture.mManager.normalizeFilename(name);
+        std::shuffle(names.begin(), names.end(), random);
+        std::size_t n = 0;
+
+        for (auto _ : state)
+        {
+            auto result = fixture.mManager.getNormalized(names[n++ % names.size()]);
+            benchmark::DoNotOptimize(result);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    void getRecursiveDirectoryIterator(benchmark::State& state)
+    {
+        const Fixture& fixture = getFixture();
+
+        for (auto _ : state)
+        {
+            std::size_t count = 0;
+            for (const auto& name : fixture.mManager.getRecursiveDirectoryIterator("Music/Explore/"))
+            {
+                benchmark::DoNotOptimize(name);
+                ++count;
+            }
+            benchmark::DoNotOptimize(count);
+        }
+    }
+
+    void buildIndex(benchmark::State& state)
+    {
+        std::minstd_rand random;
+        std::vector<std::string> paths;
+        std::generate_n(std::back_inserter(paths), filesCount, [&] { return generatePath(random); });
+        VFS::Manager manager(false);
+        manager.addArchive(std::make_unique<SyntheticArchive>(paths));
+
+        for (auto _ : state)
+            manager.buildIndex();
+    }
+} // namespace
+
+BENCHMARK(exists_100hit);
+BENCHMARK(exists_70hit);
+BENCHMARK(getNormalized);
+BENCHMARK(getRecursiveDirectoryIterator);
+BENCHMARK(buildIndex)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -3,16 +3,22 @@
 #include <exception>
 #include <filesystem>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include <components/bsa/compressedbsafile.hpp>
+#include <components/bsa/memorystream.hpp>
 #include <components/files/configurationmanager.hpp>
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
 #include <components/misc/strings/algorithm.hpp>
 #include <components/nif/niffile.hpp>
+#include <components/resource/niffilecache.hpp>
 #include <components/vfs/archive.hpp>
 #include <components/vfs/bsaarchive.hpp>
 #include <components/vfs/filesystemarchive.hpp>
@@ -41,9 +47,33 @@ bool isBSA(const std::filesystem::path& filename)
     return hasExtension(filename, "bsa");
 }
 
+/// Open a BSA archive of any supported version
+std::unique_ptr<VFS::Archive> makeBsaArchive(const std::filesystem::path& path)
+{
+    if (Bsa::CompressedBSAFile::detectVersion(path) == Bsa::BSAVER_COMPRESSED)
+        return std::make_unique<VFS::CompressedBsaArchive>(path);
+    return std::make_unique<VFS::BsaArchive>(path);
+}
+
+/// Read the nif file from the VFS storing it in the cache when it comes from a compressed archive
+Files::IStreamPtr openNIF(const VFS::Manager& vfs, const std::string& name, const Resource::NifFileCache* cache)
+{
+    if (cache == nullptr)
+        return vfs.get(name);
+    const std::filesystem::path archive = vfs.getCompressedArchivePath(name);
+    if (archive.empty())
+        return vfs.get(name);
+    Files::IStreamPtr stream = vfs.get(name);
+    auto content = std::make_shared<const std::vector<char>>(
+        std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
+    cache->set(name, archive, std::string_view(content->data(), content->size()));
+    return std::make_unique<Bsa::SharedMemoryInputStream>(std::move(content));
+}
+
 /// Check all the nif files in a given VFS::Archive
 /// \note Can not read a bsa file inside of a bsa file.
-void readVFS(std::unique_ptr<VFS::Archive>&& anArchive, const std::filesystem::path& archivePath = {})
+void readVFS(std::unique_ptr<VFS::Archive>&& anArchive, const std::filesystem::path& archivePath = {},
+    const Resource::NifFileCache* cache = nullptr)
 {
     VFS::Manager myManager(true);
     myManager.addArchive(std::move(anArchive));
@@ -58,14 +88,14 @@ void readVFS(std::unique_ptr<VFS::Archive>&& anArchive, const std::filesystem::p
                 //           std::cout << "Decoding: " << name << std::endl;
                 Nif::NIFFile file(archivePath / name);
                 Nif::Reader reader(file);
-                reader.parse(myManager.get(name));
+                reader.parse(openNIF(myManager, name, cache));
             }
             else if (isBSA(name))
             {
                 if (!archivePath.empty() && !isBSA(archivePath))
                 {
                     //                     std::cout << "Reading BSA File: " << name << std::endl;
-                    readVFS(std::make_unique<VFS::BsaArchive>(archivePath / name), archivePath / name);
+                    readVFS(makeBsaArchive(archivePath / name), archivePath / name, cache);
                     //                     std::cout << "Done with BSA File: " << name << std::endl;
                 }
             }
@@ -77,7 +107,8 @@ void readVFS(std::unique_ptr<VFS::Archive>&& anArchive, const std::filesystem::p
     }
 }
 
-bool parseOptions(int argc, char** argv, std::vector<Files::MaybeQuotedPath>& files)
+bool parseOptions(int argc, char** argv, std::vector<Files::MaybeQuotedPath>& files,
+    std::optional<std::filesystem::path>& cacheDir)
 {
     bpo::options_description desc(R"(Ensure that OpenMW can use the provided NIF and BSA files
 
@@ -89,6 +120,9 @@ Allowed options)");
     auto addOption = desc.add_options();
     addOption("help,h", "print help message.");
     addOption("input-file", bpo::value<Files::MaybeQuotedPathContainer>(), "input file");
+    addOption("cache-dir", bpo::value<Files::MaybeQuotedPath>(),
+        "store nif files read from compressed BSA archives in the nif file cache at the given directory (usually the "
+        "nif subdirectory of the OpenMW cache directory) to load them faster in OpenMW with 'nif file cache' enabled");
 
     // Default option if none provided
     bpo::positional_options_description p;
@@ -105,6 +139,8 @@ Allowed options)");
             std::cout << desc << std::endl;
             return false;
         }
+        if (variables.count("cache-dir"))
+            cacheDir = variables["cache-dir"].as<Files::MaybeQuotedPath>();
         if (variables.count("input-file"))
         {
             files = variables["input-file"].as<Files::MaybeQuotedPathContainer>();
@@ -125,9 +161,15 @@ Allowed options)");
 int main(int argc, char** argv)
 {
     std::vector<Files::MaybeQuotedPath> files;
-    if (!parseOptions(argc, argv, files))
+    std::optional<std::filesystem::path> cacheDir;
+    if (!parseOptions(argc, argv, files, cacheDir))
         return 1;
 
+    std::optional<Resource::NifFileCache> cache;
+    if (cacheDir.has_value())
+        cache.emplace(*cacheDir);
+    const Resource::NifFileCache* const cachePtr = cache.has_value() ? &*cache : nullptr;
+
     Nif::Reader::setLoadUnsupportedFiles(true);
     //     std::cout << "Reading Files" << std::endl;
     for (const auto& path : files)
@@ -144,12 +186,12 @@ int main(int argc, char** argv)
             else if (isBSA(path))
             {
                 //                 std::cout << "Reading BSA File: " << name << std::endl;
-                readVFS(std::make_unique<VFS::BsaArchive>(path));
+                readVFS(makeBsaArchive(path), {}, cachePtr);
             }
             else if (std::filesystem::is_directory(path))
             {
                 //                 std::cout << "Reading All Files in: " << name << std::endl;
-                readVFS(std::make_unique<VFS::FileSystemArchive>(path), path);
+                readVFS(std::make_unique<VFS::FileSystemArchive>(path), path, cachePtr);
             }
             else
             {
@@ -1,6 +1,7 @@
 #include "engine.hpp"
 
 #include <chrono>
+#include <optional>
 #include <thread>
 
 #include <osgDB/WriteFile>
@@ -13,12 +14,18 @@
 
 #include <components/misc/rng.hpp>
 
+#include <components/vfs/archiveindexcache.hpp>
 #include <components/vfs/manager.hpp>
 #include <components/vfs/registerarchives.hpp>
 
+#include <components/bsa/decompressioncache.hpp>
+
 #include <components/sdlutil/imagetosurface.hpp>
 #include <components/sdlutil/sdlgraphicswindow.hpp>
 
+#include <components/resource/imagemanager.hpp>
+#include <components/resource/niffilecache.hpp>
+#include <components/resource/niffilemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/resource/stats.hpp>
@@ -37,6 +44,7 @@
 #include <components/l10n/manager.hpp>
 
 #include <components/misc/frameratelimiter.hpp>
+#include <components/misc/jobsystem.hpp>
 
 #include <components/sceneutil/color.hpp>
 #include <components/sceneutil/depth.hpp>
@@ -83,7 +91,12 @@ namespace
             Log(Debug::Error) << "SDL error: " << SDL_GetError();
     }
 
-    void initStatsHandler(Resource::Profiler& profiler)
+    OMW::UserStats makeJobUserStats(const std::string& subsystem)
+    {
+        return OMW::UserStats(subsystem + " jobs", "job_" + subsystem);
+    }
+
+    void initStatsHandler(Resource::Profiler& profiler, const std::vector<std::string>& jobSubsystems)
     {
         const osg::Vec4f textColor(1.f, 1.f, 1.f, 1.f);
         const osg::Vec4f barColor(1.f, 1.f, 1.f, 1.f);
@@ -100,6 +113,27 @@ namespace
         // Unconditionnally add the async physics stats, and then remove it at runtime if necessary
         if (Settings::Manager::getInt("async num threads", "Physics") == 0)
             profiler.removeUserStatsLine(" -Async");
+
+        for (const std::string& subsystem : jobSubsystems)
+        {
+            const OMW::UserStats v = makeJobUserStats(subsystem);
+            profiler.addUserStatsLine(v.mLabel, textColor, barColor, v.mTaken, multiplier, average,
+                averageInInverseSpace, v.mBegin, v.mEnd, maxValue);
+        }
+    }
+
+    std::size_t getJobThreadsCount()
+    {
+        const int configured = Settings::Manager::getInt("job threads", "General");
+        if (configured > 0)
+            return static_cast<std::size_t>(configured);
+        // Main and draw threads, and the subsystems having dedicated threads
+        std::size_t reserved = 2;
+        reserved += static_cast<std::size_t>(std::max(0, Settings::Manager::getInt("async num threads", "Physics")));
+        reserved += static_cast<std::size_t>(std::max(0, Settings::Manager::getInt("preload num threads", "Cells")));
+        if (Settings::Manager::getBool("enable", "Navigator"))
+            reserved += Settings::Manager::getSize("async nav mesh updater threads", "Navigator");
+        return Misc::JobSystem::getDefaultThreadsCount(std::thread::hardware_concurrency(), reserved);
     }
 
     struct ScheduleNonDialogMessageBox
@@ -180,6 +214,9 @@ bool OMW::Engine::frame(float frametime)
 
     mEnvironment.setFrameDuration(frametime);
 
+    mJobSystem->beginFrame();
+    const double jobFrameOffset = timer->delta_s(frameStart, timer->tick());
+
     try
     {
         // update input
@@ -309,6 +346,8 @@ bool OMW::Engine::frame(float frametime)
 
     mUnrefQueue->flush(*mWorkQueue);
 
+    mResourceSystem->getImageManager()->updateStreaming(frameNumber);
+
     if (reportResource)
     {
         stats->setAttribute(frameNumber, "FrameNumber", frameNumber);
@@ -318,6 +357,17 @@ bool OMW::Engine::frame(float frametime)
         stats->setAttribute(frameNumber, "WorkQueue", mWorkQueue->getNumItems());
         stats->setAttribute(frameNumber, "WorkThread", mWorkQueue->getNumActiveThreads());
 
+        const SceneUtil::WorkQueueStats workQueueStats = mWorkQueue->getStats();
+        for (std::size_t i = 0; i < workQueueStats.mCategories.size(); ++i)
+        {
+            const SceneUtil::WorkQueueCategoryStats& category = workQueueStats.mCategories[i];
+            const std::string name = "WorkQueue "
+                + std::string(SceneUtil::getWorkItemCategoryName(static_cast<SceneUtil::WorkItemCategory>(i)));
+            stats->setAttribute(frameNumber, name, category.mQueued + category.mActive);
+        }
+        stats->setAttribute(frameNumber, "WorkQueue Stolen", workQueueStats.mStolen);
+        stats->setAttribute(frameNumber, "WorkQueue Cancelled", workQueueStats.mCancelled);
+
         mMechanicsManager->reportStats(frameNumber, *stats);
         mWorld->reportStats(frameNumber, *stats);
         mLuaManager->reportStats(frameNumber, *stats);
@@ -337,6 +387,22 @@ bool OMW::Engine::frame(float frametime)
 
     mLuaWorker->finishUpdate();
 
+    const Misc::JobFrame jobFrame = mJobSystem->endFrame();
+    if (stats->collectStats("engine"))
+    {
+        const std::vector<std::string> jobSubsystems = mJobSystem->getSubsystemNames();
+        for (std::size_t i = 0; i < jobFrame.mSubsystems.size(); ++i)
+        {
+            const Misc::JobSubsystemFrameStats& jobStats = jobFrame.mSubsystems[i];
+            if (jobStats.mJobs == 0)
+                continue;
+            const UserStats v = makeJobUserStats(jobSubsystems[i]);
+            stats->setAttribute(frameNumber, v.mBegin, jobFrameOffset + jobStats.mBegin);
+            stats->setAttribute(frameNumber, v.mTaken, jobStats.mTaken);
+            stats->setAttribute(frameNumber, v.mEnd, jobFrameOffset + jobStats.mEnd);
+        }
+    }
+
     return true;
 }
 
@@ -399,6 +465,7 @@ OMW::Engine::~Engine()
 
     mUnrefQueue = nullptr;
     mWorkQueue = nullptr;
+    mJobSystem = nullptr;
 
     mViewer = nullptr;
 
@@ -657,9 +724,31 @@ void OMW::Engine::prepareEngine()
 
     mVFS = std::make_unique<VFS::Manager>(mFSStrict);
 
-    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true);
+    std::shared_ptr<Bsa::DecompressionCache> decompressionCache;
+    if (const int cacheSize = Settings::Manager::getInt("compressed archive cache size", "General"); cacheSize > 0)
+        decompressionCache
+            = std::make_shared<Bsa::DecompressionCache>(static_cast<std::size_t>(cacheSize) * 1024 * 1024);
+
+    VFS::BsaArchiveOptions bsaOptions;
+    bsaOptions.mMemoryMapped = Settings::Manager::getBool("memory map archives", "General");
+    bsaOptions.mDecompressionCache = decompressionCache;
+
+    std::optional<VFS::ArchiveIndexCache> archiveIndexCache;
+    if (Settings::Manager::getBool("archive index cache", "General"))
+    {
+        archiveIndexCache.emplace(mCfgMgr.getCachePath() / "archiveindex.bin");
+        bsaOptions.mIndexCache = &*archiveIndexCache;
+    }
+
+    VFS::registerArchives(mVFS.get(), mFileCollections, mArchives, true, bsaOptions);
+
+    if (archiveIndexCache.has_value())
+        archiveIndexCache->save();
 
     mResourceSystem = std::make_unique<Resource::ResourceSystem>(mVFS.get());
+    mResourceSystem->setDecompressionCache(decompressionCache);
+    mResourceSystem->setMemoryBudget(
+        static_cast<std::size_t>(std::max(0, Settings::Manager::getInt("cache memory budget", "Cells"))) * 1024 * 1024);
     mResourceSystem->getSceneManager()->getShaderManager().setMaxTextureUnits(mGlMaxTextureImageUnits);
     mResourceSystem->getSceneManager()->setUnRefImageDataAfterApply(
         false); // keep to Off for now to allow better state sharing
@@ -672,6 +761,15 @@ void OMW::Engine::prepareEngine()
     if (numThreads <= 0)
         throw std::runtime_error("Invalid setting: 'preload num threads' must be >0");
     mWorkQueue = new SceneUtil::WorkQueue(numThreads);
+    mJobSystem = std::make_unique<Misc::JobSystem>(getJobThreadsCount());
+    if (Settings::Manager::getBool("nif file cache", "Models"))
+        mResourceSystem->getNifFileManager()->setFileCache(
+            std::make_shared<Resource::NifFileCache>(mCfgMgr.getCachePath() / "nif"), mWorkQueue);
+    if (Settings::Manager::getBool("texture streaming", "General"))
+        mResourceSystem->getImageManager()->setStreaming(mWorkQueue,
+            static_cast<unsigned>(std::max(1, Settings::Manager::getInt("texture streaming base size", "General"))),
+            static_cast<std::size_t>(std::max(0, Settings::Manager::getInt("texture streaming budget", "General")))
+                * 1024 * 1024);
     mUnrefQueue = std::make_unique<SceneUtil::UnrefQueue>();
 
     mScreenCaptureOperation = new SceneUtil::AsyncScreenCaptureOperation(mWorkQueue,
@@ -692,8 +790,8 @@ void OMW::Engine::prepareEngine()
     mLuaManager = std::make_unique<MWLua::LuaManager>(mVFS.get(), mResDir / "lua_libs");
     mEnvironment.setLuaManager(*mLuaManager);
 
-    // starts a separate lua thread if "lua num threads" > 0
-    mLuaWorker = std::make_unique<MWLua::Worker>(*mLuaManager, *mViewer);
+    // runs lua update as a job in parallel with rendering if "lua num threads" > 0
+    mLuaWorker = std::make_unique<MWLua::Worker>(*mLuaManager, *mViewer, *mJobSystem);
 
     // Create input and UI first to set up a bootstrapping environment for
     // showing a loading screen and keeping the window responsive while doing so
@@ -767,8 +865,8 @@ void OMW::Engine::prepareEngine()
 
     // Create the world
     mWorld = std::make_unique<MWWorld::World>(mViewer, rootNode, mResourceSystem.get(), mWorkQueue.get(), *mUnrefQueue,
-        mFileCollections, mContentFiles, mGroundcoverFiles, mEncoder.get(), mActivationDistanceOverride, mCellName,
-        mStartupScript, mResDir, mCfgMgr.getUserDataPath());
+        *mJobSystem, mFileCollections, mContentFiles, mGroundcoverFiles, mEncoder.get(), mActivationDistanceOverride,
+        mCellName, mStartupScript, mResDir, mCfgMgr.getUserDataPath());
     mWorld->setupPlayer();
     mWorld->setRandomSeed(mRandomSeed);
     mEnvironment.setWorld(*mWorld);
@@ -794,7 +892,7 @@ void OMW::Engine::prepareEngine()
     mEnvironment.setScriptManager(*mScriptManager);
 
     // Create game mechanics system
-    mMechanicsManager = std::make_unique<MWMechanics::MechanicsManager>();
+    mMechanicsManager = std::make_unique<MWMechanics::MechanicsManager>(*mJobSystem);
     mEnvironment.setMechanicsManager(*mMechanicsManager);
 
     // Create dialog system
@@ -878,7 +976,7 @@ void OMW::Engine::go()
     // Setup profiler
     osg::ref_ptr<Resource::Profiler> statshandler = new Resource::Profiler(stats.is_open(), mVFS.get());
 
-    initStatsHandler(*statshandler);
+    initStatsHandler(*statshandler, mJobSystem->getSubsystemNames());
 
     mViewer->addEventHandler(statshandler);
 
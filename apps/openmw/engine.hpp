@@ -42,6 +42,11 @@ namespace MWLua
     class Worker;
 }
 
+namespace Misc
+{
+    class JobSystem;
+}
+
 namespace Stereo
 {
     class Manager;
@@ -128,6 +133,7 @@ namespace OMW
         std::unique_ptr<VFS::Manager> mVFS;
         std::unique_ptr<Resource::ResourceSystem> mResourceSystem;
         osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        std::unique_ptr<Misc::JobSystem> mJobSystem;
         std::unique_ptr<SceneUtil::UnrefQueue> mUnrefQueue;
         std::unique_ptr<MWWorld::World> mWorld;
         std::unique_ptr<MWSound::SoundManager> mSoundManager;
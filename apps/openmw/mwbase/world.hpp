@@ -3,6 +3,7 @@
 
 #include "rotationflags.hpp"
 
+#include <cstddef>
 #include <deque>
 #include <map>
 #include <set>
@@ -328,6 +329,10 @@ namespace MWBase
 
         virtual const MWPhysics::RayCastingInterface* getRayCasting() const = 0;
 
+        virtual bool replayPhysics(std::size_t steps) = 0;
+        ///< Moves actors back by \a steps recorded physics steps and simulates them again with the recorded movement.
+        /// \return false if the steps are not recorded.
+
         virtual bool castRenderingRay(MWPhysics::RayCastingResult& res, const osg::Vec3f& from, const osg::Vec3f& to,
             bool ignorePlayer, bool ignoreActors)
             = 0;
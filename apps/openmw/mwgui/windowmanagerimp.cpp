@@ -2203,7 +2203,7 @@ namespace MWGui
                 continue;
             std::string tex_name = imgSetPointer->getImageSet()->getIndexInfo(0, 0).texture;
 
-            osg::ref_ptr<osg::Image> image = mResourceSystem->getImageManager()->getImage(tex_name);
+            osg::ref_ptr<osg::Image> image = mResourceSystem->getImageManager()->getFullImage(tex_name);
 
             if (image.valid())
             {
@@ -7,6 +7,7 @@
 #include "../mwrender/postprocessor.hpp"
 #include "../mwrender/renderingmanager.hpp"
 
+#include <components/debug/debuglog.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
 #include <components/shader/shadermanager.hpp>
@@ -71,6 +72,13 @@ namespace MWLua
             });
         };
 
+        api["replayPhysics"] = [context](std::size_t steps) {
+            context.mLuaManager->addAction([steps] {
+                if (!MWBase::Environment::get().getWorld()->replayPhysics(steps))
+                    Log(Debug::Warning) << "Can't replay " << steps << " physics steps, they are not recorded";
+            });
+        };
+
         return LuaUtil::makeReadOnly(api);
     }
 }
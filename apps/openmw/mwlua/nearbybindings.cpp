@@ -22,6 +22,31 @@ namespace sol
 
 namespace MWLua
 {
+    namespace
+    {
+        struct CastRayOptions
+        {
+            MWWorld::Ptr mIgnore;
+            int mCollisionType = MWPhysics::CollisionType_Default;
+            float mRadius = 0;
+        };
+
+        CastRayOptions parseCastRayOptions(const sol::optional<sol::table>& options)
+        {
+            CastRayOptions result;
+            if (!options)
+                return result;
+            sol::optional<LObject> ignoreObj = options->get<sol::optional<LObject>>("ignore");
+            if (ignoreObj)
+                result.mIgnore = ignoreObj->ptr();
+            result.mCollisionType = options->get<sol::optional<int>>("collisionType").value_or(result.mCollisionType);
+            result.mRadius = options->get<sol::optional<float>>("radius").value_or(0);
+            if (result.mRadius > 0 && !result.mIgnore.isEmpty())
+                throw std::logic_error("Currently castRay doesn't support `ignore` when radius > 0");
+            return result;
+        }
+    }
+
     sol::table initNearbyPackage(const Context& context)
     {
         sol::table api(context.mLua->sol(), sol::create);
@@ -67,43 +92,27 @@ namespace MWLua
             }));
 
         api["castRay"] = [](const osg::Vec3f& from, const osg::Vec3f& to, sol::optional<sol::table> options) {
-            MWWorld::Ptr ignore;
-            int collisionType = MWPhysics::CollisionType_Default;
-            float radius = 0;
-            if (options)
-            {
-                sol::optional<LObject> ignoreObj = options->get<sol::optional<LObject>>("ignore");
-                if (ignoreObj)
-                    ignore = ignoreObj->ptr();
-                collisionType = options->get<sol::optional<int>>("collisionType").value_or(collisionType);
-                radius = options->get<sol::optional<float>>("radius").value_or(0);
-            }
+            const CastRayOptions o = parseCastRayOptions(options);
             const MWPhysics::RayCastingInterface* rayCasting = MWBase::Environment::get().getWorld()->getRayCasting();
-            if (radius <= 0)
-                return rayCasting->castRay(from, to, ignore, std::vector<MWWorld::Ptr>(), collisionType);
+            if (o.mRadius <= 0)
+                return rayCasting->castRay(from, to, o.mIgnore, std::vector<MWWorld::Ptr>(), o.mCollisionType);
             else
-            {
-                if (!ignore.isEmpty())
-                    throw std::logic_error("Currently castRay doesn't support `ignore` when radius > 0");
-                return rayCasting->castSphere(from, to, radius, collisionType);
-            }
+                return rayCasting->castSphere(from, to, o.mRadius, o.mCollisionType);
+        };
+        api["asyncCastRay"] = [context](const LuaUtil::Callback& callback, const osg::Vec3f& from,
+                                  const osg::Vec3f& to, sol::optional<sol::table> options) {
+            const CastRayOptions o = parseCastRayOptions(options);
+            // Called from the main thread while Lua scripts are not running
+            MWPhysics::RayCastingCallback onResult = [context, callback](const MWPhysics::RayCastingResult& res) {
+                context.mLuaManager->queueCallback(callback, sol::main_object(context.mLua->sol(), sol::in_place, res));
+            };
+            const MWPhysics::RayCastingInterface* rayCasting = MWBase::Environment::get().getWorld()->getRayCasting();
+            if (o.mRadius <= 0)
+                rayCasting->asyncCastRay(
+                    std::move(onResult), from, to, o.mIgnore, std::vector<MWWorld::Ptr>(), o.mCollisionType);
+            else
+                rayCasting->asyncCastSphere(std::move(onResult), from, to, o.mRadius, o.mCollisionType);
         };
-        // TODO: async raycasting
-        /*api["asyncCastRay"] = [luaManager = context.mLuaManager](
-            const Callback& luaCallback, const osg::Vec3f& from, const osg::Vec3f& to, sol::optional<sol::table>
-        options)
-        {
-            std::function<void(MWPhysics::RayCastingResult)> callback =
-                luaManager->wrapLuaCallback<MWPhysics::RayCastingResult>(luaCallback);
-            MWPhysics::RayCastingInterface* rayCasting = MWBase::Environment::get().getWorld()->getRayCasting();
-
-            // Handle options the same way as in `castRay`.
-
-            // NOTE: `callback` is not thread safe. If MWPhysics works in separate thread, it must put results to a
-        queue
-            //       and use this callback from the main thread at the beginning of the next frame processing.
-            rayCasting->asyncCastRay(callback, from, to, ignore, std::vector<MWWorld::Ptr>(), collisionType);
-        };*/
         api["castRenderingRay"] = [manager = context.mLuaManager](const osg::Vec3f& from, const osg::Vec3f& to) {
             if (!manager->isProcessingInputEvents())
             {
@@ -8,19 +8,28 @@
 
 #include <osgViewer/Viewer>
 
+#include <utility>
+
 namespace MWLua
 {
-    Worker::Worker(LuaManager& manager, osgViewer::Viewer& viewer)
+    namespace
+    {
+        // Lua update runs on the same job thread every frame
+        constexpr std::size_t luaJobThread = 0;
+    }
+
+    Worker::Worker(LuaManager& manager, osgViewer::Viewer& viewer, Misc::JobSystem& jobSystem)
         : mManager(manager)
         , mViewer(viewer)
+        , mJobSystem(jobSystem)
+        , mSubsystem(jobSystem.registerSubsystem("Lua"))
+        , mAsync(Settings::Manager::getInt("lua num threads", "Lua") > 0 && jobSystem.getThreadsCount() > 0)
     {
-        if (Settings::Manager::getInt("lua num threads", "Lua") > 0)
-            mThread = std::thread([this] { run(); });
     }
 
     Worker::~Worker()
     {
-        if (mThread && mThread->joinable())
+        if (mUpdate.isValid() && !mUpdate.isDone())
         {
             Log(Debug::Error)
                 << "Unexpected destruction of LuaWorker; likely there is an unhandled exception in the main thread.";
@@ -30,36 +39,35 @@ namespace MWLua
 
     void Worker::allowUpdate()
     {
-        if (!mThread)
+        if (!mAsync)
             return;
-        {
-            std::lock_guard<std::mutex> lk(mMutex);
-            mUpdateRequest = true;
-        }
-        mCV.notify_one();
+        mUpdate = mJobSystem.submit(mSubsystem, [this] { update(); }, luaJobThread);
     }
 
     void Worker::finishUpdate()
     {
-        if (mThread)
+        if (!mAsync)
         {
-            std::unique_lock<std::mutex> lk(mMutex);
-            mCV.wait(lk, [&] { return !mUpdateRequest; });
+            mJobSystem.run(mSubsystem, [this] { update(); });
+            return;
         }
-        else
-            update();
+        if (!mUpdate.isValid())
+            return;
+        const Misc::JobHandle handle = std::exchange(mUpdate, Misc::JobHandle());
+        handle.wait();
     }
 
     void Worker::join()
     {
-        if (mThread)
+        if (!mUpdate.isValid())
+            return;
+        try
         {
-            {
-                std::lock_guard<std::mutex> lk(mMutex);
-                mJoinRequest = true;
-            }
-            mCV.notify_one();
-            mThread->join();
+            finishUpdate();
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "Lua update failed: " << e.what();
         }
     }
 
@@ -72,21 +80,4 @@ namespace MWLua
 
         mManager.update();
     }
-
-    void Worker::run() noexcept
-    {
-        while (true)
-        {
-            std::unique_lock<std::mutex> lk(mMutex);
-            mCV.wait(lk, [&] { return mUpdateRequest || mJoinRequest; });
-            if (mJoinRequest)
-                break;
-
-            update();
-
-            mUpdateRequest = false;
-            lk.unlock();
-            mCV.notify_one();
-        }
-    }
 }
@@ -1,10 +1,7 @@
 #ifndef OPENMW_MWLUA_WORKER_H
 #define OPENMW_MWLUA_WORKER_H
 
-#include <condition_variable>
-#include <mutex>
-#include <optional>
-#include <thread>
+#include <components/misc/jobsystem.hpp>
 
 namespace osgViewer
 {
@@ -18,7 +15,7 @@ namespace MWLua
     class Worker
     {
     public:
-        explicit Worker(LuaManager& manager, osgViewer::Viewer& viewer);
+        explicit Worker(LuaManager& manager, osgViewer::Viewer& viewer, Misc::JobSystem& jobSystem);
 
         ~Worker();
 
@@ -31,15 +28,12 @@ namespace MWLua
     private:
         void update();
 
-        void run() noexcept;
-
         LuaManager& mManager;
         osgViewer::Viewer& mViewer;
-        std::mutex mMutex;
-        std::condition_variable mCV;
-        bool mUpdateRequest = false;
-        bool mJoinRequest = false;
-        std::optional<std::thread> mThread;
+        Misc::JobSystem& mJobSystem;
+        const Misc::JobSubsystem mSubsystem;
+        const bool mAsync;
+        Misc::JobHandle mUpdate;
     };
 }
 
@@ -1,6 +1,9 @@
 #include "actors.hpp"
 
+#include <algorithm>
+#include <exception>
 #include <optional>
+#include <span>
 
 #include <components/esm3/esmreader.hpp>
 #include <components/esm3/esmwriter.hpp>
@@ -248,19 +251,8 @@ namespace MWMechanics
             return (distanceToNextPathPoint - package.getNextPathPointTolerance(speed, duration, halfExtents)) / speed;
         }
 
-        void updateHeadTracking(const MWWorld::Ptr& actor, const MWWorld::Ptr& targetActor,
-            MWWorld::Ptr& headTrackTarget, float& sqrHeadTrackDistance, bool inCombatOrPursue)
+        float getMaxHeadTrackDistance(const MWWorld::Ptr& actor)
         {
-            const auto& actorRefData = actor.getRefData();
-            if (!actorRefData.getBaseNode())
-                return;
-
-            if (targetActor.getClass().getCreatureStats(targetActor).isDead())
-                return;
-
-            if (isTargetMagicallyHidden(targetActor))
-                return;
-
             static const float fMaxHeadTrackDistance = MWBase::Environment::get()
                                                            .getWorld()
                                                            ->getStore()
@@ -277,7 +269,23 @@ namespace MWMechanics
             const ESM::Cell* currentCell = actor.getCell()->getCell();
             if (!currentCell->isExterior() && !(currentCell->mData.mFlags & ESM::Cell::QuasiEx))
                 maxDistance *= fInteriorHeadTrackMult;
+            return maxDistance;
+        }
+
+        void updateHeadTracking(const MWWorld::Ptr& actor, const MWWorld::Ptr& targetActor,
+            MWWorld::Ptr& headTrackTarget, float& sqrHeadTrackDistance, bool inCombatOrPursue)
+        {
+            const auto& actorRefData = actor.getRefData();
+            if (!actorRefData.getBaseNode())
+                return;
+
+            if (targetActor.getClass().getCreatureStats(targetActor).isDead())
+                return;
 
+            if (isTargetMagicallyHidden(targetActor))
+                return;
+
+            const float maxDistance = getMaxHeadTrackDistance(actor);
             const osg::Vec3f actor1Pos(actorRefData.getPosition().asVec3());
             const osg::Vec3f actor2Pos(targetActor.getRefData().getPosition().asVec3());
             const float sqrDist = (actor1Pos - actor2Pos).length2();
@@ -300,8 +308,9 @@ namespace MWMechanics
             }
         }
 
-        void updateHeadTracking(
-            const MWWorld::Ptr& ptr, const std::list<Actor>& actors, bool isPlayer, CharacterController& ctrl)
+        /// @param nearbyActors candidates to track when the actor is not in combat or pursue mode
+        void updateHeadTracking(const MWWorld::Ptr& ptr, std::span<const Actor* const> nearbyActors, bool isPlayer,
+            CharacterController& ctrl)
         {
             float sqrHeadTrackDistance = std::numeric_limits<float>::max();
             MWWorld::Ptr headTrackTarget;
@@ -328,13 +337,13 @@ namespace MWMechanics
                 else
                 {
                     // Find something nearby.
-                    for (const Actor& otherActor : actors)
+                    for (const Actor* otherActor : nearbyActors)
                     {
-                        if (otherActor.getPtr() == ptr)
+                        if (otherActor->getPtr() == ptr)
                             continue;
 
                         updateHeadTracking(
-                            ptr, otherActor.getPtr(), headTrackTarget, sqrHeadTrackDistance, inCombatOrPursue);
+                            ptr, otherActor->getPtr(), headTrackTarget, sqrHeadTrackDistance, inCombatOrPursue);
                     }
                 }
             }
@@ -1164,8 +1173,10 @@ namespace MWMechanics
         }
     }
 
-    Actors::Actors()
-        : mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
+    Actors::Actors(Misc::JobSystem& jobSystem)
+        : mJobSystem(jobSystem)
+        , mAiJobSubsystem(jobSystem.registerSubsystem("AI"))
+        , mSmoothMovement(Settings::Manager::getBool("smooth movement", "Game"))
     {
         mTimerDisposeSummonsCorpses
             = 0.2f; // We should add a delay between summoned creature death and its corpse despawning
@@ -1198,6 +1209,7 @@ namespace MWMechanics
             return;
         const auto it = mActors.emplace(mActors.end(), ptr, anim);
         mIndex.emplace(ptr.mRef, it);
+        invalidateGrid();
 
         if (updateImmediately)
             it->getCharacterController().update(0);
@@ -1249,6 +1261,8 @@ namespace MWMechanics
                 removeTemporaryEffects(iter->second->getPtr());
             mActors.erase(iter->second);
             mIndex.erase(iter);
+            invalidateGrid();
+            mCombatTargetsRatings.clear();
         }
     }
 
@@ -1290,11 +1304,15 @@ namespace MWMechanics
         return false;
     }
 
-    void Actors::updateActor(const MWWorld::Ptr& old, const MWWorld::Ptr& ptr) const
+    void Actors::updateActor(const MWWorld::Ptr& old, const MWWorld::Ptr& ptr)
     {
         const auto iter = mIndex.find(old.mRef);
         if (iter != mIndex.end())
+        {
             iter->second->updatePtr(ptr);
+            // Moved to another cell, so the position may be far from the one in the grid
+            invalidateGrid();
+        }
     }
 
     void Actors::dropActors(const MWWorld::CellStore* cellStore, const MWWorld::Ptr& ignore)
@@ -1306,6 +1324,8 @@ namespace MWMechanics
                 removeTemporaryEffects(iter->getPtr());
                 mIndex.erase(iter->getPtr().mRef);
                 iter = mActors.erase(iter);
+                invalidateGrid();
+                mCombatTargetsRatings.clear();
             }
             else
                 ++iter;
@@ -1368,6 +1388,7 @@ namespace MWMechanics
 
         const MWWorld::Ptr player = getPlayer();
         const MWBase::World* const world = MWBase::Environment::get().getWorld();
+        std::vector<const Actor*> nearbyActors;
         for (const Actor& actor : mActors)
         {
             const MWWorld::Ptr& ptr = actor.getPtr();
@@ -1431,10 +1452,12 @@ namespace MWMechanics
             osg::Vec2f movementCorrection(0, 0);
             float angleToApproachingActor = 0;
 
-            // Iterate through all other actors and predict collisions.
-            for (const Actor& otherActor : mActors)
+            // Iterate through all other actors close enough and predict collisions.
+            nearbyActors.clear();
+            getActorsInRange(basePos, maxDistToCheck, nearbyActors);
+            for (const Actor* otherActor : nearbyActors)
             {
-                const MWWorld::Ptr& otherPtr = otherActor.getPtr();
+                const MWWorld::Ptr& otherPtr = otherActor->getPtr();
                 if (otherPtr == ptr || otherPtr == currentTarget)
                     continue;
 
@@ -1550,9 +1573,21 @@ namespace MWMechanics
             }
             const bool godmode = MWBase::Environment::get().getWorld()->getGodModeState();
 
+            buildGrid();
+            std::vector<const Actor*> nearbyActors;
+
+            if (aiActive)
+                rateCombatTargets(playerPos);
+            std::size_t nextCombatTargetsRating = 0;
+
             // AI and magic effects update
             for (Actor& actor : mActors)
             {
+                std::span<const CombatTargetRating> combatTargetRatings;
+                if (nextCombatTargetsRating < mCombatTargetsRatings.size()
+                    && mCombatTargetsRatings[nextCombatTargetsRating].mActor == &actor)
+                    combatTargetRatings = mCombatTargetsRatings[nextCombatTargetsRating++].mTargets;
+
                 const bool isPlayer = actor.getPtr() == player;
                 CharacterController& ctrl = actor.getCharacterController();
                 MWBase::LuaManager::ActorControls* luaControls
@@ -1602,6 +1637,8 @@ namespace MWMechanics
 
                     if (!cellChanged && worldScene->hasCellChanged())
                     {
+                        invalidateGrid();
+                        mCombatTargetsRatings.clear();
                         return; // for now abort update of the old cell when cell changes by teleportation magic effect
                                 // a better solution might be to apply cell changes at the end of the frame
                     }
@@ -1621,7 +1658,13 @@ namespace MWMechanics
                             }
                         }
                         if (mTimerUpdateHeadTrack == 0)
-                            updateHeadTracking(actor.getPtr(), mActors, isPlayer, ctrl);
+                        {
+                            nearbyActors.clear();
+                            if (actor.getPtr().getRefData().getBaseNode())
+                                getActorsInRange(actor.getPtr().getRefData().getPosition().asVec3(),
+                                    getMaxHeadTrackDistance(actor.getPtr()), nearbyActors);
+                            updateHeadTracking(actor.getPtr(), nearbyActors, isPlayer, ctrl);
+                        }
 
                         if (actor.getPtr().getClass().isNpc() && !isPlayer)
                             updateCrimePursuit(actor.getPtr(), duration);
@@ -1631,7 +1674,8 @@ namespace MWMechanics
                             CreatureStats& stats = actor.getPtr().getClass().getCreatureStats(actor.getPtr());
                             if (isConscious(actor.getPtr()) && !(luaControls && luaControls->mDisableAI))
                             {
-                                stats.getAiSequence().execute(actor.getPtr(), ctrl, duration);
+                                stats.getAiSequence().execute(
+                                    actor.getPtr(), ctrl, duration, /*outOfRange*/ false, combatTargetRatings);
                                 updateGreetingState(actor.getPtr(), actor, mTimerUpdateHello > 0);
                                 playIdleDialogue(actor.getPtr());
                                 updateMovementSpeed(actor.getPtr());
@@ -1759,6 +1803,8 @@ namespace MWMechanics
 
             killDeadActors();
             updateSneaking(playerCharacter, duration);
+            invalidateGrid();
+            mCombatTargetsRatings.clear();
         }
 
         updateCombatMusic();
@@ -2071,15 +2117,38 @@ namespace MWMechanics
 
     void Actors::getObjectsInRange(const osg::Vec3f& position, float radius, std::vector<MWWorld::Ptr>& out) const
     {
-        for (const Actor& actor : mActors)
+        if (!mGridValid)
         {
-            if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
-                out.push_back(actor.getPtr());
+            for (const Actor& actor : mActors)
+            {
+                if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
+                    out.push_back(actor.getPtr());
+            }
+            return;
+        }
+
+        mGridQuery.clear();
+        mGrid.getInRange(position, radius, mGridQuery);
+        for (std::size_t index : mGridQuery)
+        {
+            const MWWorld::Ptr& ptr = mGridActors[index]->getPtr();
+            if ((ptr.getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
+                out.push_back(ptr);
         }
     }
 
     bool Actors::isAnyObjectInRange(const osg::Vec3f& position, float radius) const
     {
+        if (mGridValid)
+        {
+            mGridQuery.clear();
+            mGrid.getInRange(position, radius, mGridQuery);
+            return std::any_of(mGridQuery.begin(), mGridQuery.end(), [&](std::size_t index) {
+                const MWWorld::Ptr& ptr = mGridActors[index]->getPtr();
+                return (ptr.getRefData().getPosition().asVec3() - position).length2() <= radius * radius;
+            });
+        }
+
         for (const Actor& actor : mActors)
         {
             if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
@@ -2089,6 +2158,107 @@ namespace MWMechanics
         return false;
     }
 
+    void Actors::getActorsInRange(const osg::Vec3f& position, float radius, std::vector<const Actor*>& out) const
+    {
+        if (!mGridValid)
+        {
+            for (const Actor& actor : mActors)
+            {
+                if ((actor.getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
+                    out.push_back(&actor);
+            }
+            return;
+        }
+
+        mGridQuery.clear();
+        mGrid.getInRange(position, radius, mGridQuery);
+        for (std::size_t index : mGridQuery)
+        {
+            const Actor* actor = mGridActors[index];
+            if ((actor->getPtr().getRefData().getPosition().asVec3() - position).length2() <= radius * radius)
+                out.push_back(actor);
+        }
+    }
+
+    void Actors::buildGrid()
+    {
+        std::vector<osg::Vec3f> positions;
+        positions.reserve(mActors.size());
+        mGridActors.clear();
+        for (const Actor& actor : mActors)
+        {
+            positions.push_back(actor.getPtr().getRefData().getPosition().asVec3());
+            mGridActors.push_back(&actor);
+        }
+        mGrid.build(positions);
+        mGridValid = true;
+    }
+
+    void Actors::invalidateGrid()
+    {
+        mGridValid = false;
+        mGridActors.clear();
+    }
+
+    void Actors::rateCombatTargets(const osg::Vec3f& playerPos)
+    {
+        mCombatTargetsRatings.clear();
+        // Without threads the targets are rated by AiSequence::execute as usual
+        if (mJobSystem.getThreadsCount() == 0)
+            return;
+
+        const MWWorld::Ptr player = getPlayer();
+        for (const Actor& actor : mActors)
+        {
+            const MWWorld::Ptr& ptr = actor.getPtr();
+            if (ptr == player)
+                continue;
+            const float distSqr = (playerPos - ptr.getRefData().getPosition().asVec3()).length2();
+            if (distSqr > mActorsProcessingRange * mActorsProcessingRange)
+                continue;
+            const CreatureStats& stats = ptr.getClass().getCreatureStats(ptr);
+            if (stats.isDead())
+                continue;
+            CombatTargetsRating& rating = mCombatTargetsRatings.emplace_back(CombatTargetsRating{ &actor, {} });
+            if (!stats.getAiSequence().getCombatTargetsToRate(rating.mTargets))
+                mCombatTargetsRatings.pop_back();
+        }
+
+        // Not worth a job for a single actor
+        if (mCombatTargetsRatings.size() < 2)
+        {
+            mCombatTargetsRatings.clear();
+            return;
+        }
+
+        // Rating only reads the state of the actors and the store, each job writes only to its own entry
+        std::vector<Misc::JobHandle> jobs;
+        jobs.reserve(mCombatTargetsRatings.size());
+        for (CombatTargetsRating& rating : mCombatTargetsRatings)
+            jobs.push_back(mJobSystem.submit(mAiJobSubsystem, [&rating] {
+                const MWWorld::Ptr& ptr = rating.mActor->getPtr();
+                for (CombatTargetRating& target : rating.mTargets)
+                    target.mRating = getBestActionRating(ptr, target.mTarget);
+            }));
+
+        // Jobs refer to mCombatTargetsRatings, so all of them have to finish before an error is rethrown
+        std::exception_ptr error;
+        for (const Misc::JobHandle& job : jobs)
+        {
+            try
+            {
+                job.wait();
+            }
+            catch (...)
+            {
+                if (error == nullptr)
+                    error = std::current_exception();
+            }
+        }
+        if (error != nullptr)
+            std::rethrow_exception(error);
+    }
+
     std::vector<MWWorld::Ptr> Actors::getActorsSidingWith(const MWWorld::Ptr& actorPtr, bool excludeInfighting) const
     {
         std::vector<MWWorld::Ptr> list;
@@ -2309,6 +2479,8 @@ namespace MWMechanics
 
     void Actors::clear()
     {
+        invalidateGrid();
+        mCombatTargetsRatings.clear();
         mIndex.clear();
         mActors.clear();
         mDeathCount.clear();
@@ -7,7 +7,11 @@
 #include <string>
 #include <vector>
 
+#include <components/misc/jobsystem.hpp>
+
 #include "actor.hpp"
+#include "actorsgrid.hpp"
+#include "aisequence.hpp"
 
 namespace ESM
 {
@@ -40,7 +44,7 @@ namespace MWMechanics
     class Actors
     {
     public:
-        Actors();
+        explicit Actors(Misc::JobSystem& jobSystem);
 
         std::list<Actor>::const_iterator begin() const { return mActors.begin(); }
         std::list<Actor>::const_iterator end() const { return mActors.end(); }
@@ -73,7 +77,7 @@ namespace MWMechanics
 
         void castSpell(const MWWorld::Ptr& ptr, const ESM::RefId& spellId, bool manualSpell = false) const;
 
-        void updateActor(const MWWorld::Ptr& old, const MWWorld::Ptr& ptr) const;
+        void updateActor(const MWWorld::Ptr& old, const MWWorld::Ptr& ptr);
         ///< Updates an actor with a new Ptr
 
         void dropActors(const MWWorld::CellStore* cellStore, const MWWorld::Ptr& ignore);
@@ -177,9 +181,24 @@ namespace MWMechanics
             Battle
         };
 
+        struct CombatTargetsRating
+        {
+            const Actor* mActor;
+            std::vector<CombatTargetRating> mTargets;
+        };
+
+        Misc::JobSystem& mJobSystem;
+        const Misc::JobSubsystem mAiJobSubsystem;
         std::map<ESM::RefId, int> mDeathCount;
         std::list<Actor> mActors;
         std::map<const MWWorld::LiveCellRefBase*, std::list<Actor>::iterator> mIndex;
+        // Positions of mActors at the beginning of the update, valid only until the update ends or actors change
+        ActorsGrid mGrid;
+        std::vector<const Actor*> mGridActors;
+        mutable std::vector<std::size_t> mGridQuery;
+        bool mGridValid = false;
+        // Ordered as mActors
+        std::vector<CombatTargetsRating> mCombatTargetsRatings;
         float mTimerDisposeSummonsCorpses;
         float mTimerUpdateHeadTrack = 0;
         float mTimerUpdateEquippedLight = 0;
@@ -200,6 +219,16 @@ namespace MWMechanics
 
         void killDeadActors();
 
+        void buildGrid();
+
+        void invalidateGrid();
+
+        /// Appends actors within the radius in the order of mActors
+        void getActorsInRange(const osg::Vec3f& position, float radius, std::vector<const Actor*>& out) const;
+
+        /// Rates combat targets of the actors in the processing range by the job system before their AI is updated
+        void rateCombatTargets(const osg::Vec3f& playerPos);
+
         void purgeSpellEffects(int casterActorId) const;
 
         void predictAndAvoidCollisions(float duration) const;
@@ -0,0 +1,107 @@
+#include "actorsgrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace MWMechanics
+{
+    namespace
+    {
+        std::int32_t getCellIndex(float coordinate)
+        {
+            const float index = std::floor(coordinate / ActorsGrid::sCellSize);
+            if (std::isnan(index))
+                return 0;
+            const float limit = 1 << 30;
+            return static_cast<std::int32_t>(std::clamp(index, -limit, limit));
+        }
+
+        std::uint64_t getCellKey(std::int32_t x, std::int32_t y)
+        {
+            return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(y);
+        }
+
+        std::uint64_t getCellKey(const osg::Vec3f& position)
+        {
+            return getCellKey(getCellIndex(position.x()), getCellIndex(position.y()));
+        }
+    }
+
+    void ActorsGrid::build(std::span<const osg::Vec3f> positions)
+    {
+        mPositions.assign(positions.begin(), positions.end());
+
+        mKeys.resize(positions.size());
+        std::transform(positions.begin(), positions.end(), mKeys.begin(),
+            [](const osg::Vec3f& position) { return getCellKey(position); });
+
+        mOrder.resize(positions.size());
+        std::iota(mOrder.begin(), mOrder.end(), std::size_t{ 0 });
+        std::sort(mOrder.begin(), mOrder.end(), [&](std::size_t left, std::size_t right) {
+            return mKeys[left] < mKeys[right] || (mKeys[left] == mKeys[right] && left < right);
+        });
+
+        mCells.clear();
+        for (std::size_t begin = 0; begin < mOrder.size();)
+        {
+            const std::uint64_t key = mKeys[mOrder[begin]];
+            std::size_t end = begin + 1;
+            while (end < mOrder.size() && mKeys[mOrder[end]] == key)
+                ++end;
+            mCells.emplace(key, Cell{ begin, end });
+            begin = end;
+        }
+    }
+
+    void ActorsGrid::clear()
+    {
+        mPositions.clear();
+        mOrder.clear();
+        mKeys.clear();
+        mCells.clear();
+    }
+
+    void ActorsGrid::getInRange(const osg::Vec3f& center, float radius, std::vector<std::size_t>& out) const
+    {
+        if (mPositions.empty() || !(radius >= 0))
+            return;
+
+        const float sqrRadius = radius * radius;
+        const std::size_t firstOut = out.size();
+
+        const std::int32_t minX = getCellIndex(center.x() - radius);
+        const std::int32_t maxX = getCellIndex(center.x() + radius);
+        const std::int32_t minY = getCellIndex(center.y() - radius);
+        const std::int32_t maxY = getCellIndex(center.y() + radius);
+        const std::uint64_t cellsToCheck = static_cast<std::uint64_t>(static_cast<std::int64_t>(maxX) - minX + 1)
+            * static_cast<std::uint64_t>(static_cast<std::int64_t>(maxY) - minY + 1);
+
+        // Looking up more cells than there are occupied ones is slower than checking every position
+        if (cellsToCheck > mCells.size())
+        {
+            for (std::size_t i = 0; i < mPositions.size(); ++i)
+                if ((mPositions[i] - center).length2() <= sqrRadius)
+                    out.push_back(i);
+            return;
+        }
+
+        for (std::int32_t x = minX; x <= maxX; ++x)
+        {
+            for (std::int32_t y = minY; y <= maxY; ++y)
+            {
+                const auto it = mCells.find(getCellKey(x, y));
+                if (it == mCells.end())
+                    continue;
+                for (std::size_t i = it->second.mBegin; i < it->second.mEnd; ++i)
+                {
+                    const std::size_t index = mOrder[i];
+                    if ((mPositions[index] - center).length2() <= sqrRadius)
+                        out.push_back(index);
+                }
+            }
+        }
+
+        std::sort(out.begin() + static_cast<std::ptrdiff_t>(firstOut), out.end());
+    }
+}
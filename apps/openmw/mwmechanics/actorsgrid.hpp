@@ -0,0 +1,44 @@
+#ifndef OPENMW_MWMECHANICS_ACTORSGRID_H
+#define OPENMW_MWMECHANICS_ACTORSGRID_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+#include <osg/Vec3f>
+
+namespace MWMechanics
+{
+    /// Uniform grid over XY plane to find positions within a distance without checking all of them
+    class ActorsGrid
+    {
+    public:
+        static constexpr float sCellSize = 512;
+
+        void build(std::span<const osg::Vec3f> positions);
+
+        void clear();
+
+        std::size_t getSize() const { return mPositions.size(); }
+
+        /// Appends indices of the positions within the radius from the center in ascending order
+        void getInRange(const osg::Vec3f& center, float radius, std::vector<std::size_t>& out) const;
+
+    private:
+        struct Cell
+        {
+            std::size_t mBegin;
+            std::size_t mEnd;
+        };
+
+        std::vector<osg::Vec3f> mPositions;
+        // Indices of the positions ordered by cell
+        std::vector<std::size_t> mOrder;
+        std::vector<std::uint64_t> mKeys;
+        std::unordered_map<std::uint64_t, Cell> mCells;
+    };
+}
+
+#endif
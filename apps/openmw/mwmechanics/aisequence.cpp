@@ -20,6 +20,18 @@
 
 namespace MWMechanics
 {
+    namespace
+    {
+        float getCombatTargetRating(const MWWorld::Ptr& actor, const MWWorld::Ptr& target,
+            std::span<const CombatTargetRating> combatTargetRatings)
+        {
+            const auto it = std::find_if(combatTargetRatings.begin(), combatTargetRatings.end(),
+                [&](const CombatTargetRating& rating) { return rating.mTarget == target; });
+            if (it != combatTargetRatings.end())
+                return it->mRating;
+            return getBestActionRating(actor, target);
+        }
+    }
 
     void AiSequence::copy(const AiSequence& sequence)
     {
@@ -116,6 +128,12 @@ namespace MWMechanics
         return !targetActors.empty();
     }
 
+    bool AiSequence::hasMultipleCombatPackages() const
+    {
+        return mPackages.size() > 1 && mPackages[0]->getTypeId() == AiPackageTypeId::Combat
+            && mPackages[1]->getTypeId() == AiPackageTypeId::Combat;
+    }
+
     AiPackages::iterator AiSequence::erase(AiPackages::iterator package)
     {
         // Not sure if manually terminated packages should trigger mDone, probably not?
@@ -225,8 +243,26 @@ namespace MWMechanics
         }
     }
 
-    void AiSequence::execute(
-        const MWWorld::Ptr& actor, CharacterController& characterController, float duration, bool outOfRange)
+    bool AiSequence::getCombatTargetsToRate(std::vector<CombatTargetRating>& out) const
+    {
+        if (!hasMultipleCombatPackages())
+            return false;
+
+        const std::size_t initialSize = out.size();
+        for (const auto& package : mPackages)
+        {
+            if (package->getTypeId() != AiPackageTypeId::Combat)
+                break;
+            MWWorld::Ptr target = package->getTarget();
+            if (!target.isEmpty())
+                out.push_back(CombatTargetRating{ std::move(target) });
+        }
+
+        return out.size() > initialSize;
+    }
+
+    void AiSequence::execute(const MWWorld::Ptr& actor, CharacterController& characterController, float duration,
+        bool outOfRange, std::span<const CombatTargetRating> combatTargetRatings)
     {
         if (actor == getPlayer())
         {
@@ -258,6 +294,9 @@ namespace MWMechanics
 
             float bestRating = 0.f;
 
+            // The only target is chosen regardless of its rating
+            const bool rateTargets = hasMultipleCombatPackages();
+
             for (auto it = mPackages.begin(); it != mPackages.end();)
             {
                 if ((*it)->getTypeId() != AiPackageTypeId::Combat)
@@ -272,7 +311,7 @@ namespace MWMechanics
                 }
                 else
                 {
-                    float rating = MWMechanics::getBestActionRating(actor, target);
+                    const float rating = rateTargets ? getCombatTargetRating(actor, target, combatTargetRatings) : 0.f;
 
                     const ESM::Position& targetPos = target.getRefData().getPosition();
 
@@ -3,17 +3,15 @@
 
 #include <algorithm>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "aipackagetypeid.hpp"
 #include "aistate.hpp"
 
-#include <components/esm3/loadnpc.hpp>
+#include "../mwworld/ptr.hpp"
 
-namespace MWWorld
-{
-    class Ptr;
-}
+#include <components/esm3/loadnpc.hpp>
 
 namespace ESM
 {
@@ -30,6 +28,13 @@ namespace MWMechanics
 
     using AiPackages = std::vector<std::shared_ptr<AiPackage>>;
 
+    /// Rating of a combat target by getBestActionRating computed ahead of AiSequence::execute
+    struct CombatTargetRating
+    {
+        MWWorld::Ptr mTarget;
+        float mRating = 0;
+    };
+
     /// \brief Sequence of AI-packages for a single actor
     /** The top-most AI package is run each frame. When completed, it is removed from the stack. **/
     class AiSequence
@@ -55,6 +60,9 @@ namespace MWMechanics
 
         AiPackages::iterator erase(AiPackages::iterator package);
 
+        /// Combat packages are on top, so there are several targets to choose from
+        bool hasMultipleCombatPackages() const;
+
     public:
         /// Default constructor
         AiSequence();
@@ -144,9 +152,15 @@ namespace MWMechanics
         /// Removes all pursue packages until first non-pursue or stack empty.
         void stopPursuit();
 
+        /// Add the targets execute has to rate to choose the one to fight.
+        /// @return false if there is no choice, so nothing is added
+        bool getCombatTargetsToRate(std::vector<CombatTargetRating>& out) const;
+
         /// Execute current package, switching if needed.
+        /// @param combatTargetRatings ratings computed ahead for the targets from getCombatTargetsToRate, the missing
+        /// ones are rated by this call
         void execute(const MWWorld::Ptr& actor, CharacterController& characterController, float duration,
-            bool outOfRange = false);
+            bool outOfRange = false, std::span<const CombatTargetRating> combatTargetRatings = {});
 
         /// Simulate the passing of time using the currently active AI package
         void fastForward(const MWWorld::Ptr& actor);
@@ -271,11 +271,12 @@ namespace MWMechanics
         invStore.autoEquip(ptr);
     }
 
-    MechanicsManager::MechanicsManager()
+    MechanicsManager::MechanicsManager(Misc::JobSystem& jobSystem)
         : mUpdatePlayer(true)
         , mClassSelected(false)
         , mRaceSelected(false)
         , mAI(true)
+        , mActors(jobSystem)
     {
         // buildPlayer no longer here, needs to be done explicitly after all subsystems are up and running
     }
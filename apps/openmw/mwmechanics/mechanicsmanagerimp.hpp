@@ -38,7 +38,7 @@ namespace MWMechanics
         ///< build player according to stored class/race/birthsign information. Will
         /// default to the values of the ESM::NPC object, if no explicit information is given.
 
-        MechanicsManager();
+        explicit MechanicsManager(Misc::JobSystem& jobSystem);
 
         void add(const MWWorld::Ptr& ptr) override;
         ///< Register an object for management
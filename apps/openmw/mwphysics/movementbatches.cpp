@@ -0,0 +1,58 @@
+#include "movementbatches.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <numeric>
+
+namespace MWPhysics
+{
+    namespace
+    {
+        std::uint64_t spreadBits(std::uint32_t value)
+        {
+            std::uint64_t result = value;
+            result = (result | (result << 16)) & 0x0000FFFF0000FFFFull;
+            result = (result | (result << 8)) & 0x00FF00FF00FF00FFull;
+            result = (result | (result << 4)) & 0x0F0F0F0F0F0F0F0Full;
+            result = (result | (result << 2)) & 0x3333333333333333ull;
+            result = (result | (result << 1)) & 0x5555555555555555ull;
+            return result;
+        }
+
+        std::uint32_t toUnsigned(float coordinate)
+        {
+            const float region = std::floor(coordinate / MovementBatches::sRegionSize);
+            if (std::isnan(region))
+                return 0x80000000u;
+            const float limit = 1 << 30;
+            return static_cast<std::uint32_t>(static_cast<std::int32_t>(std::clamp(region, -limit, limit)))
+                ^ 0x80000000u;
+        }
+
+        // Z-order curve index, so regions next to each other mostly have close keys
+        std::uint64_t getRegionKey(const osg::Vec3f& position)
+        {
+            return spreadBits(toUnsigned(position.x())) | (spreadBits(toUnsigned(position.y())) << 1);
+        }
+    }
+
+    void MovementBatches::build(std::span<const osg::Vec3f> positions, std::size_t maxBatchSize)
+    {
+        assert(maxBatchSize > 0);
+
+        mRegions.resize(positions.size());
+        std::transform(positions.begin(), positions.end(), mRegions.begin(), getRegionKey);
+
+        mOrder.resize(positions.size());
+        std::iota(mOrder.begin(), mOrder.end(), std::size_t{ 0 });
+        // Stable to keep the simulation order within a region
+        std::stable_sort(mOrder.begin(), mOrder.end(),
+            [&](std::size_t left, std::size_t right) { return mRegions[left] < mRegions[right]; });
+
+        mBatchBegins.clear();
+        for (std::size_t i = 0; i < mOrder.size(); i += maxBatchSize)
+            mBatchBegins.push_back(i);
+        mBatchBegins.push_back(mOrder.size());
+    }
+}
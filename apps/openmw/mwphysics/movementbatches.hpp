@@ -0,0 +1,41 @@
+#ifndef OPENMW_MWPHYSICS_MOVEMENTBATCHES_H
+#define OPENMW_MWPHYSICS_MOVEMENTBATCHES_H
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include <osg/Vec3f>
+
+namespace MWPhysics
+{
+    /// Splits the objects simulated in a frame into batches of objects close to each other. A worker takes a whole
+    /// batch at once, so its consecutive sweep tests touch the same region of the broadphase tree.
+    class MovementBatches
+    {
+    public:
+        /// Size of the square regions to group objects by
+        static constexpr float sRegionSize = 1024;
+
+        /// @param positions position of each object
+        /// @param maxBatchSize maximum number of objects in a batch, must be greater than zero
+        void build(std::span<const osg::Vec3f> positions, std::size_t maxBatchSize);
+
+        std::size_t getBatchesCount() const { return mBatchBegins.empty() ? 0 : mBatchBegins.size() - 1; }
+
+        /// @return indices of the objects in the batch
+        std::span<const std::size_t> getBatch(std::size_t index) const
+        {
+            return std::span(mOrder).subspan(mBatchBegins[index], mBatchBegins[index + 1] - mBatchBegins[index]);
+        }
+
+    private:
+        // Kept as separate arrays to sort the objects without moving their state
+        std::vector<std::uint64_t> mRegions;
+        std::vector<std::size_t> mOrder;
+        std::vector<std::size_t> mBatchBegins;
+    };
+}
+
+#endif
@@ -1,14 +1,17 @@
 #include "mtphysics.hpp"
 
+#include <algorithm>
 #include <cassert>
 #include <functional>
 #include <mutex>
 #include <optional>
 #include <shared_mutex>
+#include <utility>
 #include <variant>
 
 #include <BulletCollision/BroadphaseCollision/btDbvtBroadphase.h>
 #include <BulletCollision/CollisionShapes/btCollisionShape.h>
+#include <BulletCollision/CollisionShapes/btSphereShape.h>
 
 #include <osg/Stats>
 
@@ -28,6 +31,7 @@
 #include "../mwbase/world.hpp"
 
 #include "actor.hpp"
+#include "closestnotmerayresultcallback.hpp"
 #include "contacttestwrapper.h"
 #include "movementsolver.hpp"
 #include "object.hpp"
@@ -111,6 +115,9 @@ namespace
         std::variant<std::monostate, std::unique_lock<Mutex>, std::shared_lock<Mutex>> mImpl;
     };
 
+    // Bigger batches make the load on the threads uneven
+    constexpr std::size_t maxBatchSize = 16;
+
     bool isUnderWater(const MWPhysics::ActorFrameData& actorData)
     {
         return actorData.mPosition.z() < actorData.mSwimLevel;
@@ -154,11 +161,15 @@ namespace
         struct InitPosition
         {
             const btCollisionWorld* mCollisionWorld;
+            std::vector<osg::Vec3f>& mPositions;
             void operator()(MWPhysics::ActorSimulation& sim) const
             {
                 auto locked = sim.lock();
                 if (!locked.has_value())
+                {
+                    mPositions.emplace_back();
                     return;
+                }
                 auto& [actor, frameDataRef] = *locked;
                 auto& frameData = frameDataRef.get();
                 actor->applyOffsetChange();
@@ -177,8 +188,18 @@ namespace
                 frameData.mInertia = actor->getInertialForce();
                 frameData.mStuckFrames = actor->getStuckFrames();
                 frameData.mLastStuckPosition = actor->getLastStuckPosition();
+                mPositions.push_back(frameData.mPosition);
+            }
+            void operator()(MWPhysics::ProjectileSimulation& sim) const
+            {
+                auto locked = sim.lock();
+                if (!locked.has_value())
+                {
+                    mPositions.emplace_back();
+                    return;
+                }
+                mPositions.push_back(locked->second.get().mPosition);
             }
-            void operator()(MWPhysics::ProjectileSimulation& /*sim*/) const {}
         };
 
         struct PreStep
@@ -317,15 +338,18 @@ namespace MWPhysics
         , mTimeAccum(0.f)
         , mCollisionWorld(collisionWorld)
         , mDebugDrawer(debugDrawer)
+        , mSnapshots(static_cast<std::size_t>(std::max(0, Settings::Manager::getInt("recorded steps", "Physics"))))
         , mNumThreads(Config::computeNumThreads())
         , mNumJobs(0)
         , mRemainingSteps(0)
         , mLOSCacheExpiry(Settings::Manager::getInt("lineofsight keep inactive cache", "Physics"))
         , mFrameCounter(0)
         , mAdvanceSimulation(false)
+        , mDeterministic(Settings::Manager::getBool("deterministic stepping", "Physics"))
         , mQuit(false)
         , mNextJob(0)
         , mNextLOS(0)
+        , mNextRayCast(0)
         , mFrameNumber(0)
         , mTimer(osg::Timer::instance())
         , mPrevStepCount(1)
@@ -401,6 +425,9 @@ namespace MWPhysics
         if (numSteps > maxAllowedSteps)
         {
             numSteps = maxAllowedSteps;
+            // keep the same step duration to get the same result for the same input, slow down the simulation instead
+            if (mDeterministic || mReplayEnd.has_value())
+                return std::make_tuple(numSteps, actualDelta);
             // ensure that we do not simulate a frame ahead when doing delta time; this reduces stutter and latency
             // this causes interpolation to 100% use the most recent physics result when true delta time is happening
             // and we deliberately simulate up to exactly the timestamp that we want to render
@@ -438,15 +465,25 @@ namespace MWPhysics
             updateStats(frameStart, frameNumber, stats);
         }
 
+        deliverRayCasts();
+
         auto [numSteps, newDelta] = calculateStepConfig(timeAccum);
         timeAccum -= numSteps * newDelta;
+        // drop the time the simulation can't catch up with
+        if (mDeterministic || mReplayEnd.has_value())
+            timeAccum = std::min(timeAccum, newDelta);
 
         // init
-        const Visitors::InitPosition vis{ mCollisionWorld };
+        mSimulationPositions.clear();
+        const Visitors::InitPosition vis{ mCollisionWorld, mSimulationPositions };
         for (auto& sim : simulations)
         {
             std::visit(vis, sim);
         }
+        // Several batches per thread to balance the load when actors in some regions take longer to simulate
+        const std::size_t batchSize
+            = std::clamp<std::size_t>(simulations.size() / (std::max(mNumThreads, 1u) * 4), 1, maxBatchSize);
+        mBatches.build(mSimulationPositions, batchSize);
         mPrevStepCount = numSteps;
         mRemainingSteps = numSteps;
         mTimeAccum = timeAccum;
@@ -454,7 +491,7 @@ namespace MWPhysics
         mSimulations = &simulations;
         mAdvanceSimulation = (mRemainingSteps != 0);
         ++mFrameCounter;
-        mNumJobs = mSimulations->size();
+        mNumJobs = static_cast<int>(mBatches.getBatchesCount());
         mNextLOS.store(0, std::memory_order_relaxed);
         mNextJob.store(0, std::memory_order_release);
 
@@ -485,6 +522,9 @@ namespace MWPhysics
         MaybeExclusiveLock lock(mSimulationMutex, mNumThreads);
         mBudget.reset(mDefaultPhysicsDt);
         mAsyncBudget.reset(0.0f);
+        // Recorded positions are not valid anymore
+        mSnapshots.clear();
+        mReplayEnd.reset();
         if (mSimulations != nullptr)
         {
             mSimulations->clear();
@@ -497,6 +537,25 @@ namespace MWPhysics
         }
     }
 
+    const PhysicsSnapshot* PhysicsTaskScheduler::startReplay(std::size_t steps)
+    {
+        waitForWorkers();
+        MaybeExclusiveLock lock(mSimulationMutex, mNumThreads);
+        const PhysicsSnapshot* const latest = mSnapshots.getLatest();
+        if (steps == 0 || mReplayEnd.has_value() || latest == nullptr || latest->mStep < steps)
+            return nullptr;
+        const std::uint64_t firstStep = latest->mStep - steps + 1;
+        const PhysicsSnapshot* const initial = mSnapshots.find(firstStep - 1);
+        if (initial == nullptr)
+            return nullptr;
+        // Apply the results of the previous simulation now so they don't override the restored state
+        syncWithMainThread();
+        mStep = firstStep;
+        mReplayEnd = latest->mStep;
+        mReplayMaxError = 0;
+        return initial;
+    }
+
     void PhysicsTaskScheduler::rayTest(const btVector3& rayFromWorld, const btVector3& rayToWorld,
         btCollisionWorld::RayResultCallback& resultCallback) const
     {
@@ -600,6 +659,74 @@ namespace MWPhysics
         return result->mResult;
     }
 
+    void PhysicsTaskScheduler::queueRayCast(RayCastRequest&& request)
+    {
+        const std::lock_guard lock(mQueuedRayCastsMutex);
+        mQueuedRayCasts.push_back(std::move(request));
+    }
+
+    void PhysicsTaskScheduler::resolveRayCasts()
+    {
+        int job = 0;
+        const int numRayCasts = static_cast<int>(mRayCasts.size());
+        while ((job = mNextRayCast.fetch_add(1, std::memory_order_relaxed)) < numRayCasts)
+            resolveRayCast(mRayCasts[job]);
+    }
+
+    void PhysicsTaskScheduler::resolveRayCast(RayCastRequest& request) const
+    {
+        if (request.mRadius > 0)
+        {
+            btCollisionWorld::ClosestConvexResultCallback callback(request.mFrom, request.mTo);
+            callback.m_collisionFilterGroup = request.mGroup;
+            callback.m_collisionFilterMask = request.mMask;
+            const btSphereShape shape(request.mRadius);
+            const btTransform from(btQuaternion::getIdentity(), request.mFrom);
+            const btTransform to(btQuaternion::getIdentity(), request.mTo);
+            convexSweepTest(&shape, from, to, callback);
+            request.mHit = callback.hasHit();
+            request.mHitPos = callback.m_hitPointWorld;
+            request.mHitNormal = callback.m_hitNormalWorld;
+            request.mHitObject = callback.m_hitCollisionObject;
+            return;
+        }
+        if (request.mFrom == request.mTo)
+            return;
+        ClosestNotMeRayResultCallback callback(request.mIgnore, request.mTargets, request.mFrom, request.mTo);
+        callback.m_collisionFilterGroup = request.mGroup;
+        callback.m_collisionFilterMask = request.mMask;
+        rayTest(request.mFrom, request.mTo, callback);
+        request.mHit = callback.hasHit();
+        request.mHitPos = callback.m_hitPointWorld;
+        request.mHitNormal = callback.m_hitNormalWorld;
+        request.mHitObject = callback.m_collisionObject;
+    }
+
+    void PhysicsTaskScheduler::deliverRayCasts()
+    {
+        std::vector<RayCastRequest> resolved;
+        {
+            const std::lock_guard lock(mQueuedRayCastsMutex);
+            resolved = std::exchange(mRayCasts, std::exchange(mQueuedRayCasts, {}));
+        }
+        mNextRayCast.store(0, std::memory_order_relaxed);
+        // Callbacks are allowed to submit new requests
+        for (RayCastRequest& request : resolved)
+        {
+            RayCastingResult result;
+            result.mHit = request.mHit;
+            if (request.mHit)
+            {
+                result.mHitPos = Misc::Convert::toOsg(request.mHitPos);
+                result.mHitNormal = Misc::Convert::toOsg(request.mHitNormal);
+                // The object could be removed after the ray was cast
+                if (const auto* ptrHolder = static_cast<PtrHolder*>(getUserPointer(request.mHitObject)))
+                    result.mHitObject = ptrHolder->getPtr();
+            }
+            request.mCallback(result);
+        }
+    }
+
     void PhysicsTaskScheduler::refreshLOSCache()
     {
         MaybeSharedLock lock(mLOSCacheMutex, mNumThreads);
@@ -627,6 +754,9 @@ namespace MWPhysics
                 updatePtrAabb(p);
         });
         mUpdateAabb.clear();
+        const std::lock_guard rayCastsLock(mQueuedRayCastsMutex);
+        mQueuedRayCasts.clear();
+        mRayCasts.clear();
     }
 
     void PhysicsTaskScheduler::updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr)
@@ -700,12 +830,14 @@ namespace MWPhysics
             const Visitors::Move impl{ mPhysicsDt, mCollisionWorld, *mWorldFrameData };
             const Visitors::WithLockedPtr<Visitors::Move, MaybeLock> vis{ impl, mCollisionWorldMutex, mNumThreads };
             while ((job = mNextJob.fetch_add(1, std::memory_order_relaxed)) < mNumJobs)
-                std::visit(vis, (*mSimulations)[job]);
+                for (const std::size_t simulation : mBatches.getBatch(job))
+                    std::visit(vis, (*mSimulations)[simulation]);
 
             mPostStepBarrier->wait([this] { afterPostStep(); });
         }
 
         refreshLOSCache();
+        resolveRayCasts();
         mPostSimBarrier->wait([this] { afterPostSim(); });
     }
 
@@ -748,6 +880,9 @@ namespace MWPhysics
             mSimulations = nullptr;
         }
         mUpdateAabb.clear();
+        const std::lock_guard rayCastsLock(mQueuedRayCastsMutex);
+        mQueuedRayCasts.clear();
+        mRayCasts.clear();
     }
 
     void PhysicsTaskScheduler::afterPreStep()
@@ -760,6 +895,7 @@ namespace MWPhysics
             mNumThreads };
         for (auto& sim : *mSimulations)
             std::visit(vis, sim);
+        beginStep();
     }
 
     void PhysicsTaskScheduler::afterPostStep()
@@ -768,10 +904,87 @@ namespace MWPhysics
         {
             --mRemainingSteps;
             updateActorsPositions();
+            finishStep();
         }
         mNextJob.store(0, std::memory_order_release);
     }
 
+    void PhysicsTaskScheduler::beginStep()
+    {
+        if (mReplayEnd.has_value())
+        {
+            const PhysicsSnapshot* const snapshot = mSnapshots.find(mStep);
+            assert(snapshot != nullptr);
+            mPhysicsDt = snapshot->mDt;
+            for (Simulation& sim : *mSimulations)
+            {
+                auto* const actorSim = std::get_if<ActorSimulation>(&sim);
+                if (actorSim == nullptr)
+                    continue;
+                const auto locked = actorSim->lock();
+                if (!locked.has_value())
+                    continue;
+                if (const ActorSnapshot* const actor = snapshot->findActor(locked->first->getPtr().mRef))
+                {
+                    locked->second.get().mMovement = actor->mMovement;
+                    locked->second.get().mRotation = actor->mRotation;
+                }
+            }
+            return;
+        }
+        if (mSnapshots.getCapacity() == 0)
+            return;
+        PhysicsSnapshot& snapshot = mSnapshots.beginRecord(mStep, mPhysicsDt);
+        for (Simulation& sim : *mSimulations)
+        {
+            auto* const actorSim = std::get_if<ActorSimulation>(&sim);
+            if (actorSim == nullptr)
+                continue;
+            const auto locked = actorSim->lock();
+            if (!locked.has_value())
+                continue;
+            const ActorFrameData& frameData = locked->second.get();
+            snapshot.mActors.push_back(
+                ActorSnapshot{ locked->first->getPtr().mRef, frameData.mMovement, frameData.mRotation });
+        }
+        mSnapshots.endRecord();
+    }
+
+    void PhysicsTaskScheduler::finishStep()
+    {
+        if (PhysicsSnapshot* const snapshot = mSnapshots.find(mStep))
+        {
+            for (Simulation& sim : *mSimulations)
+            {
+                auto* const actorSim = std::get_if<ActorSimulation>(&sim);
+                if (actorSim == nullptr)
+                    continue;
+                const auto locked = actorSim->lock();
+                if (!locked.has_value())
+                    continue;
+                ActorSnapshot* const actor = snapshot->findActor(locked->first->getPtr().mRef);
+                if (actor == nullptr)
+                    continue;
+                const ActorFrameData& frameData = locked->second.get();
+                if (mReplayEnd.has_value())
+                {
+                    mReplayMaxError = std::max(mReplayMaxError, (actor->mPosition - frameData.mPosition).length());
+                    continue;
+                }
+                actor->mPosition = frameData.mPosition;
+                actor->mInertia = frameData.mInertia;
+                actor->mOnGround = frameData.mIsOnGround;
+            }
+        }
+        if (mReplayEnd == mStep)
+        {
+            Log(Debug::Info) << "Replayed physics steps up to " << mStep
+                             << ", max difference from the recorded actor positions: " << mReplayMaxError;
+            mReplayEnd.reset();
+        }
+        ++mStep;
+    }
+
     void PhysicsTaskScheduler::afterPostSim()
     {
         {
@@ -3,16 +3,21 @@
 
 #include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <mutex>
 #include <optional>
 #include <shared_mutex>
 #include <thread>
 #include <unordered_set>
+#include <vector>
 
 #include <BulletCollision/CollisionDispatch/btCollisionWorld.h>
 
 #include <osg/Timer>
 
 #include "components/misc/budgetmeasurement.hpp"
+#include "movementbatches.hpp"
+#include "physicssnapshots.hpp"
 #include "physicssystem.hpp"
 #include "ptrholder.hpp"
 
@@ -28,6 +33,25 @@ namespace MWRender
 
 namespace MWPhysics
 {
+    /// Ray or sphere cast submitted during a frame and resolved by the physics threads after the simulation step
+    struct RayCastRequest
+    {
+        RayCastingCallback mCallback;
+        btVector3 mFrom;
+        btVector3 mTo;
+        /// Cast a sphere of this radius when greater than zero
+        float mRadius = 0;
+        const btCollisionObject* mIgnore = nullptr;
+        std::vector<const btCollisionObject*> mTargets;
+        int mMask = CollisionType_Default;
+        int mGroup = 0xff;
+
+        bool mHit = false;
+        btVector3 mHitPos;
+        btVector3 mHitNormal;
+        const btCollisionObject* mHitObject = nullptr;
+    };
+
     class PhysicsTaskScheduler
     {
     public:
@@ -44,6 +68,11 @@ namespace MWPhysics
 
         void resetSimulation(const ActorMap& actors);
 
+        /// @brief start simulating again the last recorded steps using the recorded actors movement
+        /// @param steps how many steps to replay
+        /// @return state of the actors to restore before the first replayed step, nullptr if the steps are not recorded
+        const PhysicsSnapshot* startReplay(std::size_t steps);
+
         // Thread safe wrappers
         void rayTest(const btVector3& rayFromWorld, const btVector3& rayToWorld,
             btCollisionWorld::RayResultCallback& resultCallback) const;
@@ -58,6 +87,8 @@ namespace MWPhysics
         void removeCollisionObject(btCollisionObject* collisionObject);
         void updateSingleAabb(const std::shared_ptr<PtrHolder>& ptr, bool immediate = false);
         bool getLineOfSight(const std::shared_ptr<Actor>& actor1, const std::shared_ptr<Actor>& actor2);
+        /// Result is passed to the request callback from the main thread during the next applyQueuedMovements
+        void queueRayCast(RayCastRequest&& request);
         void debugDraw();
         void* getUserPointer(const btCollisionObject* object) const;
         void releaseSharedStates(); // destroy all objects whose destructor can't be safely called from
@@ -69,6 +100,11 @@ namespace MWPhysics
         void updateActorsPositions();
         bool hasLineOfSight(const Actor* actor1, const Actor* actor2);
         void refreshLOSCache();
+        void beginStep();
+        void finishStep();
+        void resolveRayCasts();
+        void resolveRayCast(RayCastRequest& request) const;
+        void deliverRayCasts();
         void updateAabbs();
         void updatePtrAabb(const std::shared_ptr<PtrHolder>& ptr);
         void updateStats(osg::Timer_t frameStart, unsigned int frameNumber, osg::Stats& stats);
@@ -81,6 +117,10 @@ namespace MWPhysics
 
         std::unique_ptr<WorldFrameData> mWorldFrameData;
         std::vector<Simulation>* mSimulations = nullptr;
+        /// Position of each simulation at the frame start
+        std::vector<osg::Vec3f> mSimulationPositions;
+        /// Jobs of the workers, each is a batch of simulations
+        MovementBatches mBatches;
         std::unordered_set<const btCollisionObject*> mCollisionObjects;
         float mDefaultPhysicsDt;
         float mPhysicsDt;
@@ -88,6 +128,17 @@ namespace MWPhysics
         btCollisionWorld* mCollisionWorld;
         MWRender::DebugDrawer* mDebugDrawer;
         std::vector<LOSRequest> mLOSCache;
+        PhysicsSnapshots mSnapshots;
+        /// Number of the next simulation step
+        std::uint64_t mStep = 0;
+        /// Last step to replay, set only while replaying
+        std::optional<std::uint64_t> mReplayEnd;
+        /// Maximum distance between the recorded and the replayed actor position
+        float mReplayMaxError = 0;
+        /// Submitted since the last applyQueuedMovements
+        std::vector<RayCastRequest> mQueuedRayCasts;
+        /// Resolved by the workers during the current simulation
+        std::vector<RayCastRequest> mRayCasts;
         std::set<std::weak_ptr<PtrHolder>, std::owner_less<std::weak_ptr<PtrHolder>>> mUpdateAabb;
 
         // TODO: use std::experimental::flex_barrier or std::barrier once it becomes a thing
@@ -101,9 +152,11 @@ namespace MWPhysics
         int mLOSCacheExpiry;
         std::size_t mFrameCounter;
         bool mAdvanceSimulation;
+        bool mDeterministic;
         bool mQuit;
         std::atomic<int> mNextJob;
         std::atomic<int> mNextLOS;
+        std::atomic<int> mNextRayCast;
         std::vector<std::thread> mThreads;
 
         std::size_t mWorkersFrameCounter = 0;
@@ -114,6 +167,7 @@ namespace MWPhysics
         mutable std::shared_mutex mCollisionWorldMutex;
         mutable std::shared_mutex mLOSCacheMutex;
         mutable std::mutex mUpdateAabbMutex;
+        std::mutex mQueuedRayCastsMutex;
         std::condition_variable_any mHasJob;
 
         unsigned int mFrameNumber;
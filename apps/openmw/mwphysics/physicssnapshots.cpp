@@ -0,0 +1,80 @@
+#include "physicssnapshots.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <utility>
+
+namespace MWPhysics
+{
+    ActorSnapshot* PhysicsSnapshot::findActor(const MWWorld::LiveCellRefBase* ref)
+    {
+        return const_cast<ActorSnapshot*>(std::as_const(*this).findActor(ref));
+    }
+
+    const ActorSnapshot* PhysicsSnapshot::findActor(const MWWorld::LiveCellRefBase* ref) const
+    {
+        const auto it = std::lower_bound(mActors.begin(), mActors.end(), ref,
+            [](const ActorSnapshot& actor, const MWWorld::LiveCellRefBase* value) {
+                return std::less<>()(actor.mRef, value);
+            });
+        if (it == mActors.end() || it->mRef != ref)
+            return nullptr;
+        return &*it;
+    }
+
+    PhysicsSnapshots::PhysicsSnapshots(std::size_t capacity)
+        : mSnapshots(capacity)
+    {
+    }
+
+    PhysicsSnapshot& PhysicsSnapshots::beginRecord(std::uint64_t step, float dt)
+    {
+        assert(!mSnapshots.empty());
+        if (!empty() && get(mSize - 1).mStep + 1 != step)
+            clear();
+        if (mSize == mSnapshots.size())
+            mBegin = (mBegin + 1) % mSnapshots.size();
+        else
+            ++mSize;
+        PhysicsSnapshot& result = get(mSize - 1);
+        result.mStep = step;
+        result.mDt = dt;
+        // Keep the allocated memory
+        result.mActors.clear();
+        return result;
+    }
+
+    void PhysicsSnapshots::endRecord()
+    {
+        assert(!empty());
+        std::vector<ActorSnapshot>& actors = get(mSize - 1).mActors;
+        std::sort(actors.begin(), actors.end(), [](const ActorSnapshot& left, const ActorSnapshot& right) {
+            return std::less<>()(left.mRef, right.mRef);
+        });
+    }
+
+    const PhysicsSnapshot* PhysicsSnapshots::find(std::uint64_t step) const
+    {
+        if (empty() || step < get(0).mStep)
+            return nullptr;
+        // Steps are recorded without gaps
+        const std::uint64_t index = step - get(0).mStep;
+        if (index >= mSize)
+            return nullptr;
+        assert(get(index).mStep == step);
+        return &get(index);
+    }
+
+    PhysicsSnapshot* PhysicsSnapshots::find(std::uint64_t step)
+    {
+        return const_cast<PhysicsSnapshot*>(std::as_const(*this).find(step));
+    }
+
+    const PhysicsSnapshot* PhysicsSnapshots::getLatest() const
+    {
+        if (empty())
+            return nullptr;
+        return &get(mSize - 1);
+    }
+}
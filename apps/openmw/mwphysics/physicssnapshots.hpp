@@ -0,0 +1,87 @@
+#ifndef OPENMW_MWPHYSICS_PHYSICSSNAPSHOTS_H
+#define OPENMW_MWPHYSICS_PHYSICSSNAPSHOTS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <osg/Vec2f>
+#include <osg/Vec3f>
+
+namespace MWWorld
+{
+    class LiveCellRefBase;
+}
+
+namespace MWPhysics
+{
+    struct ActorSnapshot
+    {
+        const MWWorld::LiveCellRefBase* mRef = nullptr;
+        // Input of the step
+        osg::Vec3f mMovement{};
+        osg::Vec2f mRotation{};
+        // Result of the step
+        osg::Vec3f mPosition{};
+        osg::Vec3f mInertia{};
+        bool mOnGround = false;
+    };
+
+    struct PhysicsSnapshot
+    {
+        std::uint64_t mStep = 0;
+        float mDt = 0;
+        /// Sorted by mRef
+        std::vector<ActorSnapshot> mActors;
+
+        ActorSnapshot* findActor(const MWWorld::LiveCellRefBase* ref);
+        const ActorSnapshot* findActor(const MWWorld::LiveCellRefBase* ref) const;
+    };
+
+    /// Ring buffer with the state of the actors after each of the last simulation steps
+    class PhysicsSnapshots
+    {
+    public:
+        /// @param capacity maximum number of the stored steps, 0 disables recording
+        explicit PhysicsSnapshots(std::size_t capacity);
+
+        std::size_t getCapacity() const { return mSnapshots.size(); }
+
+        std::size_t getSize() const { return mSize; }
+
+        bool empty() const { return mSize == 0; }
+
+        /// Replaces the oldest snapshot when full. Drops all snapshots when the step doesn't follow the latest one.
+        /// Actors are added to the returned snapshot, then it has to be finished by endRecord.
+        PhysicsSnapshot& beginRecord(std::uint64_t step, float dt);
+
+        void endRecord();
+
+        /// @return nullptr if the step was not recorded or was already replaced
+        const PhysicsSnapshot* find(std::uint64_t step) const;
+
+        PhysicsSnapshot* find(std::uint64_t step);
+
+        const PhysicsSnapshot* getLatest() const;
+
+        void clear()
+        {
+            mBegin = 0;
+            mSize = 0;
+        }
+
+    private:
+        std::vector<PhysicsSnapshot> mSnapshots;
+        std::size_t mBegin = 0;
+        std::size_t mSize = 0;
+
+        PhysicsSnapshot& get(std::size_t index) { return mSnapshots[(mBegin + index) % mSnapshots.size()]; }
+
+        const PhysicsSnapshot& get(std::size_t index) const
+        {
+            return mSnapshots[(mBegin + index) % mSnapshots.size()];
+        }
+    };
+}
+
+#endif
@@ -291,33 +291,8 @@ namespace MWPhysics
         btVector3 btFrom = Misc::Convert::toBullet(from);
         btVector3 btTo = Misc::Convert::toBullet(to);
 
-        const btCollisionObject* me = nullptr;
-        std::vector<const btCollisionObject*> targetCollisionObjects;
-
-        if (!ignore.isEmpty())
-        {
-            const Actor* actor = getActor(ignore);
-            if (actor)
-                me = actor->getCollisionObject();
-            else
-            {
-                const Object* object = getObject(ignore);
-                if (object)
-                    me = object->getCollisionObject();
-            }
-        }
-
-        if (!targets.empty())
-        {
-            for (const MWWorld::Ptr& target : targets)
-            {
-                const Actor* actor = getActor(target);
-                if (actor)
-                    targetCollisionObjects.push_back(actor->getCollisionObject());
-            }
-        }
-
-        ClosestNotMeRayResultCallback resultCallback(me, targetCollisionObjects, btFrom, btTo);
+        ClosestNotMeRayResultCallback resultCallback(
+            getIgnoredCollisionObject(ignore), getTargetCollisionObjects(targets), btFrom, btTo);
         resultCallback.m_collisionFilterGroup = group;
         resultCallback.m_collisionFilterMask = mask;
 
@@ -363,6 +338,56 @@ namespace MWPhysics
         return result;
     }
 
+    void PhysicsSystem::asyncCastRay(RayCastingCallback callback, const osg::Vec3f& from, const osg::Vec3f& to,
+        const MWWorld::ConstPtr& ignore, const std::vector<MWWorld::Ptr>& targets, int mask, int group) const
+    {
+        RayCastRequest request;
+        request.mCallback = std::move(callback);
+        request.mFrom = Misc::Convert::toBullet(from);
+        request.mTo = Misc::Convert::toBullet(to);
+        request.mIgnore = getIgnoredCollisionObject(ignore);
+        request.mTargets = getTargetCollisionObjects(targets);
+        request.mMask = mask;
+        request.mGroup = group;
+        mTaskScheduler->queueRayCast(std::move(request));
+    }
+
+    void PhysicsSystem::asyncCastSphere(RayCastingCallback callback, const osg::Vec3f& from, const osg::Vec3f& to,
+        float radius, int mask, int group) const
+    {
+        RayCastRequest request;
+        request.mCallback = std::move(callback);
+        request.mFrom = Misc::Convert::toBullet(from);
+        request.mTo = Misc::Convert::toBullet(to);
+        request.mRadius = radius;
+        request.mMask = mask;
+        request.mGroup = group;
+        mTaskScheduler->queueRayCast(std::move(request));
+    }
+
+    const btCollisionObject* PhysicsSystem::getIgnoredCollisionObject(const MWWorld::ConstPtr& ignore) const
+    {
+        if (ignore.isEmpty())
+            return nullptr;
+        if (const Actor* actor = getActor(ignore))
+            return actor->getCollisionObject();
+        if (const Object* object = getObject(ignore))
+            return object->getCollisionObject();
+        return nullptr;
+    }
+
+    std::vector<const btCollisionObject*> PhysicsSystem::getTargetCollisionObjects(
+        const std::vector<MWWorld::Ptr>& targets) const
+    {
+        std::vector<const btCollisionObject*> result;
+        for (const MWWorld::Ptr& target : targets)
+        {
+            if (const Actor* actor = getActor(target))
+                result.push_back(actor->getCollisionObject());
+        }
+        return result;
+    }
+
     bool PhysicsSystem::getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const
     {
         if (actor1 == actor2)
@@ -809,6 +834,24 @@ namespace MWPhysics
         }
     }
 
+    bool PhysicsSystem::replay(std::size_t steps)
+    {
+        const PhysicsSnapshot* const initial = mTaskScheduler->startReplay(steps);
+        if (initial == nullptr)
+            return false;
+        for (const ActorSnapshot& state : initial->mActors)
+        {
+            const auto it = mActors.find(state.mRef);
+            if (it == mActors.end())
+                continue;
+            Actor& actor = *it->second;
+            MWBase::Environment::get().getWorld()->moveObject(actor.getPtr(), state.mPosition);
+            actor.setInertialForce(state.mInertia);
+            actor.setOnGround(state.mOnGround);
+        }
+        return true;
+    }
+
     void PhysicsSystem::moveActors()
     {
         auto* player = getActor(MWMechanics::getPlayer());
@@ -199,6 +199,11 @@ namespace MWPhysics
 
         /// Apply new positions to actors
         void moveActors();
+
+        /// Move actors to the state recorded before the last \a steps simulation steps and simulate these steps again
+        /// using the recorded movement of the actors.
+        /// @return false if the steps are not recorded
+        bool replay(std::size_t steps);
         void debugDraw();
 
         std::vector<MWWorld::Ptr> getCollisions(const MWWorld::ConstPtr& ptr, int collisionGroup,
@@ -227,6 +232,14 @@ namespace MWPhysics
         RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
             int mask = CollisionType_Default, int group = 0xff) const override;
 
+        void asyncCastRay(RayCastingCallback callback, const osg::Vec3f& from, const osg::Vec3f& to,
+            const MWWorld::ConstPtr& ignore = MWWorld::ConstPtr(),
+            const std::vector<MWWorld::Ptr>& targets = std::vector<MWWorld::Ptr>(), int mask = CollisionType_Default,
+            int group = 0xff) const override;
+
+        void asyncCastSphere(RayCastingCallback callback, const osg::Vec3f& from, const osg::Vec3f& to, float radius,
+            int mask = CollisionType_Default, int group = 0xff) const override;
+
         /// Return true if actor1 can see actor2.
         bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const override;
 
@@ -301,6 +314,9 @@ namespace MWPhysics
 
         void prepareSimulation(bool willSimulate, std::vector<Simulation>& simulations);
 
+        const btCollisionObject* getIgnoredCollisionObject(const MWWorld::ConstPtr& ignore) const;
+        std::vector<const btCollisionObject*> getTargetCollisionObjects(const std::vector<MWWorld::Ptr>& targets) const;
+
         std::unique_ptr<btBroadphaseInterface> mBroadphase;
         std::unique_ptr<btDefaultCollisionConfiguration> mCollisionConfiguration;
         std::unique_ptr<btCollisionDispatcher> mDispatcher;
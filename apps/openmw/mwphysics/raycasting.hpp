@@ -1,6 +1,8 @@
 #ifndef OPENMW_MWPHYSICS_RAYCASTING_H
 #define OPENMW_MWPHYSICS_RAYCASTING_H
 
+#include <functional>
+
 #include <osg/Vec3f>
 
 #include "../mwworld/ptr.hpp"
@@ -18,6 +20,8 @@ namespace MWPhysics
         MWWorld::Ptr mHitObject;
     };
 
+    using RayCastingCallback = std::function<void(const RayCastingResult&)>;
+
     class RayCastingInterface
     {
     public:
@@ -42,6 +46,17 @@ namespace MWPhysics
         virtual RayCastingResult castSphere(const osg::Vec3f& from, const osg::Vec3f& to, float radius,
             int mask = CollisionType_Default, int group = 0xff) const = 0;
 
+        /// Same as castRay, but the ray is cast by the physics threads after the next simulation step.
+        /// @param callback receives the result, called from the main thread by the next physics update.
+        virtual void asyncCastRay(RayCastingCallback callback, const osg::Vec3f& from, const osg::Vec3f& to,
+            const MWWorld::ConstPtr& ignore = MWWorld::ConstPtr(),
+            const std::vector<MWWorld::Ptr>& targets = std::vector<MWWorld::Ptr>(), int mask = CollisionType_Default,
+            int group = 0xff) const = 0;
+
+        /// Same as castSphere, but done the same way as asyncCastRay.
+        virtual void asyncCastSphere(RayCastingCallback callback, const osg::Vec3f& from, const osg::Vec3f& to,
+            float radius, int mask = CollisionType_Default, int group = 0xff) const = 0;
+
         /// Return true if actor1 can see actor2.
         virtual bool getLineOfSight(const MWWorld::ConstPtr& actor1, const MWWorld::ConstPtr& actor2) const = 0;
     };
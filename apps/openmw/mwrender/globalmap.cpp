@@ -123,7 +123,8 @@ namespace MWRender
     public:
         CreateMapWorkItem(int width, int height, int minX, int minY, int maxX, int maxY, int cellSize,
             const MWWorld::Store<ESM::Land>& landStore)
-            : mWidth(width)
+            : SceneUtil::WorkItem(SceneUtil::WorkItemCategory::Map)
+            , mWidth(width)
             , mHeight(height)
             , mMinX(minX)
             , mMinY(minY)
@@ -256,7 +257,8 @@ namespace MWRender
         std::vector<char> mImageData;
 
         explicit WritePng(osg::ref_ptr<const osg::Image> overlayImage)
-            : mOverlayImage(std::move(overlayImage))
+            : SceneUtil::WorkItem(SceneUtil::WorkItemCategory::Map)
+            , mOverlayImage(std::move(overlayImage))
         {
         }
 
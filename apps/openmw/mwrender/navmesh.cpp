@@ -58,7 +58,8 @@ namespace MWRender
             const osg::ref_ptr<osg::StateSet>& groupStateSet, const osg::ref_ptr<osg::StateSet>& debugDrawStateSet,
             const DetourNavigator::Settings& settings, const std::map<DetourNavigator::TilePosition, Tile>& tiles,
             NavMeshMode mode)
-            : mId(id)
+            : SceneUtil::WorkItem(SceneUtil::WorkItemCategory::Navigation)
+            , mId(id)
             , mVersion(version)
             , mNavMesh(navMesh)
             , mGroupStateSet(groupStateSet)
@@ -157,7 +158,8 @@ namespace MWRender
         osg::ref_ptr<NavMesh::CreateNavMeshTileGroups> mWorkItem;
 
         explicit DeallocateCreateNavMeshTileGroups(osg::ref_ptr<NavMesh::CreateNavMeshTileGroups>&& workItem)
-            : mWorkItem(std::move(workItem))
+            : SceneUtil::WorkItem(SceneUtil::WorkItemCategory::Navigation)
+            , mWorkItem(std::move(workItem))
         {
         }
     };
@@ -306,7 +306,8 @@ namespace MWRender
     {
     public:
         PreloadCommonAssetsWorkItem(Resource::ResourceSystem* resourceSystem)
-            : mResourceSystem(resourceSystem)
+            : SceneUtil::WorkItem(SceneUtil::WorkItemCategory::Cell)
+            , mResourceSystem(resourceSystem)
         {
         }
 
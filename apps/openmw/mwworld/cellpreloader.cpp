@@ -3,15 +3,20 @@
 #include <atomic>
 #include <limits>
 
+#include <osg/Stats>
+#include <osg/Vec2f>
+
 #include <components/debug/debuglog.hpp>
 #include <components/esm3/loadcell.hpp>
 #include <components/loadinglistener/reporter.hpp>
+#include <components/misc/constants.hpp>
 #include <components/misc/resourcehelpers.hpp>
 #include <components/misc/strings/lower.hpp>
 #include <components/resource/bulletshapemanager.hpp>
 #include <components/resource/keyframemanager.hpp>
 #include <components/resource/resourcesystem.hpp>
 #include <components/resource/scenemanager.hpp>
+#include <components/resource/sizeestimator.hpp>
 #include <components/terrain/view.hpp>
 #include <components/terrain/world.hpp>
 #include <components/vfs/manager.hpp>
@@ -43,6 +48,16 @@ namespace
         }
         return true;
     }
+
+    /// Cells closer to the player are preloaded first. Interior cells are only preloaded for nearby doors.
+    float getPreloadPriority(const MWWorld::CellStore& cell, const osg::Vec3f& referencePosition)
+    {
+        if (!cell.getCell()->isExterior())
+            return 0;
+        const osg::Vec2f center = osg::Vec2f(cell.getCell()->getGridX() + 0.5f, cell.getCell()->getGridY() + 0.5f)
+            * Constants::CellSizeInUnits;
+        return -(center - osg::Vec2f(referencePosition.x(), referencePosition.y())).length();
+    }
 }
 
 namespace MWWorld
@@ -75,7 +90,8 @@ namespace MWWorld
         PreloadItem(MWWorld::CellStore* cell, Resource::SceneManager* sceneManager,
             Resource::BulletShapeManager* bulletShapeManager, Resource::KeyframeManager* keyframeManager,
             Terrain::World* terrain, MWRender::LandManager* landManager, bool preloadInstances)
-            : mIsExterior(cell->getCell()->isExterior())
+            : SceneUtil::WorkItem(SceneUtil::WorkItemCategory::Cell)
+            , mIsExterior(cell->getCell()->isExterior())
             , mX(cell->getCell()->getGridX())
             , mY(cell->getCell()->getGridY())
             , mSceneManager(sceneManager)
@@ -85,6 +101,7 @@ namespace MWWorld
             , mLandManager(landManager)
             , mPreloadInstances(preloadInstances)
             , mAbort(false)
+            , mEstimatedSize(0)
         {
             mTerrainView = mTerrain->createView();
 
@@ -145,8 +162,18 @@ namespace MWWorld
                     // error will be shown when visiting the cell
                 }
             }
+
+            std::size_t estimatedSize = 0;
+            for (const osg::ref_ptr<const osg::Object>& object : mPreloadedObjects)
+                if (object != nullptr)
+                    estimatedSize
+                        += Resource::estimateNodeSize(*object) + Resource::estimateBulletShapeSize(*object);
+            mEstimatedSize = estimatedSize;
         }
 
+        /// Estimated memory used by the preloaded objects, to be called when the item is done.
+        std::size_t getEstimatedSize() const { return mEstimatedSize; }
+
     private:
         typedef std::vector<std::string> MeshList;
         bool mIsExterior;
@@ -161,6 +188,7 @@ namespace MWWorld
         bool mPreloadInstances;
 
         std::atomic<bool> mAbort;
+        std::size_t mEstimatedSize;
 
         osg::ref_ptr<Terrain::View> mTerrainView;
 
@@ -173,7 +201,8 @@ namespace MWWorld
     public:
         TerrainPreloadItem(const std::vector<osg::ref_ptr<Terrain::View>>& views, Terrain::World* world,
             const std::vector<CellPreloader::PositionCellGrid>& preloadPositions)
-            : mAbort(false)
+            : SceneUtil::WorkItem(SceneUtil::WorkItemCategory::Terrain)
+            , mAbort(false)
             , mTerrainViews(views)
             , mWorld(world)
             , mPreloadPositions(preloadPositions)
@@ -208,7 +237,8 @@ namespace MWWorld
     {
     public:
         UpdateCacheItem(Resource::ResourceSystem* resourceSystem, double referenceTime)
-            : mReferenceTime(referenceTime)
+            : SceneUtil::WorkItem(SceneUtil::WorkItemCategory::Cache)
+            , mReferenceTime(referenceTime)
             , mResourceSystem(resourceSystem)
         {
         }
@@ -230,7 +260,11 @@ namespace MWWorld
         , mMinCacheSize(0)
         , mMaxCacheSize(0)
         , mPreloadInstances(true)
+        , mMemoryBudget(0)
         , mLastResourceCacheUpdate(0.0)
+        , mHits(0)
+        , mLateHits(0)
+        , mMisses(0)
         , mLoadedTerrainTimestamp(0.0)
     {
     }
@@ -283,29 +317,19 @@ namespace MWWorld
         while (mPreloadCells.size() >= mMaxCacheSize)
         {
             // throw out oldest cell to make room
-            PreloadMap::iterator oldestCell = mPreloadCells.begin();
-            double oldestTimestamp = std::numeric_limits<double>::max();
-            double threshold = 1.0; // seconds
-            for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end(); ++it)
-            {
-                if (it->second.mTimeStamp < oldestTimestamp)
-                {
-                    oldestTimestamp = it->second.mTimeStamp;
-                    oldestCell = it;
-                }
-            }
+            if (!removeOldestCell(timestamp))
+                return;
+        }
 
-            if (oldestTimestamp + threshold < timestamp)
-            {
-                oldestCell->second.mWorkItem->abort();
-                mPreloadCells.erase(oldestCell);
-            }
-            else
+        while (mMemoryBudget != 0 && getMemoryUsage() >= mMemoryBudget)
+        {
+            if (!removeOldestCell(timestamp))
                 return;
         }
 
         osg::ref_ptr<PreloadItem> item(new PreloadItem(cell, mResourceSystem->getSceneManager(), mBulletShapeManager,
             mResourceSystem->getKeyframeManager(), mTerrain, mLandManager, mPreloadInstances));
+        item->setPriority(getPreloadPriority(*cell, mReferencePosition));
         mWorkQueue->addWorkItem(item);
 
         mPreloadCells[cell] = PreloadEntry(timestamp, item);
@@ -314,11 +338,18 @@ namespace MWWorld
     void CellPreloader::notifyLoaded(CellStore* cell)
     {
         PreloadMap::iterator found = mPreloadCells.find(cell);
-        if (found != mPreloadCells.end())
+        if (found == mPreloadCells.end())
+            ++mMisses;
+        else
         {
+            if (found->second.mWorkItem && found->second.mWorkItem->isDone())
+                ++mHits;
+            else
+                ++mLateHits;
+
             if (found->second.mWorkItem)
             {
-                found->second.mWorkItem->abort();
+                found->second.mWorkItem->cancel();
                 found->second.mWorkItem = nullptr;
             }
 
@@ -332,7 +363,7 @@ namespace MWWorld
         {
             if (it->second.mWorkItem)
             {
-                it->second.mWorkItem->abort();
+                it->second.mWorkItem->cancel();
                 it->second.mWorkItem = nullptr;
             }
 
@@ -348,7 +379,7 @@ namespace MWWorld
             {
                 if (it->second.mWorkItem)
                 {
-                    it->second.mWorkItem->abort();
+                    it->second.mWorkItem->cancel();
                     it->second.mWorkItem = nullptr;
                 }
                 mPreloadCells.erase(it++);
@@ -357,6 +388,10 @@ namespace MWWorld
                 ++it;
         }
 
+        while (mMemoryBudget != 0 && getMemoryUsage() > mMemoryBudget && removeOldestCell(timestamp))
+        {
+        }
+
         if (timestamp - mLastResourceCacheUpdate > 1.0 && (!mUpdateCacheItem || mUpdateCacheItem->isDone()))
         {
             // the resource cache is cleared from the worker thread so that we're not holding up the main thread with
@@ -373,6 +408,14 @@ namespace MWWorld
         }
     }
 
+    void CellPreloader::setReferencePosition(const osg::Vec3f& position)
+    {
+        mReferencePosition = position;
+        for (const auto& [cell, entry] : mPreloadCells)
+            if (entry.mWorkItem && !entry.mWorkItem->isDone())
+                entry.mWorkItem->setPriority(getPreloadPriority(*cell, position));
+    }
+
     void CellPreloader::setExpiryDelay(double expiryDelay)
     {
         mExpiryDelay = expiryDelay;
@@ -393,11 +436,60 @@ namespace MWWorld
         mPreloadInstances = preload;
     }
 
+    void CellPreloader::setMemoryBudget(std::size_t bytes)
+    {
+        mMemoryBudget = bytes;
+    }
+
     unsigned int CellPreloader::getMaxCacheSize() const
     {
         return mMaxCacheSize;
     }
 
+    void CellPreloader::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "CellPreloader Count", mPreloadCells.size());
+        stats.setAttribute(frameNumber, "CellPreloader MB", Resource::toMegabytes(getMemoryUsage()));
+        stats.setAttribute(frameNumber, "CellPreloader Hits", mHits);
+        stats.setAttribute(frameNumber, "CellPreloader LateHits", mLateHits);
+        stats.setAttribute(frameNumber, "CellPreloader Misses", mMisses);
+        const std::size_t total = mHits + mLateHits + mMisses;
+        if (total > 0)
+            stats.setAttribute(frameNumber, "CellPreloader HitRate", static_cast<double>(mHits) / total);
+    }
+
+    bool CellPreloader::removeOldestCell(double timestamp)
+    {
+        PreloadMap::iterator oldestCell = mPreloadCells.begin();
+        double oldestTimestamp = std::numeric_limits<double>::max();
+        double threshold = 1.0; // seconds
+        for (PreloadMap::iterator it = mPreloadCells.begin(); it != mPreloadCells.end(); ++it)
+        {
+            if (it->second.mTimeStamp < oldestTimestamp)
+            {
+                oldestTimestamp = it->second.mTimeStamp;
+                oldestCell = it;
+            }
+        }
+
+        if (oldestTimestamp + threshold >= timestamp)
+            return false;
+
+        if (oldestCell->second.mWorkItem)
+            oldestCell->second.mWorkItem->cancel();
+        mPreloadCells.erase(oldestCell);
+        return true;
+    }
+
+    std::size_t CellPreloader::getMemoryUsage() const
+    {
+        std::size_t result = 0;
+        for (const auto& [cell, entry] : mPreloadCells)
+            if (entry.mWorkItem && entry.mWorkItem->isDone())
+                result += static_cast<const PreloadItem&>(*entry.mWorkItem).getEstimatedSize();
+        return result;
+    }
+
     void CellPreloader::setWorkQueue(osg::ref_ptr<SceneUtil::WorkQueue> workQueue)
     {
         mWorkQueue = workQueue;
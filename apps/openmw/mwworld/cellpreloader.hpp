@@ -2,6 +2,7 @@
 #define OPENMW_MWWORLD_CELLPRELOADER_H
 
 #include <components/sceneutil/workqueue.hpp>
+#include <cstddef>
 #include <map>
 #include <osg/Vec3f>
 #include <osg/Vec4i>
@@ -29,6 +30,11 @@ namespace Loading
     class Listener;
 }
 
+namespace osg
+{
+    class Stats;
+}
+
 namespace MWWorld
 {
     class CellStore;
@@ -45,6 +51,8 @@ namespace MWWorld
         /// @note The cell itself must be in State_Loaded or State_Preloaded.
         void preload(MWWorld::CellStore* cell, double timestamp);
 
+        /// Counts a hit when the cell has finished preloading, a late hit when it's still being preloaded and a miss
+        /// otherwise.
         void notifyLoaded(MWWorld::CellStore* cell);
 
         void clear();
@@ -52,6 +60,9 @@ namespace MWWorld
         /// Removes preloaded cells that have not had a preload request for a while.
         void updateCache(double timestamp);
 
+        /// Preloading of cells closer to this position is started first.
+        void setReferencePosition(const osg::Vec3f& position);
+
         /// How long to keep a preloaded cell in cache after it's no longer requested.
         void setExpiryDelay(double expiryDelay);
 
@@ -64,8 +75,14 @@ namespace MWWorld
         /// Enables the creation of instances in the preloading thread.
         void setPreloadInstances(bool preload);
 
+        /// The estimated memory in bytes used by the preloaded cells before unused cells get thrown out, 0 for no
+        /// limit. Resources shared between cells are accounted for each of them.
+        void setMemoryBudget(std::size_t bytes);
+
         unsigned int getMaxCacheSize() const;
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
         void setWorkQueue(osg::ref_ptr<SceneUtil::WorkQueue> workQueue);
 
         typedef std::pair<osg::Vec3f, osg::Vec4i> PositionCellGrid;
@@ -86,8 +103,14 @@ namespace MWWorld
         unsigned int mMinCacheSize;
         unsigned int mMaxCacheSize;
         bool mPreloadInstances;
+        std::size_t mMemoryBudget;
 
         double mLastResourceCacheUpdate;
+        osg::Vec3f mReferencePosition;
+
+        std::size_t mHits;
+        std::size_t mLateHits;
+        std::size_t mMisses;
 
         struct PreloadEntry
         {
@@ -109,6 +132,11 @@ namespace MWWorld
         // Cells that are currently being preloaded, or have already finished preloading
         PreloadMap mPreloadCells;
 
+        /// Throw out the cell with the oldest preload request unless it was requested less than a second ago.
+        bool removeOldestCell(double timestamp);
+
+        std::size_t getMemoryUsage() const;
+
         std::vector<osg::ref_ptr<Terrain::View>> mTerrainViews;
         std::vector<PositionCellGrid> mTerrainPreloadPositions;
         osg::ref_ptr<TerrainPreloadItem> mTerrainPreloadItem;
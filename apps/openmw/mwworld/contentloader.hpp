@@ -15,6 +15,9 @@ namespace MWWorld
     {
         virtual ~ContentLoader() = default;
 
+        /// Start reading the file in background ahead of the load() call. Files are prepared in the load order.
+        virtual void prepare(const std::filesystem::path& filepath, int index) {}
+
         virtual void load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener) = 0;
     };
 
@@ -9,23 +9,87 @@
 #include <components/esm4/reader.hpp>
 #include <components/files/conversion.hpp>
 #include <components/files/openfile.hpp>
+#include <components/to_utf8/to_utf8.hpp>
 
 namespace MWWorld
 {
 
     EsmLoader::EsmLoader(MWWorld::ESMStore& store, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
-        std::vector<int>& esmVersions)
+        std::vector<int>& esmVersions, Misc::JobSystem* jobSystem)
         : mReaders(readers)
         , mStore(store)
         , mEncoder(encoder)
         , mDialogue(nullptr) // A content file containing INFO records without a DIAL record appends them to the
                              // previous file's dialogue
         , mESMVersions(esmVersions)
+        , mJobSystem(jobSystem != nullptr && jobSystem->getThreadsCount() > 0 ? jobSystem : nullptr)
+        , mJobSubsystem(mJobSystem != nullptr ? mJobSystem->registerSubsystem("Content") : 0)
+        , mMaxStagingFiles(mJobSystem != nullptr ? 2 * mJobSystem->getThreadsCount() : 0)
     {
     }
 
+    EsmLoader::~EsmLoader()
+    {
+        // Jobs refer to the store
+        for (auto& [index, file] : mStagingFiles)
+        {
+            try
+            {
+                file.mJob.wait();
+            }
+            catch (const std::exception&)
+            {
+                // The error is reported when the file is loaded
+            }
+        }
+    }
+
+    void EsmLoader::prepare(const std::filesystem::path& filepath, int index)
+    {
+        if (mJobSystem == nullptr)
+            return;
+        mPreparedFiles.push_back(PreparedFile{ filepath, index });
+        startStaging();
+    }
+
+    void EsmLoader::startStaging()
+    {
+        while (!mPreparedFiles.empty() && mStagingFiles.size() < mMaxStagingFiles)
+        {
+            const PreparedFile file = std::move(mPreparedFiles.front());
+            mPreparedFiles.pop_front();
+            // Utf8Encoder keeps a buffer, so each job needs its own one
+            std::optional<ToUTF8::Utf8Encoder> encoder;
+            if (mEncoder != nullptr)
+                encoder.emplace(*mEncoder);
+            auto result = std::make_shared<std::unique_ptr<StagedContentFile>>();
+            Misc::JobHandle job = mJobSystem->submit(
+                mJobSubsystem, [&store = mStore, file, encoder = std::move(encoder), result]() mutable {
+                    auto stream = Files::openBinaryInputFileStream(file.mPath);
+                    if (ESM::readFormat(*stream) != ESM::Format::Tes3)
+                        return;
+                    stream->seekg(0);
+                    ESM::ESMReader reader;
+                    reader.setEncoder(encoder.has_value() ? &*encoder : nullptr);
+                    reader.setIndex(file.mIndex);
+                    reader.open(std::move(stream), file.mPath);
+                    *result = store.readStaged(reader);
+                });
+            mStagingFiles.emplace(file.mIndex, StagingFile{ std::move(job), std::move(result) });
+        }
+    }
+
     void EsmLoader::load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener)
     {
+        std::unique_ptr<StagedContentFile> staged;
+        if (const auto it = mStagingFiles.find(index); it != mStagingFiles.end())
+        {
+            const StagingFile file = std::move(it->second);
+            mStagingFiles.erase(it);
+            startStaging();
+            file.mJob.wait();
+            staged = std::move(*file.mResult);
+        }
 
         auto stream = Files::openBinaryInputFileStream(filepath);
         const ESM::Format format = ESM::readFormat(*stream);
@@ -50,7 +114,7 @@ namespace MWWorld
                   "Please run the launcher to fix this issue.");
 
                 mESMVersions[index] = reader->getVer();
-                mStore.load(*reader, listener, mDialogue);
+                mStore.load(*reader, listener, mDialogue, staged.get());
 
                 if (!mMasterFileFormat.has_value()
                     && (Misc::StringUtils::ciEndsWith(reader->getName().u8string(), u8".esm")
@@ -1,9 +1,14 @@
 #ifndef ESMLOADER_HPP
 #define ESMLOADER_HPP
 
+#include <deque>
+#include <map>
+#include <memory>
 #include <optional>
 #include <vector>
 
+#include <components/misc/jobsystem.hpp>
+
 #include "contentloader.hpp"
 
 namespace ToUTF8
@@ -21,23 +26,51 @@ namespace MWWorld
 {
 
     class ESMStore;
+    struct StagedContentFile;
 
+    /// @par With a job system the records not depending on the store state are read from the prepared files in
+    /// parallel, a few files ahead of the one being loaded. Loading still adds the records to the store in the load
+    /// order.
     struct EsmLoader : public ContentLoader
     {
         explicit EsmLoader(MWWorld::ESMStore& store, ESM::ReadersCache& readers, ToUTF8::Utf8Encoder* encoder,
-            std::vector<int>& esmVersions);
+            std::vector<int>& esmVersions, Misc::JobSystem* jobSystem = nullptr);
+
+        ~EsmLoader();
 
         std::optional<int> getMasterFileFormat() const { return mMasterFileFormat; }
 
+        void prepare(const std::filesystem::path& filepath, int index) override;
+
         void load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener) override;
 
     private:
+        struct PreparedFile
+        {
+            std::filesystem::path mPath;
+            int mIndex;
+        };
+
+        struct StagingFile
+        {
+            Misc::JobHandle mJob;
+            std::shared_ptr<std::unique_ptr<StagedContentFile>> mResult;
+        };
+
         ESM::ReadersCache& mReaders;
         MWWorld::ESMStore& mStore;
         ToUTF8::Utf8Encoder* mEncoder;
         ESM::Dialogue* mDialogue;
         std::optional<int> mMasterFileFormat;
         std::vector<int>& mESMVersions;
+        Misc::JobSystem* mJobSystem;
+        Misc::JobSubsystem mJobSubsystem;
+        // Limits the memory used by the staged records
+        std::size_t mMaxStagingFiles;
+        std::deque<PreparedFile> mPreparedFiles;
+        std::map<int, StagingFile> mStagingFiles;
+
+        void startStaging();
     };
 
 } /* namespace MWWorld */
@@ -253,6 +253,12 @@ namespace MWWorld
         movePlayerRecord();
     }
 
+    void ESMStore::setLazyLoading(bool value)
+    {
+        for (const auto& store : mDynamicStores)
+            store->setLazyLoading(value);
+    }
+
     static bool isCacheableRecord(int id)
     {
         switch (id)
@@ -284,7 +290,35 @@ namespace MWWorld
         return false;
     }
 
-    void ESMStore::load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue)
+    std::unique_ptr<StagedContentFile> ESMStore::readStaged(ESM::ESMReader& esm) const
+    {
+        auto result = std::make_unique<StagedContentFile>();
+        for (const auto& [recName, store] : mStoreImp->mRecNameToStore)
+            if (std::unique_ptr<StagedRecords> records = store->makeStagedRecords())
+                result->mRecords.emplace(recName, std::move(records));
+
+        while (esm.hasMoreRecs())
+        {
+            ESM::NAME n = esm.getRecName();
+            esm.getRecHeader();
+            if (esm.getRecordFlags() & ESM::FLAG_Ignored)
+            {
+                esm.skipRecord();
+                continue;
+            }
+
+            const auto it = result->mRecords.find(static_cast<ESM::RecNameInts>(n.toInt()));
+            if (it == result->mRecords.end())
+                esm.skipRecord();
+            else
+                result->mIsDeleted.push_back(it->second->load(esm));
+        }
+
+        return result;
+    }
+
+    void ESMStore::load(
+        ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue, StagedContentFile* staged)
     {
         if (listener != nullptr)
             listener->setProgressRange(::EsmLoader::fileProgress);
@@ -294,6 +328,12 @@ namespace MWWorld
         // indices are being passed to the LandTexture Store retrieval methods.
         getWritable<ESM::LandTexture>().resize(esm.getIndex() + 1);
 
+        // Staged records go to other stores than the ones loaded below, so the order between them doesn't matter
+        if (staged != nullptr)
+            for (const auto& [recName, records] : staged->mRecords)
+                mStoreImp->mRecNameToStore.at(recName)->loadStaged(*records);
+        std::size_t stagedIndex = 0;
+
         // Loop through all records
         while (esm.hasMoreRecs())
         {
@@ -309,7 +349,14 @@ namespace MWWorld
             ESM::RecNameInts recName = static_cast<ESM::RecNameInts>(n.toInt());
             const auto& it = mStoreImp->mRecNameToStore.find(recName);
 
-            if (it == mStoreImp->mRecNameToStore.end())
+            if (staged != nullptr && staged->mRecords.contains(recName))
+            {
+                esm.skipRecord();
+                // Keep the dialogue for the following info records the same way as when loading the record here
+                if (!staged->mIsDeleted.at(stagedIndex++))
+                    dialogue = nullptr;
+            }
+            else if (it == mStoreImp->mRecNameToStore.end())
             {
                 if (recName == ESM::REC_INFO)
                 {
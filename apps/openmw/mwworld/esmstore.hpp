@@ -2,6 +2,7 @@
 #define OPENMW_MWWORLD_ESMSTORE_H
 
 #include <filesystem>
+#include <map>
 #include <memory>
 #include <stdexcept>
 #include <tuple>
@@ -83,6 +84,15 @@ namespace MWWorld
 {
     struct ESMStoreImp;
 
+    /// Records of a content file read by ESMStore::readStaged() ahead of loading the file.
+    struct StagedContentFile
+    {
+        // Buffers for each record type which can be read independently from the store state
+        std::map<ESM::RecNameInts, std::unique_ptr<StagedRecords>> mRecords;
+        // Whether each staged record is deleted in the order of the file
+        std::vector<bool> mIsDeleted;
+    };
+
     class ESMStore
     {
         friend struct ESMStoreImp; // This allows StoreImp to extend esmstore without beeing included everywhere
@@ -167,12 +177,22 @@ namespace MWWorld
 
         void clearDynamic();
 
+        /// See DynamicStore::setLazyLoading(). Must be set before loading content files to take effect.
+        void setLazyLoading(bool value);
+
         void movePlayerRecord();
 
         /// Validate entries in store after loading a save
         void validateDynamic();
 
-        void load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue);
+        /// Read the records which don't depend on the store state. Can be called from any thread in parallel with
+        /// other calls of this function and load(). The reader doesn't need the parent file indices to be resolved.
+        std::unique_ptr<StagedContentFile> readStaged(ESM::ESMReader& esm) const;
+
+        /// @param staged records of the same content file read by readStaged(), the rest is read from the file.
+        /// Content files must be loaded in the load order either way.
+        void load(ESM::ESMReader& esm, Loading::Listener* listener, ESM::Dialogue*& dialogue,
+            StagedContentFile* staged = nullptr);
         void loadESM4(ESM4::Reader& esm);
 
         template <class T>
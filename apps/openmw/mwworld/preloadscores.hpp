@@ -0,0 +1,77 @@
+#ifndef OPENMW_MWWORLD_PRELOADSCORES_H
+#define OPENMW_MWWORLD_PRELOADSCORES_H
+
+#include "cellutils.hpp"
+
+#include <osg/Vec2i>
+#include <osg/Vec3f>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace MWWorld
+{
+    /// Collects candidates for preloading with the chance of being visited soon. A candidate added multiple times
+    /// keeps the highest score.
+    template <class Key>
+    class PreloadScores
+    {
+    public:
+        void add(const Key& key, float score)
+        {
+            const auto [it, inserted] = mScores.emplace(key, score);
+            if (!inserted)
+                it->second = std::max(it->second, score);
+        }
+
+        /// Return up to count keys with the highest score, ties are resolved by the key order.
+        std::vector<Key> getBest(std::size_t count) const
+        {
+            std::vector<std::pair<Key, float>> sorted(mScores.begin(), mScores.end());
+            std::stable_sort(sorted.begin(), sorted.end(),
+                [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+            std::vector<Key> result;
+            result.reserve(std::min(count, sorted.size()));
+            for (std::size_t i = 0; i < sorted.size() && i < count; ++i)
+                result.push_back(sorted[i].first);
+            return result;
+        }
+
+        const std::map<Key, float>& getScores() const { return mScores; }
+
+        std::size_t size() const { return mScores.size(); }
+
+        bool empty() const { return mScores.empty(); }
+
+        void clear() { mScores.clear(); }
+
+    private:
+        std::map<Key, float> mScores;
+    };
+
+    /// Score exterior cells along the trajectory of a position moving with constant velocity for horizon seconds.
+    /// Each sampled cell and its neighbours within the radius get weight / (1 + t), where t is the time to reach it.
+    inline void addTrajectoryScores(const osg::Vec3f& position, const osg::Vec3f& velocity, float horizon,
+        int samples, int radius, float weight, PreloadScores<osg::Vec2i>& scores)
+    {
+        for (int i = 0; i <= samples; ++i)
+        {
+            const float time = samples == 0 ? 0 : horizon * static_cast<float>(i) / static_cast<float>(samples);
+            const osg::Vec3f sample = position + velocity * time;
+            const osg::Vec2i cell = positionToCellIndex(sample.x(), sample.y());
+            const float score = weight / (1 + time);
+            for (int dx = -radius; dx <= radius; ++dx)
+                for (int dy = -radius; dy <= radius; ++dy)
+                {
+                    const int distance = std::max(std::abs(dx), std::abs(dy));
+                    scores.add(osg::Vec2i(cell.x() + dx, cell.y() + dy), score / (1 + distance));
+                }
+        }
+    }
+}
+
+#endif
@@ -1,11 +1,16 @@
 #include "scene.hpp"
 
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <limits>
+#include <map>
+#include <utility>
 
 #include <BulletCollision/CollisionDispatch/btCollisionObject.h>
 
+#include <osg/Stats>
+
 #include <components/debug/debuglog.hpp>
 #include <components/detournavigator/agentbounds.hpp>
 #include <components/detournavigator/heightfieldshape.hpp>
@@ -44,12 +49,22 @@
 #include "esmstore.hpp"
 #include "localscripts.hpp"
 #include "player.hpp"
+#include "preloadscores.hpp"
 #include "worldimp.hpp"
 
 namespace
 {
     using MWWorld::RotationOrder;
 
+    constexpr std::size_t maxRecentInteriors = 8;
+
+    // Weights of the predictive preloading sources. Cells along the trajectory score up to 1, nearby doors are
+    // likely to be used, travel requires a dialogue and recent interiors are only a guess.
+    constexpr float trajectoryWeight = 1;
+    constexpr float doorWeight = 1.5f;
+    constexpr float travelWeight = 0.5f;
+    constexpr float recentInteriorWeight = 0.25f;
+
     osg::Quat makeActorOsgQuat(const ESM::Position& position)
     {
         return osg::Quat(position.rot[2], osg::Vec3(0, 0, -1));
@@ -259,6 +274,16 @@ namespace
         return false;
     }
 
+    // Objects closer to an actor or the player are inserted with the cell to give actors collision around them
+    constexpr float immediateInsertionDistance = 1024;
+
+    bool isNearAny(const osg::Vec3f& position, const std::vector<osg::Vec3f>& positions)
+    {
+        return std::any_of(positions.begin(), positions.end(), [&](const osg::Vec3f& v) {
+            return (v - position).length2() < immediateInsertionDistance * immediateInsertionDistance;
+        });
+    }
+
     bool removeFromSorted(const ESM::RefNum& refNum, std::vector<ESM::RefNum>& pagedRefs)
     {
         const auto it = std::lower_bound(pagedRefs.begin(), pagedRefs.end(), refNum);
@@ -307,9 +332,12 @@ namespace MWWorld
         if (mChangeCellGridRequest.has_value())
         {
             changeCellGrid(mChangeCellGridRequest->mPosition, mChangeCellGridRequest->mCell.x(),
-                mChangeCellGridRequest->mCell.y(), mChangeCellGridRequest->mChangeEvent);
+                mChangeCellGridRequest->mCell.y(), mChangeCellGridRequest->mChangeEvent,
+                mIncrementalLoadingBudget > 0);
             mChangeCellGridRequest.reset();
         }
+        else
+            insertPendingObjects();
 
         mPreloader->updateCache(mRendering.getReferenceTime());
         preloadCells(duration);
@@ -322,6 +350,10 @@ namespace MWWorld
 
         Log(Debug::Info) << "Unloading cell " << cell->getCell()->getDescription();
 
+        mPendingInsertions.erase(std::remove_if(mPendingInsertions.begin(), mPendingInsertions.end(),
+                                     [&](const PendingInsertion& v) { return v.mCell == cell; }),
+            mPendingInsertions.end());
+
         ListAndResetObjectsVisitor visitor;
 
         cell->forEach(visitor);
@@ -375,7 +407,7 @@ namespace MWWorld
     }
 
     void Scene::loadCell(CellStore* cell, Loading::Listener* loadingListener, bool respawn, const osg::Vec3f& position,
-        const DetourNavigator::UpdateGuard* navigatorUpdateGuard)
+        const DetourNavigator::UpdateGuard* navigatorUpdateGuard, bool incremental)
     {
         using DetourNavigator::HeightfieldShape;
 
@@ -439,7 +471,7 @@ namespace MWWorld
         if (respawn)
             cell->respawn();
 
-        insertCell(*cell, loadingListener, navigatorUpdateGuard);
+        insertCell(*cell, loadingListener, navigatorUpdateGuard, incremental);
 
         mRendering.addCell(cell);
 
@@ -486,6 +518,7 @@ namespace MWWorld
         mCurrentCell = nullptr;
 
         mPreloader->clear();
+        mRecentInteriors.clear();
     }
 
     osg::Vec4i Scene::gridCenterToBounds(const osg::Vec2i& centerCell) const
@@ -524,7 +557,8 @@ namespace MWWorld
         mChangeCellGridRequest = ChangeCellGridRequest{ position, cell, changeEvent };
     }
 
-    void Scene::changeCellGrid(const osg::Vec3f& pos, int playerCellX, int playerCellY, bool changeEvent)
+    void Scene::changeCellGrid(
+        const osg::Vec3f& pos, int playerCellX, int playerCellY, bool changeEvent, bool incremental)
     {
         auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
 
@@ -603,10 +637,19 @@ namespace MWWorld
             if (!isCellInCollection(x, y, mActiveCells))
             {
                 CellStore* cell = mWorld.getWorldModel().getExterior(x, y);
-                loadCell(cell, loadingListener, changeEvent, pos, navigatorUpdateGuard.get());
+                loadCell(cell, loadingListener, changeEvent, pos, navigatorUpdateGuard.get(), incremental);
             }
         }
 
+        if (incremental)
+        {
+            for (PendingInsertion& v : mPendingInsertions)
+                v.mDistance = (v.mPtr.getRefData().getPosition().asVec3() - pos).length();
+            std::sort(mPendingInsertions.begin(), mPendingInsertions.end(),
+                [](const PendingInsertion& l, const PendingInsertion& r) { return l.mDistance > r.mDistance; });
+            insertPendingObjectsNearActors(pos, navigatorUpdateGuard.get());
+        }
+
         mNavigator.update(pos, navigatorUpdateGuard.get());
 
         navigatorUpdateGuard.reset();
@@ -807,7 +850,11 @@ namespace MWWorld
         , mPreloadExteriorGrid(Settings::Manager::getBool("preload exterior grid", "Cells"))
         , mPreloadDoors(Settings::Manager::getBool("preload doors", "Cells"))
         , mPreloadFastTravel(Settings::Manager::getBool("preload fast travel", "Cells"))
+        , mPreloadPredictive(Settings::Manager::getBool("preload predictive", "Cells"))
+        , mPreloadPredictiveCount(
+              static_cast<unsigned int>(std::max(0, Settings::Manager::getInt("preload predictive count", "Cells"))))
         , mPredictionTime(Settings::Manager::getFloat("prediction time", "Cells"))
+        , mIncrementalLoadingBudget(Settings::Manager::getFloat("incremental loading budget", "Cells"))
     {
         mPreloader = std::make_unique<CellPreloader>(rendering.getResourceSystem(), physics->getShapeManager(),
             rendering.getTerrain(), rendering.getLandManager());
@@ -819,6 +866,9 @@ namespace MWWorld
         mPreloader->setMinCacheSize(Settings::Manager::getInt("preload cell cache min", "Cells"));
         mPreloader->setMaxCacheSize(Settings::Manager::getInt("preload cell cache max", "Cells"));
         mPreloader->setPreloadInstances(Settings::Manager::getBool("preload instances", "Cells"));
+        mPreloader->setMemoryBudget(
+            static_cast<std::size_t>(std::max(0, Settings::Manager::getInt("preload cell memory budget", "Cells")))
+            * 1024 * 1024);
     }
 
     Scene::~Scene()
@@ -887,6 +937,12 @@ namespace MWWorld
 
         navigatorUpdateGuard.reset();
 
+        mRecentInteriors.erase(
+            std::remove(mRecentInteriors.begin(), mRecentInteriors.end(), cellName), mRecentInteriors.end());
+        mRecentInteriors.push_front(cellName);
+        if (mRecentInteriors.size() > maxRecentInteriors)
+            mRecentInteriors.pop_back();
+
         changePlayerCell(cell, position, adjustPlayerPos);
 
         // adjust fog
@@ -937,17 +993,88 @@ namespace MWWorld
         mCellChanged = false;
     }
 
-    void Scene::insertCell(
-        CellStore& cell, Loading::Listener* loadingListener, const DetourNavigator::UpdateGuard* navigatorUpdateGuard)
+    void Scene::insertCell(CellStore& cell, Loading::Listener* loadingListener,
+        const DetourNavigator::UpdateGuard* navigatorUpdateGuard, bool incremental)
     {
         InsertVisitor insertVisitor(cell, loadingListener);
         cell.forEach(insertVisitor);
+        if (incremental)
+        {
+            // Actors and scripted objects are always inserted, objects near actors are inserted by
+            // insertPendingObjectsNearActors once all cells are loaded
+            const auto deferred = std::stable_partition(
+                insertVisitor.mToInsert.begin(), insertVisitor.mToInsert.end(), [](const MWWorld::Ptr& ptr) {
+                    return ptr.getClass().isActor() || !ptr.getClass().getScript(ptr).empty();
+                });
+            for (auto it = deferred; it != insertVisitor.mToInsert.end(); ++it)
+                mPendingInsertions.push_back(PendingInsertion{ *it, &cell, 0 });
+            if (loadingListener != nullptr)
+                loadingListener->increaseProgress(
+                    static_cast<std::size_t>(insertVisitor.mToInsert.end() - deferred));
+            insertVisitor.mToInsert.erase(deferred, insertVisitor.mToInsert.end());
+        }
         insertVisitor.insert(
             [&](const MWWorld::Ptr& ptr) { addObject(ptr, mWorld, mPagedRefs, *mPhysics, mRendering); });
         insertVisitor.insert(
             [&](const MWWorld::Ptr& ptr) { addObject(ptr, mWorld, *mPhysics, mNavigator, navigatorUpdateGuard); });
     }
 
+    void Scene::insertPendingObject(const Ptr& ptr, const DetourNavigator::UpdateGuard* navigatorUpdateGuard)
+    {
+        // Could be changed by scripts since the cell is loaded
+        if (ptr.getRefData().isDeleted() || !ptr.getRefData().isEnabled() || ptr.getRefData().getBaseNode())
+            return;
+
+        try
+        {
+            addObject(ptr, mWorld, mPagedRefs, *mPhysics, mRendering);
+            addObject(ptr, mWorld, *mPhysics, mNavigator, navigatorUpdateGuard);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Error) << "failed to render '" << ptr.getCellRef().getRefId() << "': " << e.what();
+        }
+    }
+
+    void Scene::insertPendingObjectsNearActors(
+        const osg::Vec3f& playerPosition, const DetourNavigator::UpdateGuard* navigatorUpdateGuard)
+    {
+        std::vector<osg::Vec3f> actorPositions{ playerPosition };
+        for (CellStore* cell : mActiveCells)
+            cell->forEachConst([&](const ConstPtr& ptr) {
+                if (ptr.getClass().isActor() && !ptr.getRefData().isDeleted() && ptr.getRefData().isEnabled())
+                    actorPositions.push_back(ptr.getRefData().getPosition().asVec3());
+                return true;
+            });
+
+        const auto isFar = [&](const PendingInsertion& v) {
+            return !isNearAny(v.mPtr.getRefData().getPosition().asVec3(), actorPositions);
+        };
+        const auto nearActors = std::stable_partition(mPendingInsertions.begin(), mPendingInsertions.end(), isFar);
+        for (auto it = nearActors; it != mPendingInsertions.end(); ++it)
+            insertPendingObject(it->mPtr, navigatorUpdateGuard);
+        mPendingInsertions.erase(nearActors, mPendingInsertions.end());
+    }
+
+    void Scene::insertPendingObjects()
+    {
+        if (mPendingInsertions.empty())
+            return;
+
+        const auto start = std::chrono::steady_clock::now();
+        const std::chrono::duration<float, std::milli> budget(mIncrementalLoadingBudget);
+        const auto navigatorUpdateGuard = mNavigator.makeUpdateGuard();
+
+        while (!mPendingInsertions.empty())
+        {
+            const Ptr ptr = mPendingInsertions.back().mPtr;
+            mPendingInsertions.pop_back();
+            insertPendingObject(ptr, navigatorUpdateGuard.get());
+            if (std::chrono::steady_clock::now() - start >= budget)
+                break;
+        }
+    }
+
     void Scene::addObjectToScene(const Ptr& ptr)
     {
         try
@@ -1014,7 +1141,8 @@ namespace MWWorld
     {
     public:
         PreloadMeshItem(const std::string& mesh, Resource::SceneManager* sceneManager)
-            : mMesh(mesh)
+            : SceneUtil::WorkItem(SceneUtil::WorkItemCategory::Cell)
+            , mMesh(mesh)
             , mSceneManager(sceneManager)
         {
         }
@@ -1074,8 +1202,11 @@ namespace MWWorld
                 predictedPos, gridCenterToBounds(getNewGridCenter(predictedPos, &mCurrentGridCenter)));
 
         mLastPlayerPos = playerPos;
+        mPreloader->setReferencePosition(predictedPos);
 
-        if (mPreloadEnabled)
+        if (mPreloadEnabled && mPreloadPredictive)
+            preloadPredictedCells(playerPos, moved / dt, exteriorPositions);
+        else if (mPreloadEnabled)
         {
             if (mPreloadDoors)
                 preloadTeleportDoorDestinations(playerPos, predictedPos, exteriorPositions);
@@ -1275,4 +1406,123 @@ namespace MWWorld
             }
         }
     }
+
+    void Scene::preloadPredictedCells(
+        const osg::Vec3f& playerPos, const osg::Vec3f& velocity, std::vector<PositionCellGrid>& exteriorPositions)
+    {
+        WorldModel& worldModel = mWorld.getWorldModel();
+        // Interiors are keyed by name and exteriors by grid index rather than by CellStore address, so ties are
+        // resolved the same way in every run
+        using CellKey = std::pair<ESM::RefId, osg::Vec2i>;
+        PreloadScores<CellKey> scores;
+        // Positions to preload terrain at when an exterior cell is chosen because of a door or a travel service
+        std::map<osg::Vec2i, osg::Vec3f> destinations;
+
+        const auto addInterior = [&](const ESM::RefId& name, float score) {
+            try
+            {
+                CellStore* cell = worldModel.getInterior(name);
+                if (cell != mCurrentCell)
+                    scores.add(CellKey(name, osg::Vec2i()), score);
+            }
+            catch (std::exception&)
+            {
+                // ignore error for now, would spam the log too much
+            }
+        };
+
+        const auto addExterior = [&](const osg::Vec3f& pos, float score) {
+            const osg::Vec2i cellIndex = positionToCellIndex(pos.x(), pos.y());
+            scores.add(CellKey(ESM::RefId(), cellIndex), score);
+            destinations.emplace(cellIndex, pos);
+            for (int dx = -1; dx <= 1; ++dx)
+                for (int dy = -1; dy <= 1; ++dy)
+                    if (dx != 0 || dy != 0)
+                        scores.add(
+                            CellKey(ESM::RefId(), osg::Vec2i(cellIndex.x() + dx, cellIndex.y() + dy)), score / 2);
+        };
+
+        if (mPreloadExteriorGrid && mCurrentCell->isExterior())
+        {
+            PreloadScores<osg::Vec2i> trajectory;
+            addTrajectoryScores(
+                playerPos, velocity, mPredictionTime, 4, mHalfGridSize + 1, trajectoryWeight, trajectory);
+            for (const auto& [cellIndex, score] : trajectory.getScores())
+            {
+                // The active grid is already loaded
+                if (std::abs(cellIndex.x() - mCurrentGridCenter.x()) <= mHalfGridSize
+                    && std::abs(cellIndex.y() - mCurrentGridCenter.y()) <= mHalfGridSize)
+                    continue;
+                scores.add(CellKey(ESM::RefId(), cellIndex), score);
+            }
+        }
+
+        if (mPreloadDoors)
+        {
+            for (const CellStore* cellStore : mActiveCells)
+            {
+                for (const auto& door : cellStore->getReadOnlyDoors().mList)
+                {
+                    if (!door.mRef.getTeleport())
+                        continue;
+                    // Doors the player is heading to are more likely to be used
+                    const osg::Vec3f doorPos = door.mData.getPosition().asVec3();
+                    const float distance = std::min((playerPos - doorPos).length(),
+                        (playerPos + velocity * mPredictionTime - doorPos).length());
+                    if (distance >= mPreloadDistance)
+                        continue;
+                    const float score = doorWeight * (1 - distance / mPreloadDistance);
+                    if (!door.mRef.getDestCell().empty())
+                        addInterior(door.mRef.getDestCell(), score);
+                    else
+                        addExterior(door.mRef.getDoorDest().asVec3(), score);
+                }
+            }
+        }
+
+        if (mPreloadFastTravel)
+        {
+            ListFastTravelDestinationsVisitor listVisitor(mPreloadDistance, playerPos);
+            for (CellStore* cellStore : mActiveCells)
+            {
+                cellStore->forEachType<ESM::NPC>(listVisitor);
+                cellStore->forEachType<ESM::Creature>(listVisitor);
+            }
+            for (const ESM::Transport::Dest& dest : listVisitor.mList)
+            {
+                if (!dest.mCellName.empty())
+                    addInterior(dest.mCellName, travelWeight);
+                else
+                    addExterior(dest.mPos.asVec3(), travelWeight);
+            }
+        }
+
+        for (std::size_t i = 0; i < mRecentInteriors.size(); ++i)
+            addInterior(mRecentInteriors[i], recentInteriorWeight / (1 + i));
+
+        const double referenceTime = mRendering.getReferenceTime();
+        const unsigned int count = std::min(mPreloadPredictiveCount, mPreloader->getMaxCacheSize());
+        unsigned int preloaded = 0;
+        for (const auto& [name, cellIndex] : scores.getBest(scores.size()))
+        {
+            if (preloaded >= count)
+                break;
+            CellStore* cell = name.empty() ? worldModel.getExterior(cellIndex.x(), cellIndex.y())
+                                           : worldModel.getInterior(name);
+            if (mActiveCells.find(cell) != mActiveCells.end())
+                continue;
+            mPreloader->preload(cell, referenceTime);
+            ++preloaded;
+            const auto destination = name.empty() ? destinations.find(cellIndex) : destinations.end();
+            if (destination != destinations.end())
+                exteriorPositions.emplace_back(
+                    destination->second, gridCenterToBounds(getNewGridCenter(destination->second)));
+        }
+    }
+
+    void Scene::reportStats(unsigned int frameNumber, osg::Stats& stats) const
+    {
+        stats.setAttribute(frameNumber, "Scene PendingObjects", mPendingInsertions.size());
+        mPreloader->reportStats(frameNumber, stats);
+    }
 }
@@ -7,6 +7,7 @@
 
 #include "ptr.hpp"
 
+#include <deque>
 #include <memory>
 #include <optional>
 #include <set>
@@ -18,6 +19,7 @@
 namespace osg
 {
     class Vec3f;
+    class Stats;
 }
 
 namespace ESM
@@ -83,6 +85,13 @@ namespace MWWorld
             bool mChangeEvent;
         };
 
+        struct PendingInsertion
+        {
+            Ptr mPtr;
+            CellStore* mCell;
+            float mDistance;
+        };
+
         CellStore* mCurrentCell; // the cell the player is in
         CellStoreCollection mActiveCells;
         bool mCellChanged;
@@ -99,7 +108,10 @@ namespace MWWorld
         bool mPreloadExteriorGrid;
         bool mPreloadDoors;
         bool mPreloadFastTravel;
+        bool mPreloadPredictive;
+        unsigned int mPreloadPredictiveCount;
         float mPredictionTime;
+        float mIncrementalLoadingBudget;
 
         static const int mHalfGridSize = Constants::CellGridRadius;
 
@@ -107,17 +119,35 @@ namespace MWWorld
 
         std::vector<ESM::RefNum> mPagedRefs;
 
+        // Names of the interior cells the player has been in, the most recent first
+        std::deque<ESM::RefId> mRecentInteriors;
+
         std::vector<osg::ref_ptr<SceneUtil::WorkItem>> mWorkItems;
 
         std::optional<ChangeCellGridRequest> mChangeCellGridRequest;
 
+        // Objects of the loaded cells to be inserted in the next frames, the nearest to the player are at the back
+        std::vector<PendingInsertion> mPendingInsertions;
+
+        /// @param incremental add the objects that are not actors or scripted to mPendingInsertions
         void insertCell(CellStore& cell, Loading::Listener* loadingListener,
-            const DetourNavigator::UpdateGuard* navigatorUpdateGuard);
+            const DetourNavigator::UpdateGuard* navigatorUpdateGuard, bool incremental = false);
+
+        void insertPendingObject(const Ptr& ptr, const DetourNavigator::UpdateGuard* navigatorUpdateGuard);
+
+        /// Insert pending objects close to the player or any actor to guarantee collision around them.
+        void insertPendingObjectsNearActors(
+            const osg::Vec3f& playerPosition, const DetourNavigator::UpdateGuard* navigatorUpdateGuard);
+
+        /// Insert pending objects until the incremental loading budget is spent, at least one.
+        void insertPendingObjects();
 
         osg::Vec2i mCurrentGridCenter;
 
         // Load and unload cells as necessary to create a cell grid with "X" and "Y" in the center
-        void changeCellGrid(const osg::Vec3f& pos, int playerCellX, int playerCellY, bool changeEvent = true);
+        /// @param incremental spread insertion of the new cells objects over multiple frames
+        void changeCellGrid(const osg::Vec3f& pos, int playerCellX, int playerCellY, bool changeEvent = true,
+            bool incremental = false);
 
         void requestChangeCellGrid(const osg::Vec3f& position, const osg::Vec2i& cell, bool changeEvent = true);
 
@@ -130,12 +160,17 @@ namespace MWWorld
         void preloadFastTravelDestinations(const osg::Vec3f& playerPos, const osg::Vec3f& predictedPos,
             std::vector<PositionCellGrid>& exteriorPositions);
 
+        /// Score the cells by the chance to be visited soon and preload the best of them. Uses the player's
+        /// trajectory, nearby teleport doors, travel services and recently visited interiors.
+        void preloadPredictedCells(const osg::Vec3f& playerPos, const osg::Vec3f& velocity,
+            std::vector<PositionCellGrid>& exteriorPositions);
+
         osg::Vec4i gridCenterToBounds(const osg::Vec2i& centerCell) const;
         osg::Vec2i getNewGridCenter(const osg::Vec3f& pos, const osg::Vec2i* currentGridCenter = nullptr) const;
 
         void unloadCell(CellStore* cell, const DetourNavigator::UpdateGuard* navigatorUpdateGuard);
         void loadCell(CellStore* cell, Loading::Listener* loadingListener, bool respawn, const osg::Vec3f& position,
-            const DetourNavigator::UpdateGuard* navigatorUpdateGuard);
+            const DetourNavigator::UpdateGuard* navigatorUpdateGuard, bool incremental = false);
 
     public:
         Scene(MWWorld::World& world, MWRender::RenderingManager& rendering, MWPhysics::PhysicsSystem* physics,
@@ -178,6 +213,8 @@ namespace MWWorld
 
         void update(float duration);
 
+        void reportStats(unsigned int frameNumber, osg::Stats& stats) const;
+
         void addObjectToScene(const Ptr& ptr);
         ///< Add an object that already exists in the world model to the scene.
 
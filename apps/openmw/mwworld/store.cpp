@@ -1,8 +1,14 @@
 #include "store.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
 #include <iterator>
+#include <mutex>
+#include <optional>
 #include <sstream>
 #include <stdexcept>
+#include <type_traits>
 
 #include <components/debug/debuglog.hpp>
 #include <components/esm/records.hpp>
@@ -13,6 +19,7 @@
 #include <components/esm4/loadstat.hpp>
 #include <components/loadinglistener/loadinglistener.hpp>
 #include <components/misc/rng.hpp>
+#include <components/to_utf8/to_utf8.hpp>
 
 namespace
 {
@@ -28,6 +35,58 @@ namespace
         }
         return false;
     }
+
+    // Larger indices of IndexedStore records are found by binary search
+    constexpr int maxDenseIndex = 1024;
+
+    template <class T>
+    bool isIndexLess(const std::pair<int, T>& value, int index)
+    {
+        return value.first < index;
+    }
+
+    // Types with big records rarely accessed by the engine. Other types either are iterated on startup (e.g.
+    // ESM::NPC by ESMStore::validate) or have their own stores (ESM::Dialogue).
+    template <class T>
+    constexpr bool isLazyRecord = std::is_same_v<T, ESM::Book> || std::is_same_v<T, ESM::Script>;
+
+    // Read the id of a record without reading the rest of it
+    template <class T>
+    ESM::RefId loadRecordId(ESM::ESMReader& esm, bool& isDeleted)
+    {
+        ESM::RefId id;
+        isDeleted = false;
+        while (esm.hasMoreSubs())
+        {
+            esm.getSubName();
+            switch (esm.retSubName().toInt())
+            {
+                case ESM::SREC_NAME:
+                    id = esm.getRefId();
+                    break;
+                case ESM::fourCC("SCHD"):
+                {
+                    esm.getSubHeader();
+                    const std::uint32_t size = esm.getSubSize();
+                    if (size < 32)
+                        esm.fail("SCHD subrecord is too small");
+                    id = esm.getRefId(32);
+                    esm.skip(size - 32);
+                    break;
+                }
+                case ESM::SREC_DELE:
+                    esm.skipHSub();
+                    isDeleted = true;
+                    break;
+                default:
+                    esm.skipHSub();
+                    break;
+            }
+        }
+        if (id.empty())
+            esm.fail(std::is_same_v<T, ESM::Script> ? "Missing SCHD subrecord" : "Missing NAME subrecord");
+        return id;
+    }
 }
 
 namespace MWWorld
@@ -59,8 +118,25 @@ namespace MWWorld
         bool isDeleted = false;
 
         record.load(esm, isDeleted);
-        auto idx = record.mIndex;
-        mStatic.insert_or_assign(idx, std::move(record));
+        const int index = record.mIndex;
+        const auto it = std::lower_bound(mStatic.begin(), mStatic.end(), index, isIndexLess<T>);
+        if (it != mStatic.end() && it->first == index)
+        {
+            it->second = std::move(record);
+            return;
+        }
+        mStatic.emplace(it, index, std::move(record));
+
+        mPositions.clear();
+        for (std::size_t i = 0; i < mStatic.size(); ++i)
+        {
+            const int recordIndex = mStatic[i].first;
+            if (recordIndex < 0 || recordIndex >= maxDenseIndex)
+                continue;
+            if (static_cast<std::size_t>(recordIndex) >= mPositions.size())
+                mPositions.resize(recordIndex + 1, -1);
+            mPositions[recordIndex] = static_cast<int>(i);
+        }
     }
     template <typename T>
     int IndexedStore<T>::getSize() const
@@ -74,9 +150,16 @@ namespace MWWorld
     template <typename T>
     const T* IndexedStore<T>::search(int index) const
     {
-        typename Static::const_iterator it = mStatic.find(index);
-        if (it != mStatic.end())
-            return &(it->second);
+        if (index >= 0 && static_cast<std::size_t>(index) < mPositions.size())
+        {
+            const int position = mPositions[index];
+            if (position >= 0)
+                return &mStatic[position].second;
+            return nullptr;
+        }
+        const auto it = std::lower_bound(mStatic.begin(), mStatic.end(), index, isIndexLess<T>);
+        if (it != mStatic.end() && it->first == index)
+            return &it->second;
         return nullptr;
     }
     template <typename T>
@@ -96,6 +179,49 @@ namespace MWWorld
     template class IndexedStore<ESM::MagicEffect>;
     template class IndexedStore<ESM::Skill>;
 
+    template <typename T>
+    struct TypedDynamicStore<T>::LazyRecords
+    {
+        struct File
+        {
+            std::shared_ptr<const Platform::File::ScopedMapping> mMapping;
+            std::filesystem::path mPath;
+        };
+
+        struct Record
+        {
+            std::size_t mFile;
+            // Offset of the record name in the file
+            std::size_t mOffset;
+            std::atomic<bool> mLoaded{ false };
+
+            Record(std::size_t file, std::size_t offset)
+                : mFile(file)
+                , mOffset(offset)
+            {
+            }
+        };
+
+        std::vector<File> mFiles;
+        // Changed only while loading content files, so can be searched without locking
+        std::unordered_map<ESM::RefId, Record> mRecords;
+        std::atomic<std::size_t> mPending{ 0 };
+        std::optional<ToUTF8::Utf8Encoder> mEncoder;
+        // Guards mReader and the records being read
+        std::mutex mMutex;
+        ESM::ESMReader mReader;
+
+        void erase(const ESM::RefId& id)
+        {
+            const auto it = mRecords.find(id);
+            if (it == mRecords.end())
+                return;
+            if (!it->second.mLoaded)
+                --mPending;
+            mRecords.erase(it);
+        }
+    };
+
     template <typename T>
     TypedDynamicStore<T>::TypedDynamicStore()
     {
@@ -103,8 +229,80 @@ namespace MWWorld
 
     template <typename T>
     TypedDynamicStore<T>::TypedDynamicStore(const TypedDynamicStore<T>& orig)
-        : mStatic(orig.mStatic)
     {
+        orig.materializeAll();
+        mStatic = orig.mStatic;
+    }
+
+    template <typename T>
+    TypedDynamicStore<T>::~TypedDynamicStore() = default;
+
+    template <typename T>
+    void TypedDynamicStore<T>::materialize(const T& record) const
+    {
+        if constexpr (isLazyRecord<T>)
+        {
+            if (mLazy == nullptr || mLazy->mPending.load(std::memory_order_acquire) == 0)
+                return;
+            const auto it = mLazy->mRecords.find(record.mId);
+            if (it == mLazy->mRecords.end() || it->second.mLoaded.load(std::memory_order_acquire))
+                return;
+
+            const std::lock_guard lock(mLazy->mMutex);
+            if (it->second.mLoaded.load(std::memory_order_relaxed))
+                return;
+
+            const typename LazyRecords::File& file = mLazy->mFiles[it->second.mFile];
+            ESM::ESMReader& esm = mLazy->mReader;
+            if (esm.getMapping() != file.mMapping)
+            {
+                esm.setEncoder(mLazy->mEncoder.has_value() ? &*mLazy->mEncoder : nullptr);
+                esm.open(file.mMapping, file.mPath);
+            }
+
+            ESM::ESM_Context context = esm.getContext();
+            context.filePos = it->second.mOffset;
+            context.leftFile = esm.getFileSize() - it->second.mOffset;
+            context.leftRec = 0;
+            context.leftSub = 0;
+            context.subCached = false;
+            esm.restoreContext(context);
+            esm.getRecName();
+            esm.getRecHeader();
+
+            T loaded;
+            bool isDeleted = false;
+            loaded.load(esm, isDeleted);
+            // Only the placeholder is replaced, the id and position in mShared stay the same
+            const_cast<T&>(record) = std::move(loaded);
+
+            it->second.mLoaded.store(true, std::memory_order_release);
+            mLazy->mPending.fetch_sub(1, std::memory_order_release);
+        }
+    }
+
+    template <typename T>
+    void TypedDynamicStore<T>::materializeAll() const
+    {
+        if (mLazy == nullptr || mLazy->mPending.load(std::memory_order_acquire) == 0)
+            return;
+        for (const auto& [id, value] : mStatic)
+            materialize(value);
+    }
+
+    template <typename T>
+    void TypedDynamicStore<T>::setLazyLoading(bool value)
+    {
+        if constexpr (isLazyRecord<T>)
+        {
+            if (value && mLazy == nullptr)
+                mLazy = std::make_unique<LazyRecords>();
+            else if (!value && mLazy != nullptr)
+            {
+                materializeAll();
+                mLazy = nullptr;
+            }
+        }
     }
 
     template <typename T>
@@ -125,7 +323,10 @@ namespace MWWorld
 
         typename Static::const_iterator it = mStatic.find(id);
         if (it != mStatic.end())
+        {
+            materialize(it->second);
             return &(it->second);
+        }
 
         return nullptr;
     }
@@ -134,7 +335,10 @@ namespace MWWorld
     {
         typename Static::const_iterator it = mStatic.find(id);
         if (it != mStatic.end())
+        {
+            materialize(it->second);
             return &(it->second);
+        }
 
         return nullptr;
     }
@@ -151,9 +355,14 @@ namespace MWWorld
         std::vector<const T*> results;
         std::copy_if(mShared.begin(), mShared.end(), std::back_inserter(results),
             [prefix](const T* item) { return Misc::StringUtils::ciStartsWith(item->mId.getRefIdString(), prefix); });
-        if (!results.empty())
-            return results[Misc::Rng::rollDice(results.size(), prng)];
-        return nullptr;
+        if (results.empty())
+            return nullptr;
+        const T* const result = results[Misc::Rng::rollDice(results.size(), prng)];
+        // Dynamic records may have the same id as static ones
+        const auto it = mStatic.find(result->mId);
+        if (it != mStatic.end() && &it->second == result)
+            materialize(it->second);
+        return result;
     }
     template <typename T>
     const T* TypedDynamicStore<T>::find(const ESM::RefId& id) const
@@ -178,6 +387,9 @@ namespace MWWorld
     template <typename T>
     RecordId TypedDynamicStore<T>::load(ESM::ESMReader& esm)
     {
+        if (mLazy != nullptr && esm.getMapping() != nullptr)
+            return loadLazy(esm);
+
         T record;
         bool isDeleted = false;
         if constexpr (!ESM::isESM4Rec(T::sRecordId))
@@ -185,12 +397,99 @@ namespace MWWorld
             record.load(esm, isDeleted);
         }
 
+        if (mLazy != nullptr)
+            mLazy->erase(record.mId);
         std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(record.mId, record);
         if (inserted.second)
             mShared.push_back(&inserted.first->second);
 
         return RecordId(record.mId, isDeleted);
     }
+
+    template <typename T>
+    RecordId TypedDynamicStore<T>::loadLazy(ESM::ESMReader& esm)
+    {
+        // ESMStore::load has already read the record name and header
+        const std::size_t offset = esm.getFileOffset() - 4 * sizeof(std::uint32_t);
+        bool isDeleted = false;
+        const ESM::RefId id = loadRecordId<T>(esm, isDeleted);
+
+        mLazy->erase(id);
+        if (isDeleted)
+            return RecordId(id, isDeleted);
+
+        if (mLazy->mFiles.empty() || mLazy->mFiles.back().mMapping != esm.getMapping())
+            mLazy->mFiles.push_back({ esm.getMapping(), esm.getName() });
+        if (!mLazy->mEncoder.has_value() && esm.getEncoder() != nullptr)
+            mLazy->mEncoder.emplace(*esm.getEncoder());
+        mLazy->mRecords.try_emplace(id, mLazy->mFiles.size() - 1, offset);
+        ++mLazy->mPending;
+
+        // Placeholder to keep the order of records in mShared
+        T record{};
+        record.mId = id;
+        std::pair<typename Static::iterator, bool> inserted = mStatic.insert_or_assign(id, std::move(record));
+        if (inserted.second)
+            mShared.push_back(&inserted.first->second);
+
+        return RecordId(id, isDeleted);
+    }
+
+    namespace
+    {
+        template <class T>
+        class TypedStagedRecords : public StagedRecords
+        {
+        public:
+            struct Record
+            {
+                T mValue;
+                bool mIsDeleted;
+            };
+
+            std::vector<Record> mRecords;
+
+            bool load(ESM::ESMReader& esm) override
+            {
+                Record& record = mRecords.emplace_back(Record{ T(), false });
+                record.mValue.load(esm, record.mIsDeleted);
+                return record.mIsDeleted;
+            }
+        };
+    }
+
+    template <typename T>
+    std::unique_ptr<StagedRecords> TypedDynamicStore<T>::makeStagedRecords() const
+    {
+        if constexpr (ESM::isESM4Rec(T::sRecordId))
+            return nullptr;
+        else if (mLazy != nullptr)
+            return nullptr;
+        else
+            return std::make_unique<TypedStagedRecords<T>>();
+    }
+
+    template <typename T>
+    void TypedDynamicStore<T>::loadStaged(StagedRecords& records)
+    {
+        if constexpr (!ESM::isESM4Rec(T::sRecordId))
+        {
+            for (typename TypedStagedRecords<T>::Record& record : static_cast<TypedStagedRecords<T>&>(records).mRecords)
+            {
+                const ESM::RefId id = record.mValue.mId;
+                if (mLazy != nullptr)
+                    mLazy->erase(id);
+                std::pair<typename Static::iterator, bool> inserted
+                    = mStatic.insert_or_assign(id, std::move(record.mValue));
+                if (inserted.second)
+                    mShared.push_back(&inserted.first->second);
+                // Same as ESMStore::load does for deleted records
+                if (record.mIsDeleted)
+                    eraseStatic(id);
+            }
+        }
+    }
+
     template <typename T>
     void TypedDynamicStore<T>::setUp()
     {
@@ -199,6 +498,7 @@ namespace MWWorld
     template <typename T>
     typename TypedDynamicStore<T>::iterator TypedDynamicStore<T>::begin() const
     {
+        materializeAll();
         return mShared.begin();
     }
     template <typename T>
@@ -246,6 +546,8 @@ namespace MWWorld
     template <typename T>
     T* TypedDynamicStore<T>::insertStatic(const T& item)
     {
+        if (mLazy != nullptr)
+            mLazy->erase(item.mId);
         std::pair<typename Static::iterator, bool> result = mStatic.insert_or_assign(item.mId, item);
         T* ptr = &result.first->second;
         if (result.second)
@@ -255,6 +557,8 @@ namespace MWWorld
     template <typename T>
     bool TypedDynamicStore<T>::eraseStatic(const ESM::RefId& id)
     {
+        if (mLazy != nullptr)
+            mLazy->erase(id);
         typename Static::iterator it = mStatic.find(id);
 
         if (it != mStatic.end())
@@ -610,6 +914,10 @@ namespace MWWorld
         mSharedExt.reserve(mExt.size());
         for (auto& [_, cell] : mExt)
             mSharedExt.push_back(&cell);
+        std::sort(mSharedExt.begin(), mSharedExt.end(), [](const ESM::Cell* left, const ESM::Cell* right) {
+            return DynamicExtCmp()(
+                std::make_pair(left->getGridX(), left->getGridY()), std::make_pair(right->getGridX(), right->getGridY()));
+        });
     }
     RecordId Store<ESM::Cell>::load(ESM::ESMReader& esm)
     {
@@ -1,11 +1,14 @@
 #ifndef OPENMW_MWWORLD_STORE_H
 #define OPENMW_MWWORLD_STORE_H
 
+#include <cstdint>
+#include <functional>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <components/esm/refid.hpp>
@@ -50,6 +53,17 @@ namespace MWWorld
     {
     }; // Empty interface to be parent of all store types
 
+    /// Records of one type read from a content file to be added to the store later.
+    class StagedRecords
+    {
+    public:
+        virtual ~StagedRecords() = default;
+
+        /// Read the current record. Called from a worker thread, so must not access any store.
+        /// @return Is the record deleted?
+        virtual bool load(ESM::ESMReader& esm) = 0;
+    };
+
     class DynamicStore : public StoreBase
     {
     public:
@@ -65,9 +79,20 @@ namespace MWWorld
         virtual int getDynamicSize() const { return 0; }
         virtual RecordId load(ESM::ESMReader& esm) = 0;
 
+        /// Create a buffer to read records of a content file in parallel with other content files. Returns nullptr
+        /// when reading a record depends on the store state, then records have to be loaded by load() in order.
+        virtual std::unique_ptr<StagedRecords> makeStagedRecords() const { return nullptr; }
+
+        /// Add the records from the buffer as if load() was called for each of them in the same order.
+        virtual void loadStaged(StagedRecords& records) {}
+
         virtual bool eraseStatic(const ESM::RefId& id) { return false; }
         virtual void clearDynamic() {}
 
+        /// Only index the records of heavy types (books, scripts) when loading memory mapped content files and read
+        /// each of them on first access. Disabling reads all records not read yet.
+        virtual void setLazyLoading(bool value) {}
+
         virtual void write(ESM::ESMWriter& writer, Loading::Listener& progress) const {}
 
         virtual RecordId read(ESM::ESMReader& reader, bool overrideOnly = false) { return RecordId(); }
@@ -78,11 +103,14 @@ namespace MWWorld
     class IndexedStore : public StoreBase
     {
     protected:
-        typedef typename std::map<int, T> Static;
+        /// Sorted by index
+        typedef typename std::vector<std::pair<int, T>> Static;
         Static mStatic;
+        /// Position in mStatic by index for the non-negative indices, -1 for missing records
+        std::vector<int> mPositions;
 
     public:
-        typedef typename std::map<int, T>::const_iterator iterator;
+        typedef typename Static::const_iterator iterator;
 
         IndexedStore();
 
@@ -179,11 +207,23 @@ namespace MWWorld
         typedef std::unordered_map<ESM::RefId, T> Dynamic;
         Dynamic mDynamic;
 
+        struct LazyRecords;
+        /// Content file locations of the static records not read yet, nullptr when lazy loading is disabled
+        std::unique_ptr<LazyRecords> mLazy;
+
         friend class ESMStore;
 
+        RecordId loadLazy(ESM::ESMReader& esm);
+
+        /// Read the record from the content file if it is not read yet. The record is updated in place, so pointers
+        /// to it remain valid.
+        void materialize(const T& record) const;
+        void materializeAll() const;
+
     public:
         TypedDynamicStore();
         TypedDynamicStore(const TypedDynamicStore<T>& orig);
+        ~TypedDynamicStore();
 
         typedef SharedIterator<T> iterator;
 
@@ -221,7 +261,11 @@ namespace MWWorld
         bool erase(const ESM::RefId& id);
         bool erase(const T& item);
 
+        void setLazyLoading(bool value) override;
+
         RecordId load(ESM::ESMReader& esm) override;
+        std::unique_ptr<StagedRecords> makeStagedRecords() const override;
+        void loadStaged(StagedRecords& records) override;
         void write(ESM::ESMWriter& writer, Loading::Listener& progress) const override;
         RecordId read(ESM::ESMReader& reader, bool overrideOnly = false) override;
     };
@@ -312,6 +356,16 @@ namespace MWWorld
         bool mBuilt = false;
     };
 
+    /// Hash of exterior cell grid coordinates
+    struct GridPositionHash
+    {
+        std::size_t operator()(const std::pair<int, int>& value) const
+        {
+            return std::hash<std::uint64_t>()(static_cast<std::uint64_t>(static_cast<std::uint32_t>(value.first)) << 32
+                | static_cast<std::uint32_t>(value.second));
+        }
+    };
+
     template <>
     class Store<ESM::Cell> : public DynamicStore
     {
@@ -333,7 +387,8 @@ namespace MWWorld
         };
 
         typedef std::unordered_map<ESM::RefId, ESM::Cell> DynamicInt;
-        typedef std::map<std::pair<int, int>, ESM::Cell, DynamicExtCmp> DynamicExt;
+        /// mSharedExt keeps the order of DynamicExtCmp
+        typedef std::unordered_map<std::pair<int, int>, ESM::Cell, GridPositionHash> DynamicExt;
 
         DynamicInt mInt;
         DynamicExt mExt;
@@ -393,7 +448,7 @@ namespace MWWorld
     {
     private:
         typedef std::unordered_map<ESM::RefId, ESM::Pathgrid> Interior;
-        typedef std::map<std::pair<int, int>, ESM::Pathgrid> Exterior;
+        typedef std::unordered_map<std::pair<int, int>, ESM::Pathgrid, GridPositionHash> Exterior;
 
         Interior mInt;
         Exterior mExt;
@@ -104,6 +104,14 @@ namespace MWWorld
             mLoaders.emplace(std::move(extension), &loader);
         }
 
+        void prepare(const std::filesystem::path& filepath, int index) override
+        {
+            const auto it
+                = mLoaders.find(Misc::StringUtils::lowerCase(Files::pathToUnicodeString(filepath.extension())));
+            if (it != mLoaders.end())
+                it->second->prepare(filepath, index);
+        }
+
         void load(const std::filesystem::path& filepath, int& index, Loading::Listener* listener) override
         {
             const auto it
@@ -153,10 +161,10 @@ namespace MWWorld
     }
 
     World::World(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode, Resource::ResourceSystem* resourceSystem,
-        SceneUtil::WorkQueue* workQueue, SceneUtil::UnrefQueue& unrefQueue, const Files::Collections& fileCollections,
-        const std::vector<std::string>& contentFiles, const std::vector<std::string>& groundcoverFiles,
-        ToUTF8::Utf8Encoder* encoder, int activationDistanceOverride, const ESM::RefId& startCell,
-        const std::string& startupScript, const std::filesystem::path& resourcePath,
+        SceneUtil::WorkQueue* workQueue, SceneUtil::UnrefQueue& unrefQueue, Misc::JobSystem& jobSystem,
+        const Files::Collections& fileCollections, const std::vector<std::string>& contentFiles,
+        const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder, int activationDistanceOverride,
+        const ESM::RefId& startCell, const std::string& startupScript, const std::filesystem::path& resourcePath,
         const std::filesystem::path& userDataPath)
         : mResourceSystem(resourceSystem)
         , mLocalScripts(mStore)
@@ -185,7 +193,8 @@ namespace MWWorld
         Loading::Listener* listener = MWBase::Environment::get().getWindowManager()->getLoadingScreen();
         listener->loadingOn();
 
-        loadContentFiles(fileCollections, contentFiles, encoder, listener);
+        mStore.setLazyLoading(Settings::Manager::getBool("lazy record loading", "General"));
+        loadContentFiles(fileCollections, contentFiles, encoder, jobSystem, listener);
         loadGroundcoverFiles(fileCollections, groundcoverFiles, encoder, listener);
 
         listener->loadingOff();
@@ -1542,6 +1551,11 @@ namespace MWWorld
         return mPhysics.get();
     }
 
+    bool World::replayPhysics(std::size_t steps)
+    {
+        return mPhysics->replay(steps);
+    }
+
     bool World::rotateDoor(const Ptr door, MWWorld::DoorState state, float duration)
     {
         const ESM::Position& objPos = door.getRefData().getPosition();
@@ -2910,10 +2924,10 @@ namespace MWWorld
     }
 
     void World::loadContentFiles(const Files::Collections& fileCollections, const std::vector<std::string>& content,
-        ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener)
+        ToUTF8::Utf8Encoder* encoder, Misc::JobSystem& jobSystem, Loading::Listener* listener)
     {
         GameContentLoader gameContentLoader;
-        EsmLoader esmLoader(mStore, mReaders, encoder, mESMVersions);
+        EsmLoader esmLoader(mStore, mReaders, encoder, mESMVersions, &jobSystem);
 
         gameContentLoader.addLoader(".esm", esmLoader);
         gameContentLoader.addLoader(".esp", esmLoader);
@@ -2924,7 +2938,8 @@ namespace MWWorld
         OMWScriptsLoader omwScriptsLoader(mStore);
         gameContentLoader.addLoader(".omwscripts", omwScriptsLoader);
 
-        int idx = 0;
+        std::vector<std::filesystem::path> paths;
+        paths.reserve(content.size());
         for (const std::string& file : content)
         {
             const auto filename = Files::pathFromUnicodeString(file);
@@ -2932,13 +2947,20 @@ namespace MWWorld
                 = fileCollections.getCollection(Files::pathToUnicodeString(filename.extension()));
             if (col.doesExist(file))
             {
-                gameContentLoader.load(col.getPath(file), idx, listener);
+                paths.push_back(col.getPath(file));
+                gameContentLoader.prepare(paths.back(), static_cast<int>(paths.size() - 1));
             }
             else
             {
                 std::string message = "Failed loading " + file + ": the content file does not exist";
                 throw std::runtime_error(message);
             }
+        }
+
+        int idx = 0;
+        for (const std::filesystem::path& path : paths)
+        {
+            gameContentLoader.load(path, idx, listener);
             idx++;
         }
 
@@ -3916,6 +3938,7 @@ namespace MWWorld
     {
         DetourNavigator::reportStats(mNavigator->getStats(), frameNumber, stats);
         mPhysics->reportStats(frameNumber, stats);
+        mWorldScene->reportStats(frameNumber, stats);
     }
 
     void World::updateSkyDate()
@@ -66,6 +66,11 @@ namespace ToUTF8
     class Utf8Encoder;
 }
 
+namespace Misc
+{
+    class JobSystem;
+}
+
 namespace MWPhysics
 {
     class Object;
@@ -176,7 +181,7 @@ namespace MWWorld
         void updateSkyDate();
 
         void loadContentFiles(const Files::Collections& fileCollections, const std::vector<std::string>& content,
-            ToUTF8::Utf8Encoder* encoder, Loading::Listener* listener);
+            ToUTF8::Utf8Encoder* encoder, Misc::JobSystem& jobSystem, Loading::Listener* listener);
 
         void loadGroundcoverFiles(const Files::Collections& fileCollections,
             const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder,
@@ -197,7 +202,7 @@ namespace MWWorld
         void removeContainerScripts(const Ptr& reference) override;
 
         World(osgViewer::Viewer* viewer, osg::ref_ptr<osg::Group> rootNode, Resource::ResourceSystem* resourceSystem,
-            SceneUtil::WorkQueue* workQueue, SceneUtil::UnrefQueue& unrefQueue,
+            SceneUtil::WorkQueue* workQueue, SceneUtil::UnrefQueue& unrefQueue, Misc::JobSystem& jobSystem,
             const Files::Collections& fileCollections, const std::vector<std::string>& contentFiles,
             const std::vector<std::string>& groundcoverFiles, ToUTF8::Utf8Encoder* encoder,
             int activationDistanceOverride, const ESM::RefId& startCell, const std::string& startupScript,
@@ -415,6 +420,8 @@ namespace MWWorld
 
         const MWPhysics::RayCastingInterface* getRayCasting() const override;
 
+        bool replayPhysics(std::size_t steps) override;
+
         bool castRenderingRay(MWPhysics::RayCastingResult& res, const osg::Vec3f& from, const osg::Vec3f& to,
             bool ignorePlayer, bool ignoreActors) override;
 
@@ -0,0 +1,116 @@
+#include <components/bsa/decompressioncache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Bsa;
+
+    const int archive = 0;
+    const int otherArchive = 0;
+
+    std::vector<char> makeData(std::size_t size, char value = 'a')
+    {
+        return std::vector<char>(size, value);
+    }
+
+    TEST(BsaDecompressionCache, getShouldCallDecompressOnMiss)
+    {
+        DecompressionCache cache(1024);
+        int calls = 0;
+        const DecompressedData data = cache.get(&archive, 0, [&] {
+            ++calls;
+            return makeData(16);
+        });
+        EXPECT_EQ(calls, 1);
+        EXPECT_EQ(*data, makeData(16));
+        EXPECT_EQ(cache.getStats().mMisses, 1);
+        EXPECT_EQ(cache.getStats().mHits, 0);
+    }
+
+    TEST(BsaDecompressionCache, getShouldReturnCachedDataOnHit)
+    {
+        DecompressionCache cache(1024);
+        int calls = 0;
+        const auto decompress = [&] {
+            ++calls;
+            return makeData(16);
+        };
+        const DecompressedData first = cache.get(&archive, 0, decompress);
+        const DecompressedData second = cache.get(&archive, 0, decompress);
+        EXPECT_EQ(calls, 1);
+        EXPECT_EQ(first, second);
+        const DecompressionCacheStats stats = cache.getStats();
+        EXPECT_EQ(stats.mHits, 1);
+        EXPECT_EQ(stats.mMisses, 1);
+        EXPECT_EQ(stats.mBytesSaved, 16);
+        EXPECT_EQ(stats.mCachedBytes, 16);
+        EXPECT_EQ(stats.mCachedEntries, 1);
+    }
+
+    TEST(BsaDecompressionCache, shouldDistinguishArchivesAndOffsets)
+    {
+        DecompressionCache cache(1024);
+        cache.get(&archive, 0, [] { return makeData(1, 'a'); });
+        EXPECT_EQ(*cache.get(&archive, 1, [] { return makeData(1, 'b'); }), makeData(1, 'b'));
+        EXPECT_EQ(*cache.get(&otherArchive, 0, [] { return makeData(1, 'c'); }), makeData(1, 'c'));
+        const auto mustNotBeCalled = [] {
+            ADD_FAILURE() << "Entry is not found";
+            return makeData(1, 'd');
+        };
+        EXPECT_EQ(*cache.get(&archive, 0, mustNotBeCalled), makeData(1, 'a'));
+        EXPECT_EQ(*cache.get(&archive, 1, mustNotBeCalled), makeData(1, 'b'));
+    }
+
+    TEST(BsaDecompressionCache, shouldEvictLeastRecentlyUsedWhenFull)
+    {
+        DecompressionCache cache(32);
+        cache.get(&archive, 0, [] { return makeData(16); });
+        cache.get(&archive, 1, [] { return makeData(16); });
+        cache.get(&archive, 0, [] { return makeData(16); });
+        cache.get(&archive, 2, [] { return makeData(16); });
+        EXPECT_EQ(cache.getStats().mCachedBytes, 32);
+        int calls = 0;
+        cache.get(&archive, 0, [&] {
+            ++calls;
+            return makeData(16);
+        });
+        EXPECT_EQ(calls, 0);
+        cache.get(&archive, 1, [&] {
+            ++calls;
+            return makeData(16);
+        });
+        EXPECT_EQ(calls, 1);
+    }
+
+    TEST(BsaDecompressionCache, shouldNotCacheDataLargerThanLimit)
+    {
+        DecompressionCache cache(8);
+        cache.get(&archive, 0, [] { return makeData(16); });
+        EXPECT_EQ(cache.getStats().mCachedEntries, 0);
+    }
+
+    TEST(BsaDecompressionCache, removeShouldDropAllArchiveEntries)
+    {
+        DecompressionCache cache(1024);
+        cache.get(&archive, 0, [] { return makeData(16); });
+        cache.get(&archive, 1, [] { return makeData(16); });
+        cache.remove(&archive);
+        const DecompressionCacheStats stats = cache.getStats();
+        EXPECT_EQ(stats.mCachedEntries, 0);
+        EXPECT_EQ(stats.mCachedBytes, 0);
+    }
+
+    TEST(BsaDecompressionCache, getShouldRethrowDecompressionError)
+    {
+        DecompressionCache cache(1024);
+        EXPECT_THROW(cache.get(&archive, 0, []() -> std::vector<char> { throw std::runtime_error("error"); }),
+            std::runtime_error);
+        EXPECT_EQ(*cache.get(&archive, 0, [] { return makeData(1); }), makeData(1));
+    }
+}
@@ -0,0 +1,105 @@
+#include <components/esm/refid.hpp>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace ESM
+{
+    namespace
+    {
+        TEST(ESMRefIdTest, defaultConstructedShouldBeEmpty)
+        {
+            const RefId refId;
+            EXPECT_TRUE(refId.empty());
+            EXPECT_EQ(refId, RefId::sEmpty);
+            EXPECT_EQ(refId.getRefIdString(), "");
+        }
+
+        TEST(ESMRefIdTest, stringRefIdFromEmptyStringShouldBeEmpty)
+        {
+            EXPECT_TRUE(RefId::stringRefId("").empty());
+            EXPECT_EQ(RefId::stringRefId(""), RefId::sEmpty);
+        }
+
+        TEST(ESMRefIdTest, equalityShouldIgnoreCase)
+        {
+            EXPECT_EQ(RefId::stringRefId("ref_id"), RefId::stringRefId("REF_ID"));
+            EXPECT_NE(RefId::stringRefId("ref_id"), RefId::stringRefId("ref_id_2"));
+            EXPECT_NE(RefId::stringRefId("ref_id"), RefId::sEmpty);
+        }
+
+        TEST(ESMRefIdTest, shouldKeepOriginalCase)
+        {
+            const RefId lower = RefId::stringRefId("case_test");
+            const RefId upper = RefId::stringRefId("CASE_TEST");
+            EXPECT_EQ(lower.getRefIdString(), "case_test");
+            EXPECT_EQ(upper.getRefIdString(), "CASE_TEST");
+        }
+
+        TEST(ESMRefIdTest, hashShouldIgnoreCase)
+        {
+            const std::hash<RefId> hash;
+            EXPECT_EQ(hash(RefId::stringRefId("hash_test")), hash(RefId::stringRefId("Hash_Test")));
+            EXPECT_EQ(hash(RefId::sEmpty), hash(RefId::stringRefId("")));
+        }
+
+        TEST(ESMRefIdTest, lessShouldCompareStringsIgnoringCase)
+        {
+            EXPECT_LT(RefId::stringRefId("a"), RefId::stringRefId("B"));
+            EXPECT_LT(RefId::stringRefId("A"), RefId::stringRefId("b"));
+            EXPECT_LT(RefId::sEmpty, RefId::stringRefId("a"));
+            EXPECT_FALSE(RefId::stringRefId("a") < RefId::stringRefId("A"));
+            EXPECT_FALSE(RefId::stringRefId("A") < RefId::stringRefId("a"));
+        }
+
+        TEST(ESMRefIdTest, mapShouldBeOrderedByStringIgnoringCase)
+        {
+            std::map<RefId, int> map;
+            map.emplace(RefId::stringRefId("c"), 3);
+            map.emplace(RefId::stringRefId("A"), 1);
+            map.emplace(RefId::stringRefId("b"), 2);
+            map.emplace(RefId::stringRefId("a"), 4);
+            std::vector<std::string> keys;
+            for (const auto& [key, value] : map)
+                keys.push_back(key.getRefIdString());
+            EXPECT_EQ(keys, (std::vector<std::string>{ "A", "b", "c" }));
+        }
+
+        TEST(ESMRefIdTest, shouldInternEachStringOnce)
+        {
+            const RefId first = RefId::stringRefId("intern_once_test");
+            const std::size_t count = RefId::getInternedCount();
+            const RefId second = RefId::stringRefId("intern_once_test");
+            EXPECT_EQ(RefId::getInternedCount(), count);
+            EXPECT_EQ(&first.getRefIdString(), &second.getRefIdString());
+        }
+
+        TEST(ESMRefIdTest, shouldBeEqualWhenCreatedConcurrently)
+        {
+            constexpr std::size_t threadsCount = 4;
+            constexpr std::size_t idsCount = 1000;
+            std::vector<std::vector<RefId>> refIds(threadsCount);
+            std::vector<std::thread> threads;
+            for (std::size_t i = 0; i < threadsCount; ++i)
+                threads.emplace_back([&, i] {
+                    for (std::size_t j = 0; j < idsCount; ++j)
+                    {
+                        std::string id = "concurrent_test_" + std::to_string(j);
+                        // Use a different case on each thread
+                        if (i % 2 == 1)
+                            id[0] = 'C';
+                        refIds[i].push_back(RefId::stringRefId(id));
+                    }
+                });
+            for (std::thread& thread : threads)
+                thread.join();
+            for (std::size_t i = 1; i < threadsCount; ++i)
+                EXPECT_EQ(refIds[i], refIds[0]);
+        }
+    }
+}
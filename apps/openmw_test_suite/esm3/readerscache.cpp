@@ -1,6 +1,7 @@
 #include <components/esm3/readerscache.hpp>
 #include <components/files/collections.hpp>
 #include <components/files/multidircollection.hpp>
+#include <components/platform/file.hpp>
 
 #include <gtest/gtest.h>
 
@@ -88,4 +89,30 @@ namespace
             EXPECT_EQ(reader->getFileOffset(), sInitialOffset);
         }
     }
+
+    TEST_F(ESM3ReadersCacheWithContentFile, shouldReopenClosedReaderFromTheSameMapping)
+    {
+        ReadersCache readers(1);
+        std::shared_ptr<const Platform::File::ScopedMapping> mapping;
+        {
+            const ReadersCache::BusyItem reader = readers.get(0);
+            reader->open(mContentFilePath);
+            ASSERT_TRUE(reader->isOpen());
+            mapping = reader->getMapping();
+        }
+        if (mapping == nullptr)
+            GTEST_SKIP() << "Memory mapping is not supported";
+        {
+            const ReadersCache::BusyItem reader = readers.get(1);
+            reader->open(mContentFilePath);
+            ASSERT_TRUE(reader->isOpen());
+        }
+        {
+            const ReadersCache::BusyItem reader = readers.get(0);
+            EXPECT_TRUE(reader->isOpen());
+            EXPECT_EQ(reader->getMapping(), mapping);
+            EXPECT_EQ(reader->getName(), mContentFilePath);
+            EXPECT_EQ(reader->getFileOffset(), sInitialOffset);
+        }
+    }
 }
@@ -59,6 +59,13 @@ namespace
         EXPECT_EQ(getHash(file, *stream), GetParam().mHash);
     }
 
+    TEST_P(FilesGetHash, shouldReturnHashForContent)
+    {
+        std::string content;
+        std::fill_n(std::back_inserter(content), GetParam().mSize, 'a');
+        EXPECT_EQ(getHash(std::string_view(content)), GetParam().mHash);
+    }
+
     INSTANTIATE_TEST_SUITE_P(Params, FilesGetHash,
         Values(Params{ 0, { 0, 0 } }, Params{ 1, { 9607679276477937801ull, 16624257681780017498ull } },
             Params{ 128, { 15287858148353394424ull, 16818615825966581310ull } },
@@ -0,0 +1,116 @@
+#include <components/misc/jobsystem.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Misc;
+
+    TEST(MiscJobSystem, getDefaultThreadsCountShouldSubtractReservedThreads)
+    {
+        EXPECT_EQ(JobSystem::getDefaultThreadsCount(8, 5), 3);
+    }
+
+    TEST(MiscJobSystem, getDefaultThreadsCountShouldReturnAtLeastOne)
+    {
+        EXPECT_EQ(JobSystem::getDefaultThreadsCount(4, 6), 1);
+        EXPECT_EQ(JobSystem::getDefaultThreadsCount(0, 2), 1);
+    }
+
+    TEST(MiscJobSystem, submitShouldRunJob)
+    {
+        JobSystem jobSystem(2);
+        const JobSubsystem subsystem = jobSystem.registerSubsystem("Test");
+        std::atomic<int> count{ 0 };
+        std::vector<JobHandle> handles;
+        for (int i = 0; i < 10; ++i)
+            handles.push_back(jobSystem.submit(subsystem, [&] { ++count; }));
+        for (const JobHandle& handle : handles)
+            handle.wait();
+        EXPECT_EQ(count, 10);
+    }
+
+    TEST(MiscJobSystem, submitWithoutThreadsShouldRunJobOnCallingThread)
+    {
+        JobSystem jobSystem(0);
+        const JobSubsystem subsystem = jobSystem.registerSubsystem("Test");
+        std::thread::id threadId;
+        const JobHandle handle = jobSystem.submit(subsystem, [&] { threadId = std::this_thread::get_id(); });
+        EXPECT_TRUE(handle.isDone());
+        EXPECT_EQ(threadId, std::this_thread::get_id());
+    }
+
+    TEST(MiscJobSystem, jobsWithAffinityShouldRunOnSameThreadInOrder)
+    {
+        JobSystem jobSystem(4);
+        const JobSubsystem subsystem = jobSystem.registerSubsystem("Test");
+        std::vector<std::thread::id> threadIds(20);
+        std::vector<int> order;
+        std::vector<JobHandle> handles;
+        for (int i = 0; i < 20; ++i)
+            handles.push_back(jobSystem.submit(
+                subsystem,
+                [&, i] {
+                    threadIds[i] = std::this_thread::get_id();
+                    order.push_back(i);
+                },
+                1));
+        for (const JobHandle& handle : handles)
+            handle.wait();
+        for (const std::thread::id& threadId : threadIds)
+            EXPECT_EQ(threadId, threadIds.front());
+        for (int i = 0; i < 20; ++i)
+            EXPECT_EQ(order[i], i);
+    }
+
+    TEST(MiscJobSystem, waitShouldRethrowJobException)
+    {
+        JobSystem jobSystem(1);
+        const JobSubsystem subsystem = jobSystem.registerSubsystem("Test");
+        const JobHandle handle = jobSystem.submit(subsystem, [] { throw std::runtime_error("error"); });
+        EXPECT_THROW(handle.wait(), std::runtime_error);
+    }
+
+    TEST(MiscJobSystem, destructorShouldFinishQueuedJobs)
+    {
+        std::promise<void> release;
+        std::shared_future<void> released = release.get_future().share();
+        JobHandle handle;
+        {
+            JobSystem jobSystem(1);
+            const JobSubsystem subsystem = jobSystem.registerSubsystem("Test");
+            jobSystem.submit(subsystem, [&] { released.wait(); });
+            handle = jobSystem.submit(subsystem, [] {});
+            release.set_value();
+        }
+        EXPECT_TRUE(handle.isDone());
+    }
+
+    TEST(MiscJobSystem, endFrameShouldReturnJobsPerSubsystem)
+    {
+        JobSystem jobSystem(2);
+        const JobSubsystem first = jobSystem.registerSubsystem("First");
+        const JobSubsystem second = jobSystem.registerSubsystem("Second");
+        EXPECT_EQ(jobSystem.getSubsystemNames(), (std::vector<std::string>{ "First", "Second" }));
+        jobSystem.beginFrame();
+        jobSystem.submit(first, [] {}).wait();
+        jobSystem.submit(first, [] {}).wait();
+        jobSystem.run(second, [] {});
+        const JobFrame frame = jobSystem.endFrame();
+        ASSERT_EQ(frame.mTimeline.size(), 3);
+        ASSERT_EQ(frame.mSubsystems.size(), 2);
+        EXPECT_EQ(frame.mSubsystems[first].mJobs, 2);
+        EXPECT_EQ(frame.mSubsystems[second].mJobs, 1);
+        EXPECT_EQ(frame.mTimeline.back().mThread, anyJobThread);
+        EXPECT_LE(frame.mSubsystems[first].mBegin, frame.mSubsystems[first].mEnd);
+        EXPECT_GE(frame.mSubsystems[first].mTaken, 0);
+        EXPECT_TRUE(jobSystem.endFrame().mTimeline.empty());
+    }
+}
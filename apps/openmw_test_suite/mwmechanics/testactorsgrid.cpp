@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "apps/openmw/mwmechanics/actorsgrid.hpp"
+
+namespace MWMechanics
+{
+    namespace
+    {
+        using namespace testing;
+
+        std::vector<std::size_t> getInRange(const ActorsGrid& grid, const osg::Vec3f& center, float radius)
+        {
+            std::vector<std::size_t> result;
+            grid.getInRange(center, radius, result);
+            return result;
+        }
+
+        TEST(MWMechanicsActorsGridTest, getInRangeShouldReturnNothingForEmptyGrid)
+        {
+            const ActorsGrid grid;
+            EXPECT_THAT(getInRange(grid, osg::Vec3f(), 1000), IsEmpty());
+        }
+
+        TEST(MWMechanicsActorsGridTest, getInRangeShouldReturnPositionsWithinRadiusInAscendingOrder)
+        {
+            const std::vector<osg::Vec3f> positions{
+                osg::Vec3f(1000, 0, 0),
+                osg::Vec3f(-10, 0, 0),
+                osg::Vec3f(0, 0, 200),
+                osg::Vec3f(0, -600, 0),
+                osg::Vec3f(90, 90, 0),
+            };
+            ActorsGrid grid;
+            grid.build(positions);
+            EXPECT_THAT(getInRange(grid, osg::Vec3f(), 150), ElementsAre(1, 4));
+            EXPECT_THAT(getInRange(grid, osg::Vec3f(), 600), ElementsAre(1, 2, 3, 4));
+            EXPECT_THAT(getInRange(grid, osg::Vec3f(1000, 10, 0), 50), ElementsAre(0));
+        }
+
+        TEST(MWMechanicsActorsGridTest, getInRangeShouldCheckPositionsAcrossCellBorders)
+        {
+            const float border = ActorsGrid::sCellSize;
+            const std::vector<osg::Vec3f> positions{
+                osg::Vec3f(border - 1, border - 1, 0),
+                osg::Vec3f(border + 1, border + 1, 0),
+                osg::Vec3f(border - 1, border + 1, 0),
+                osg::Vec3f(border + 1, border - 1, 0),
+            };
+            ActorsGrid grid;
+            grid.build(positions);
+            EXPECT_THAT(getInRange(grid, osg::Vec3f(border, border, 0), 2), ElementsAre(0, 1, 2, 3));
+        }
+
+        TEST(MWMechanicsActorsGridTest, getInRangeShouldAppendToOutput)
+        {
+            const std::vector<osg::Vec3f> positions{ osg::Vec3f(), osg::Vec3f(10, 0, 0) };
+            ActorsGrid grid;
+            grid.build(positions);
+            std::vector<std::size_t> result{ 42 };
+            grid.getInRange(osg::Vec3f(), 20, result);
+            EXPECT_THAT(result, ElementsAre(42, 0, 1));
+        }
+
+        TEST(MWMechanicsActorsGridTest, getInRangeShouldSupportInfiniteRadius)
+        {
+            const std::vector<osg::Vec3f> positions{ osg::Vec3f(-1e6f, 0, 0), osg::Vec3f(1e6f, 1e6f, 0) };
+            ActorsGrid grid;
+            grid.build(positions);
+            EXPECT_THAT(getInRange(grid, osg::Vec3f(), std::numeric_limits<float>::infinity()), ElementsAre(0, 1));
+        }
+
+        TEST(MWMechanicsActorsGridTest, getInRangeShouldReturnNothingAfterClear)
+        {
+            const std::vector<osg::Vec3f> positions{ osg::Vec3f() };
+            ActorsGrid grid;
+            grid.build(positions);
+            grid.clear();
+            EXPECT_EQ(grid.getSize(), 0);
+            EXPECT_THAT(getInRange(grid, osg::Vec3f(), 100), IsEmpty());
+        }
+    }
+}
@@ -0,0 +1,85 @@
+#include <gtest/gtest.h>
+
+#include <array>
+
+#include "apps/openmw/mwphysics/physicssnapshots.hpp"
+
+namespace MWPhysics
+{
+    namespace
+    {
+        const std::array<char, 3> refs{};
+
+        const MWWorld::LiveCellRefBase* getRef(std::size_t index)
+        {
+            return reinterpret_cast<const MWWorld::LiveCellRefBase*>(&refs[index]);
+        }
+
+        void record(PhysicsSnapshots& snapshots, std::uint64_t step)
+        {
+            PhysicsSnapshot& snapshot = snapshots.beginRecord(step, 0.1f);
+            snapshot.mActors.push_back(ActorSnapshot{ getRef(2), osg::Vec3f(1, 0, 0), osg::Vec2f() });
+            snapshot.mActors.push_back(ActorSnapshot{ getRef(0), osg::Vec3f(2, 0, 0), osg::Vec2f() });
+            snapshots.endRecord();
+        }
+
+        TEST(MWPhysicsSnapshotsTest, shouldBeEmptyByDefault)
+        {
+            const PhysicsSnapshots snapshots(4);
+            EXPECT_TRUE(snapshots.empty());
+            EXPECT_EQ(snapshots.getCapacity(), 4);
+            EXPECT_EQ(snapshots.getLatest(), nullptr);
+            EXPECT_EQ(snapshots.find(0), nullptr);
+        }
+
+        TEST(MWPhysicsSnapshotsTest, findShouldReturnRecordedStep)
+        {
+            PhysicsSnapshots snapshots(4);
+            record(snapshots, 10);
+            record(snapshots, 11);
+            ASSERT_NE(snapshots.find(10), nullptr);
+            EXPECT_EQ(snapshots.find(10)->mStep, 10);
+            ASSERT_NE(snapshots.find(11), nullptr);
+            EXPECT_EQ(snapshots.find(11)->mStep, 11);
+            EXPECT_EQ(snapshots.find(9), nullptr);
+            EXPECT_EQ(snapshots.find(12), nullptr);
+            EXPECT_EQ(snapshots.getLatest(), snapshots.find(11));
+        }
+
+        TEST(MWPhysicsSnapshotsTest, shouldReplaceOldestStepWhenFull)
+        {
+            PhysicsSnapshots snapshots(2);
+            record(snapshots, 1);
+            record(snapshots, 2);
+            record(snapshots, 3);
+            EXPECT_EQ(snapshots.getSize(), 2);
+            EXPECT_EQ(snapshots.find(1), nullptr);
+            ASSERT_NE(snapshots.find(2), nullptr);
+            ASSERT_NE(snapshots.find(3), nullptr);
+            EXPECT_EQ(snapshots.find(3)->mStep, 3);
+        }
+
+        TEST(MWPhysicsSnapshotsTest, shouldDropStepsWhenRecordedStepDoesNotFollowLatest)
+        {
+            PhysicsSnapshots snapshots(4);
+            record(snapshots, 1);
+            record(snapshots, 2);
+            record(snapshots, 5);
+            EXPECT_EQ(snapshots.getSize(), 1);
+            EXPECT_EQ(snapshots.find(2), nullptr);
+            EXPECT_NE(snapshots.find(5), nullptr);
+        }
+
+        TEST(MWPhysicsSnapshotsTest, findActorShouldReturnRecordedActor)
+        {
+            PhysicsSnapshots snapshots(1);
+            record(snapshots, 0);
+            const PhysicsSnapshot& snapshot = *snapshots.getLatest();
+            ASSERT_NE(snapshot.findActor(getRef(0)), nullptr);
+            EXPECT_EQ(snapshot.findActor(getRef(0))->mMovement, osg::Vec3f(2, 0, 0));
+            ASSERT_NE(snapshot.findActor(getRef(2)), nullptr);
+            EXPECT_EQ(snapshot.findActor(getRef(2))->mMovement, osg::Vec3f(1, 0, 0));
+            EXPECT_EQ(snapshot.findActor(getRef(1)), nullptr);
+        }
+    }
+}
@@ -364,3 +364,240 @@ TEST_F(StoreTest, overwrite_test)
 
     ASSERT_TRUE(overwrittenRec && overwrittenRec->mModel == "the_new_model");
 }
+
+/// Tests lookup and order of records stored by index.
+TEST_F(StoreTest, indexed_store_test)
+{
+    ESM::Dialogue* dialogue = nullptr;
+    for (const auto& [index, description] :
+        { std::pair(5, "five"), std::pair(1, "one"), std::pair(2000, "big"), std::pair(1, "new one") })
+    {
+        ESM::MagicEffect effect;
+        effect.blank();
+        effect.mIndex = index;
+        effect.mDescription = description;
+        ESM::ESMReader reader;
+        reader.open(getEsmFile(effect, false), "filename");
+        mEsmStore.load(reader, &dummyListener, dialogue);
+    }
+    mEsmStore.setUp();
+
+    const MWWorld::Store<ESM::MagicEffect>& store = mEsmStore.get<ESM::MagicEffect>();
+    EXPECT_EQ(store.getSize(), 3);
+    EXPECT_EQ(store.find(1)->mDescription, "new one");
+    EXPECT_EQ(store.find(5)->mDescription, "five");
+    EXPECT_EQ(store.find(2000)->mDescription, "big");
+    EXPECT_EQ(store.search(3), nullptr);
+    EXPECT_EQ(store.search(-1), nullptr);
+    EXPECT_EQ(store.search(3000), nullptr);
+
+    std::vector<int> indices;
+    for (const auto& [index, effect] : store)
+        indices.push_back(index);
+    EXPECT_EQ(indices, (std::vector<int>{ 1, 5, 2000 }));
+}
+
+/// Tests that exterior cells are listed in descending, row-major order.
+TEST_F(StoreTest, exterior_cells_order_test)
+{
+    MWWorld::Store<ESM::Cell> store;
+    for (const auto& [x, y] : { std::pair(-2, -9), std::pair(-22, 16), std::pair(-2, 3), std::pair(5, 0) })
+        store.searchOrCreate(x, y);
+    store.setUp();
+
+    std::vector<std::pair<int, int>> positions;
+    for (auto it = store.extBegin(); it != store.extEnd(); ++it)
+        positions.emplace_back(it->getGridX(), it->getGridY());
+    EXPECT_EQ(positions, (std::vector<std::pair<int, int>>{ { 5, 0 }, { -2, 3 }, { -2, -9 }, { -22, 16 } }));
+    EXPECT_EQ(store.search(-22, 16)->getGridY(), 16);
+    EXPECT_EQ(store.search(1, 1), nullptr);
+}
+
+/// Load a file the same way as EsmLoader does with a job system, reading the records not depending on the store first.
+static void loadStaged(MWWorld::ESMStore& store, std::unique_ptr<std::istream> file, ESM::Dialogue*& dialogue)
+{
+    const std::string content = static_cast<std::stringstream&>(*file).str();
+
+    ESM::ESMReader stagingReader;
+    stagingReader.open(std::make_unique<std::stringstream>(content), "filename");
+    std::unique_ptr<MWWorld::StagedContentFile> staged = store.readStaged(stagingReader);
+
+    ESM::ESMReader reader;
+    reader.open(std::make_unique<std::stringstream>(content), "filename");
+    store.load(reader, &dummyListener, dialogue, staged.get());
+}
+
+/// Tests deletion of records loaded with staging.
+TEST_F(StoreTest, staged_delete_test)
+{
+    ESM::Apparatus record;
+    record.blank();
+    record.mId = ESM::RefId::stringRefId("foobar");
+
+    ESM::Dialogue* dialogue = nullptr;
+
+    loadStaged(mEsmStore, getEsmFile(record, false), dialogue);
+    mEsmStore.setUp();
+    EXPECT_EQ(mEsmStore.get<ESM::Apparatus>().getSize(), 1);
+
+    loadStaged(mEsmStore, getEsmFile(record, true), dialogue);
+    mEsmStore.setUp();
+    EXPECT_EQ(mEsmStore.get<ESM::Apparatus>().getSize(), 0);
+
+    record.mModel = "the_new_model";
+    loadStaged(mEsmStore, getEsmFile(record, false), dialogue);
+    mEsmStore.setUp();
+    ASSERT_EQ(mEsmStore.get<ESM::Apparatus>().getSize(), 1);
+    EXPECT_EQ(mEsmStore.get<ESM::Apparatus>().find(record.mId)->mModel, "the_new_model");
+}
+
+/// Write an in-memory ESM file to disk, so the reader can map it into memory.
+static std::filesystem::path writeEsmFile(std::unique_ptr<std::istream> file, const std::string& name)
+{
+    const std::filesystem::path path = TestingOpenMW::temporaryFilePath(name);
+    std::ofstream(path, std::ios::binary) << static_cast<std::stringstream&>(*file).str();
+    return path;
+}
+
+struct StoreLazyLoadingTest : StoreTest
+{
+    ESM::Dialogue* mDialogue = nullptr;
+
+    StoreLazyLoadingTest() { mEsmStore.setLazyLoading(true); }
+
+    /// @return Is the file memory mapped?
+    bool load(const std::filesystem::path& path)
+    {
+        ESM::ESMReader reader;
+        reader.open(path);
+        mEsmStore.load(reader, &dummyListener, mDialogue);
+        return reader.getMapping() != nullptr;
+    }
+
+    static ESM::Book makeBook(std::string_view id, std::string_view text)
+    {
+        ESM::Book book;
+        book.blank();
+        book.mId = ESM::RefId::stringRefId(id);
+        book.mText = text;
+        return book;
+    }
+};
+
+TEST_F(StoreLazyLoadingTest, should_read_record_on_first_search)
+{
+    const ESM::Book book = makeBook("lazy_book", "text");
+    if (!load(writeEsmFile(getEsmFile(book, false), "lazy_book.omwaddon")))
+        GTEST_SKIP() << "Memory mapping is not supported";
+    mEsmStore.setUp();
+
+    const MWWorld::Store<ESM::Book>& store = mEsmStore.get<ESM::Book>();
+    EXPECT_EQ(store.getSize(), 1);
+    std::vector<ESM::RefId> ids;
+    store.listIdentifier(ids);
+    EXPECT_EQ(ids, std::vector<ESM::RefId>{ book.mId });
+    const ESM::Book* const found = store.find(book.mId);
+    EXPECT_EQ(found->mText, "text");
+    EXPECT_EQ(store.search(book.mId), found);
+}
+
+TEST_F(StoreLazyLoadingTest, should_read_last_override_and_skip_deleted_records)
+{
+    if (!load(writeEsmFile(getEsmFile(makeBook("lazy_book_1", "old"), false), "lazy_book_1.omwaddon")))
+        GTEST_SKIP() << "Memory mapping is not supported";
+    load(writeEsmFile(getEsmFile(makeBook("lazy_book_2", "text"), false), "lazy_book_2.omwaddon"));
+    load(writeEsmFile(getEsmFile(makeBook("lazy_book_1", "new"), false), "lazy_book_3.omwaddon"));
+    load(writeEsmFile(getEsmFile(makeBook("lazy_book_2", ""), true), "lazy_book_4.omwaddon"));
+    mEsmStore.setUp();
+
+    const MWWorld::Store<ESM::Book>& store = mEsmStore.get<ESM::Book>();
+    EXPECT_EQ(store.getSize(), 1);
+    EXPECT_EQ(store.find(ESM::RefId::stringRefId("lazy_book_1"))->mText, "new");
+    EXPECT_EQ(store.search(ESM::RefId::stringRefId("lazy_book_2")), nullptr);
+}
+
+TEST_F(StoreLazyLoadingTest, iteration_should_read_all_records_in_load_order)
+{
+    if (!load(writeEsmFile(getEsmFile(makeBook("lazy_book_b", "b"), false), "lazy_book_b.omwaddon")))
+        GTEST_SKIP() << "Memory mapping is not supported";
+    load(writeEsmFile(getEsmFile(makeBook("lazy_book_a", "a"), false), "lazy_book_a.omwaddon"));
+    mEsmStore.setUp();
+
+    std::vector<std::string> texts;
+    for (const ESM::Book& book : mEsmStore.get<ESM::Book>())
+        texts.push_back(book.mText);
+    EXPECT_EQ(texts, (std::vector<std::string>{ "b", "a" }));
+}
+
+TEST_F(StoreLazyLoadingTest, should_read_script_id_from_header)
+{
+    ESM::Script script;
+    script.mId = ESM::RefId::stringRefId("lazy_script");
+    script.blank();
+    script.mScriptText = "begin lazy_script\nend\n";
+    if (!load(writeEsmFile(getEsmFile(script, false), "lazy_script.omwaddon")))
+        GTEST_SKIP() << "Memory mapping is not supported";
+    mEsmStore.setUp();
+
+    EXPECT_EQ(mEsmStore.get<ESM::Script>().find(script.mId)->mScriptText, script.mScriptText);
+}
+
+/// Create an ESM file in-memory containing a dialogue, an apparatus and an info in this order.
+static std::unique_ptr<std::istream> getDialogueEsmFile(
+    const ESM::Dialogue& dialogue, const ESM::Apparatus& apparatus, bool apparatusDeleted, const ESM::DialInfo& info)
+{
+    ESM::ESMWriter writer;
+    auto stream = std::make_unique<std::stringstream>();
+    writer.setFormat(0);
+    writer.save(*stream);
+    writer.startRecord(ESM::Dialogue::sRecordId);
+    dialogue.save(writer);
+    writer.endRecord(ESM::Dialogue::sRecordId);
+    writer.startRecord(ESM::Apparatus::sRecordId);
+    apparatus.save(writer, apparatusDeleted);
+    writer.endRecord(ESM::Apparatus::sRecordId);
+    writer.startRecord(ESM::DialInfo::sRecordId);
+    info.save(writer);
+    writer.endRecord(ESM::DialInfo::sRecordId);
+    return stream;
+}
+
+struct StoreStagedDialogueTest : StoreTest, ::testing::WithParamInterface<std::tuple<bool, bool>>
+{
+};
+
+/// An info record belongs to the dialogue only when there are no other records in between except deleted ones.
+TEST_P(StoreStagedDialogueTest, info_after_other_record_should_be_loaded_the_same_way_with_staging)
+{
+    const auto [staged, apparatusDeleted] = GetParam();
+
+    ESM::Dialogue dialogue;
+    dialogue.blank();
+    dialogue.mId = ESM::RefId::stringRefId("dialogue");
+    dialogue.mType = ESM::Dialogue::Topic;
+
+    ESM::Apparatus apparatus;
+    apparatus.blank();
+    apparatus.mId = ESM::RefId::stringRefId("apparatus");
+
+    ESM::DialInfo info;
+    info.blank();
+    info.mId = ESM::RefId::stringRefId("info");
+
+    ESM::Dialogue* currentDialogue = nullptr;
+    if (staged)
+        loadStaged(mEsmStore, getDialogueEsmFile(dialogue, apparatus, apparatusDeleted, info), currentDialogue);
+    else
+    {
+        ESM::ESMReader reader;
+        reader.open(getDialogueEsmFile(dialogue, apparatus, apparatusDeleted, info), "filename");
+        mEsmStore.load(reader, &dummyListener, currentDialogue);
+    }
+    mEsmStore.setUp();
+
+    EXPECT_EQ(mEsmStore.get<ESM::Apparatus>().getSize(), apparatusDeleted ? 0 : 1);
+    EXPECT_EQ(mEsmStore.get<ESM::Dialogue>().find(dialogue.mId)->mInfo.size(), apparatusDeleted ? 1 : 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(StagedAndNotStaged, StoreStagedDialogueTest,
+    ::testing::Combine(::testing::Bool(), ::testing::Bool()));
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <components/misc/constants.hpp>
+
+#include "apps/openmw/mwworld/preloadscores.hpp"
+
+namespace MWWorld
+{
+    namespace
+    {
+        TEST(MWWorldPreloadScoresTest, getBestShouldReturnKeysWithHighestScoreFirst)
+        {
+            PreloadScores<int> scores;
+            scores.add(1, 0.5f);
+            scores.add(2, 2.0f);
+            scores.add(3, 1.0f);
+            EXPECT_EQ(scores.getBest(2), (std::vector<int>{ 2, 3 }));
+        }
+
+        TEST(MWWorldPreloadScoresTest, getBestShouldReturnAllKeysWhenCountIsGreater)
+        {
+            PreloadScores<int> scores;
+            scores.add(1, 0.5f);
+            scores.add(2, 2.0f);
+            EXPECT_EQ(scores.getBest(10), (std::vector<int>{ 2, 1 }));
+        }
+
+        TEST(MWWorldPreloadScoresTest, addShouldKeepHighestScoreForSameKey)
+        {
+            PreloadScores<int> scores;
+            scores.add(1, 1.0f);
+            scores.add(2, 1.5f);
+            scores.add(1, 2.0f);
+            scores.add(1, 0.1f);
+            EXPECT_EQ(scores.size(), 2);
+            EXPECT_EQ(scores.getScores().at(1), 2.0f);
+            EXPECT_EQ(scores.getBest(1), (std::vector<int>{ 1 }));
+        }
+
+        TEST(MWWorldPreloadScoresTest, getBestShouldResolveTiesByKeyOrder)
+        {
+            PreloadScores<int> scores;
+            scores.add(3, 1.0f);
+            scores.add(1, 1.0f);
+            scores.add(2, 1.0f);
+            EXPECT_EQ(scores.getBest(3), (std::vector<int>{ 1, 2, 3 }));
+        }
+
+        TEST(MWWorldPreloadScoresTest, trajectoryScoresShouldPreferCellsReachedSooner)
+        {
+            PreloadScores<osg::Vec2i> scores;
+            const float cellSize = Constants::CellSizeInUnits;
+            addTrajectoryScores(osg::Vec3f(cellSize / 2, cellSize / 2, 0), osg::Vec3f(cellSize, 0, 0), 3, 3, 0, 1,
+                scores);
+            EXPECT_EQ(scores.getBest(4),
+                (std::vector<osg::Vec2i>{ osg::Vec2i(0, 0), osg::Vec2i(1, 0), osg::Vec2i(2, 0), osg::Vec2i(3, 0) }));
+            EXPECT_FLOAT_EQ(scores.getScores().at(osg::Vec2i(0, 0)), 1);
+            EXPECT_FLOAT_EQ(scores.getScores().at(osg::Vec2i(3, 0)), 0.25f);
+        }
+
+        TEST(MWWorldPreloadScoresTest, trajectoryScoresShouldIncludeNeighboursWithLowerScore)
+        {
+            PreloadScores<osg::Vec2i> scores;
+            addTrajectoryScores(osg::Vec3f(10, 10, 0), osg::Vec3f(0, 0, 0), 1, 1, 1, 1, scores);
+            EXPECT_EQ(scores.size(), 9);
+            EXPECT_FLOAT_EQ(scores.getScores().at(osg::Vec2i(0, 0)), 1);
+            EXPECT_FLOAT_EQ(scores.getScores().at(osg::Vec2i(-1, 1)), 0.5f);
+        }
+    }
+}
@@ -0,0 +1,136 @@
+#include <components/resource/ddsmipmaps.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    std::uint32_t readUInt32(const std::string& content, std::size_t offset)
+    {
+        std::uint32_t value;
+        std::memcpy(&value, content.data() + offset, sizeof(value));
+        return value;
+    }
+
+    void writeUInt32(std::string& content, std::size_t offset, std::uint32_t value)
+    {
+        std::memcpy(content.data() + offset, &value, sizeof(value));
+    }
+
+    std::size_t getDxt1Size(std::uint32_t width, std::uint32_t height)
+    {
+        return std::max<std::size_t>(1, (width + 3) / 4) * std::max<std::size_t>(1, (height + 3) / 4) * 8;
+    }
+
+    /// Each mipmap is filled with its level number
+    std::string makeDxt1(std::uint32_t width, std::uint32_t height, std::uint32_t mipMapCount)
+    {
+        std::string result(128, '\0');
+        std::memcpy(result.data(), "DDS ", 4);
+        writeUInt32(result, 4, 124);
+        writeUInt32(result, 8, 0x1 | 0x2 | 0x4 | 0x1000 | 0x20000 | 0x80000);
+        writeUInt32(result, 12, height);
+        writeUInt32(result, 16, width);
+        writeUInt32(result, 20, static_cast<std::uint32_t>(getDxt1Size(width, height)));
+        writeUInt32(result, 28, mipMapCount);
+        writeUInt32(result, 76, 32);
+        writeUInt32(result, 80, 0x4);
+        std::memcpy(result.data() + 84, "DXT1", 4);
+        writeUInt32(result, 108, 0x1000 | 0x400000 | 0x8);
+        for (std::uint32_t i = 0; i < mipMapCount; ++i)
+            result.append(getDxt1Size(std::max(1u, width >> i), std::max(1u, height >> i)), static_cast<char>(i));
+        return result;
+    }
+
+    TEST(ResourceReduceDdsMipmaps, shouldKeepOnlyMipmapsNotLargerThanMaxSize)
+    {
+        const std::string content = makeDxt1(256, 128, 9);
+        const std::optional<std::string> result = reduceDdsMipmaps(content, 64);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(readUInt32(*result, 12), 32);
+        EXPECT_EQ(readUInt32(*result, 16), 64);
+        EXPECT_EQ(readUInt32(*result, 20), getDxt1Size(64, 32));
+        EXPECT_EQ(readUInt32(*result, 28), 7);
+        std::string expected = content.substr(0, 128);
+        for (std::uint32_t i = 2; i < 9; ++i)
+            expected.append(getDxt1Size(std::max(1u, 256u >> i), std::max(1u, 128u >> i)), static_cast<char>(i));
+        EXPECT_EQ(result->substr(128), expected.substr(128));
+    }
+
+    TEST(ResourceGetDdsMipmapsReduction, shouldNeedOnlyHeader)
+    {
+        const std::string content = makeDxt1(256, 128, 9);
+        const std::optional<DdsMipmapsReduction> result
+            = getDdsMipmapsReduction(std::string_view(content).substr(0, ddsHeaderSize), 64);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(result->mHeader, reduceDdsMipmaps(content, 64)->substr(0, ddsHeaderSize));
+        EXPECT_EQ(result->mOffset, ddsHeaderSize + getDxt1Size(256, 128) + getDxt1Size(128, 64));
+        EXPECT_EQ(result->mOffset + result->mSize, content.size());
+    }
+
+    TEST(ResourceReduceDdsMipmaps, shouldReturnNulloptWhenImageFits)
+    {
+        EXPECT_EQ(reduceDdsMipmaps(makeDxt1(64, 64, 7), 64), std::nullopt);
+    }
+
+    TEST(ResourceReduceDdsMipmaps, shouldReturnNulloptWithoutEnoughMipmaps)
+    {
+        EXPECT_EQ(reduceDdsMipmaps(makeDxt1(256, 256, 2), 64), std::nullopt);
+    }
+
+    TEST(ResourceReduceDdsMipmaps, shouldReturnNulloptForTruncatedFile)
+    {
+        std::string content = makeDxt1(256, 256, 9);
+        content.resize(content.size() - 1);
+        EXPECT_EQ(reduceDdsMipmaps(content, 64), std::nullopt);
+    }
+
+    TEST(ResourceReduceDdsMipmaps, shouldReturnNulloptForCubeMap)
+    {
+        std::string content = makeDxt1(256, 256, 9);
+        writeUInt32(content, 112, 0x200 | 0xFC00);
+        EXPECT_EQ(reduceDdsMipmaps(content, 64), std::nullopt);
+    }
+
+    TEST(ResourceReduceDdsMipmaps, shouldReturnNulloptForUnsupportedFourCC)
+    {
+        std::string content = makeDxt1(256, 256, 9);
+        std::memcpy(content.data() + 84, "DX10", 4);
+        EXPECT_EQ(reduceDdsMipmaps(content, 64), std::nullopt);
+    }
+
+    TEST(ResourceReduceDdsMipmaps, shouldReturnNulloptForOtherFiles)
+    {
+        EXPECT_EQ(reduceDdsMipmaps(std::string(256, 'a'), 64), std::nullopt);
+    }
+
+    TEST(ResourceReduceDdsMipmaps, shouldSupportUncompressedFormats)
+    {
+        std::string content = makeDxt1(8, 8, 1).substr(0, 128);
+        writeUInt32(content, 8, 0x1 | 0x2 | 0x4 | 0x8 | 0x1000 | 0x20000);
+        writeUInt32(content, 12, 8);
+        writeUInt32(content, 16, 8);
+        writeUInt32(content, 20, 8 * 4);
+        writeUInt32(content, 28, 4);
+        writeUInt32(content, 80, 0x40 | 0x1);
+        writeUInt32(content, 84, 0);
+        writeUInt32(content, 88, 32);
+        for (std::uint32_t i = 0; i < 4; ++i)
+            content.append((8u >> i) * (8u >> i) * 4, static_cast<char>(i));
+        const std::optional<std::string> result = reduceDdsMipmaps(content, 2);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(readUInt32(*result, 16), 2);
+        EXPECT_EQ(readUInt32(*result, 20), 2 * 4);
+        EXPECT_EQ(readUInt32(*result, 28), 2);
+        EXPECT_EQ(result->size(), 128 + 2 * 2 * 4 + 1 * 1 * 4);
+        EXPECT_EQ(result->back(), 3);
+    }
+}
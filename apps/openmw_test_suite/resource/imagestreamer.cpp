@@ -0,0 +1,211 @@
+#include <components/resource/imagestreamer.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <osg/Group>
+#include <osg/NodeVisitor>
+#include <osg/StateSet>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    osg::ref_ptr<osg::Image> makeImage(int size)
+    {
+        osg::ref_ptr<osg::Image> image = new osg::Image;
+        image->allocateImage(size, size, 1, GL_RGBA, GL_UNSIGNED_BYTE);
+        return image;
+    }
+
+    constexpr int lowSize = 4;
+    constexpr int fullSize = 16;
+    constexpr std::size_t fullBytes = fullSize * fullSize * 4;
+
+    struct ResourceImageStreamerTest : Test
+    {
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue{ new SceneUtil::WorkQueue(1) };
+        std::atomic_int mLoads{ 0 };
+        std::atomic_bool mFail{ false };
+        // Plays the role of the image cache holding the images returned by the streamer
+        std::map<std::string, osg::ref_ptr<osg::Image>> mCache;
+        unsigned mFrame = 0;
+
+        ImageStreamer::LoadFullImage makeLoadFullImage()
+        {
+            return [this](const std::string& /*name*/, bool /*disableFlip*/) -> osg::ref_ptr<osg::Image> {
+                ++mLoads;
+                if (mFail)
+                    return nullptr;
+                return makeImage(fullSize);
+            };
+        }
+
+        osg::Image& add(ImageStreamer& streamer, const std::string& name)
+        {
+            osg::ref_ptr<osg::Image>& image = mCache[name];
+            image = streamer.add(name, makeImage(lowSize), false);
+            return *image;
+        }
+
+        // Plays the role of the update traversal visiting the textures of the cached images
+        void updateTraversal(osg::NodeVisitor& nv)
+        {
+            nv.setTraversalNumber(mFrame);
+            for (const auto& [name, image] : mCache)
+                image->update(&nv);
+        }
+
+        void frame(ImageStreamer& streamer)
+        {
+            streamer.update(++mFrame);
+            osg::NodeVisitor nv(osg::NodeVisitor::UPDATE_VISITOR);
+            updateTraversal(nv);
+        }
+
+        void updateUntilLoaded(ImageStreamer& streamer)
+        {
+            const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+            do
+            {
+                frame(streamer);
+                if (streamer.getStats().mLoading == 0)
+                {
+                    // Swaps picked by the last update are done by the next update traversal
+                    frame(streamer);
+                    return;
+                }
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            } while (std::chrono::steady_clock::now() < deadline);
+            FAIL() << "Full images are not loaded";
+        }
+    };
+
+    TEST_F(ResourceImageStreamerTest, addShouldReturnImageWithLowMipmaps)
+    {
+        ImageStreamer streamer(mWorkQueue, makeLoadFullImage(), 0);
+        const osg::ref_ptr<osg::Image> low = makeImage(lowSize);
+        const unsigned char* const data = low->data();
+        const osg::ref_ptr<osg::Image> image = streamer.add("a.dds", osg::ref_ptr<osg::Image>(low), false);
+        EXPECT_EQ(image->s(), lowSize);
+        EXPECT_EQ(image->data(), data);
+        EXPECT_EQ(image->getFileName(), "a.dds");
+    }
+
+    TEST_F(ResourceImageStreamerTest, updateShouldSwapInLoadedFullImage)
+    {
+        ImageStreamer streamer(mWorkQueue, makeLoadFullImage(), 0);
+        const osg::Image& image = add(streamer, "a.dds");
+        updateUntilLoaded(streamer);
+        EXPECT_EQ(image.s(), fullSize);
+        EXPECT_EQ(mLoads, 1);
+        EXPECT_EQ(streamer.getStats().mFullBytes, fullBytes);
+    }
+
+    TEST_F(ResourceImageStreamerTest, updateTraversalOfSameFrameShouldNotSwapInFullImage)
+    {
+        ImageStreamer streamer(mWorkQueue, makeLoadFullImage(), 0);
+        const osg::Image& image = add(streamer, "a.dds");
+        osg::NodeVisitor nv(osg::NodeVisitor::UPDATE_VISITOR);
+        const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        do
+        {
+            streamer.update(++mFrame);
+            updateTraversal(nv);
+            ASSERT_EQ(image.s(), lowSize);
+        } while (streamer.getStats().mLoading != 0 && std::chrono::steady_clock::now() < deadline);
+        frame(streamer);
+        EXPECT_EQ(image.s(), fullSize);
+    }
+
+    TEST_F(ResourceImageStreamerTest, updateTraversalShouldMakeStateSetDynamic)
+    {
+        ImageStreamer streamer(mWorkQueue, makeLoadFullImage(), 0);
+        add(streamer, "a.dds");
+        osg::ref_ptr<osg::Group> node = new osg::Group;
+        osg::StateSet* const stateSet = node->getOrCreateStateSet();
+        osg::NodeVisitor nv(osg::NodeVisitor::UPDATE_VISITOR);
+        nv.pushOntoNodePath(node);
+        updateTraversal(nv);
+        EXPECT_EQ(stateSet->getDataVariance(), osg::Object::DYNAMIC);
+        EXPECT_TRUE(mCache["a.dds"]->requiresUpdateCall());
+    }
+
+    TEST_F(ResourceImageStreamerTest, updateShouldKeepLowMipmapsWhenLoadingFails)
+    {
+        mFail = true;
+        ImageStreamer streamer(mWorkQueue, makeLoadFullImage(), 0);
+        const osg::Image& image = add(streamer, "a.dds");
+        updateUntilLoaded(streamer);
+        EXPECT_EQ(image.s(), lowSize);
+        EXPECT_EQ(streamer.getStats().mFullBytes, 0);
+    }
+
+    TEST_F(ResourceImageStreamerTest, updateShouldForgetExpiredImages)
+    {
+        ImageStreamer streamer(mWorkQueue, makeLoadFullImage(), 0);
+        add(streamer, "a.dds");
+        updateUntilLoaded(streamer);
+        mCache.clear();
+        frame(streamer);
+        EXPECT_EQ(streamer.getStats().mStreamed, 0);
+        EXPECT_EQ(streamer.getStats().mFullBytes, 0);
+    }
+
+    TEST_F(ResourceImageStreamerTest, updateShouldDropFullImagesOverBudget)
+    {
+        ImageStreamer streamer(mWorkQueue, makeLoadFullImage(), fullBytes);
+        const osg::Image& a = add(streamer, "a.dds");
+        const osg::Image& b = add(streamer, "b.dds");
+        updateUntilLoaded(streamer);
+        EXPECT_EQ(a.s() + b.s(), lowSize + fullSize);
+        EXPECT_EQ(streamer.getStats().mFullBytes, fullBytes);
+    }
+
+    TEST_F(ResourceImageStreamerTest, updateShouldDropUnusedImagesFirst)
+    {
+        ImageStreamer streamer(mWorkQueue, makeLoadFullImage(), fullBytes);
+        const osg::ref_ptr<osg::Image> used = &add(streamer, "a.dds");
+        updateUntilLoaded(streamer);
+        const osg::Image& unused = add(streamer, "b.dds");
+        updateUntilLoaded(streamer);
+        EXPECT_EQ(used->s(), fullSize);
+        EXPECT_EQ(unused.s(), lowSize);
+    }
+
+    TEST_F(ResourceImageStreamerTest, updateShouldDropLeastRecentlyRequestedImagesFirst)
+    {
+        ImageStreamer streamer(mWorkQueue, makeLoadFullImage(), fullBytes);
+        const osg::Image& a = add(streamer, "a.dds");
+        updateUntilLoaded(streamer);
+        const osg::Image& b = add(streamer, "b.dds");
+        frame(streamer);
+        streamer.request("a.dds");
+        updateUntilLoaded(streamer);
+        EXPECT_EQ(a.s(), fullSize);
+        EXPECT_EQ(b.s(), lowSize);
+    }
+
+    TEST_F(ResourceImageStreamerTest, requestShouldLoadDroppedFullImageAgain)
+    {
+        ImageStreamer streamer(mWorkQueue, makeLoadFullImage(), fullBytes);
+        const osg::Image& a = add(streamer, "a.dds");
+        const osg::Image& b = add(streamer, "b.dds");
+        updateUntilLoaded(streamer);
+        const osg::Image& dropped = a.s() == lowSize ? a : b;
+        const osg::Image& kept = a.s() == lowSize ? b : a;
+        EXPECT_EQ(mLoads, 2);
+        streamer.request(dropped.getFileName());
+        updateUntilLoaded(streamer);
+        EXPECT_EQ(mLoads, 3);
+        EXPECT_EQ(dropped.s(), fullSize);
+        EXPECT_EQ(kept.s(), lowSize);
+    }
+}
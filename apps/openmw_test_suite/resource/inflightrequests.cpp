@@ -0,0 +1,108 @@
+#include <components/resource/inflightrequests.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    TEST(ResourceInFlightRequests, getOrLoadShouldReturnLoadedValue)
+    {
+        InFlightRequests<std::string, int> requests;
+        EXPECT_EQ(requests.getOrLoad("key", [] { return 42; }), 42);
+        EXPECT_EQ(requests.getDeduplicatedCount(), 0);
+    }
+
+    TEST(ResourceInFlightRequests, getOrLoadShouldLoadAgainAfterFinish)
+    {
+        InFlightRequests<std::string, int> requests;
+        int calls = 0;
+        requests.getOrLoad("key", [&] { return ++calls; });
+        EXPECT_EQ(requests.getOrLoad("key", [&] { return ++calls; }), 2);
+    }
+
+    TEST(ResourceInFlightRequests, getOrLoadShouldPropagateException)
+    {
+        InFlightRequests<std::string, int> requests;
+        EXPECT_THROW(requests.getOrLoad("key", []() -> int { throw std::runtime_error("error"); }), std::runtime_error);
+        EXPECT_EQ(requests.getOrLoad("key", [] { return 1; }), 1);
+    }
+
+    TEST(ResourceInFlightRequests, getOrLoadShouldLoadNestedRequestForSameKeyFromSameThread)
+    {
+        InFlightRequests<std::string, int> requests;
+        EXPECT_EQ(requests.getOrLoad("key", [&] { return requests.getOrLoad("key", [] { return 1; }) + 1; }), 2);
+        EXPECT_EQ(requests.getDeduplicatedCount(), 0);
+    }
+
+    TEST(ResourceInFlightRequests, concurrentRequestForSameKeyShouldWaitForFirstOne)
+    {
+        InFlightRequests<std::string, int> requests;
+        std::promise<void> started;
+        std::promise<void> release;
+        std::atomic<int> calls{ 0 };
+        auto loader = [&] {
+            ++calls;
+            started.set_value();
+            release.get_future().wait();
+            return 42;
+        };
+        std::future<int> first = std::async(std::launch::async, [&] { return requests.getOrLoad("key", loader); });
+        started.get_future().wait();
+        std::future<int> second
+            = std::async(std::launch::async, [&] { return requests.getOrLoad("key", [&] { return ++calls; }); });
+        while (requests.getDeduplicatedCount() == 0)
+            std::this_thread::yield();
+        release.set_value();
+        EXPECT_EQ(first.get(), 42);
+        EXPECT_EQ(second.get(), 42);
+        EXPECT_EQ(calls, 1);
+        EXPECT_EQ(requests.getDeduplicatedCount(), 1);
+    }
+
+    TEST(ResourceInFlightRequests, concurrentRequestForSameKeyShouldGetException)
+    {
+        InFlightRequests<std::string, int> requests;
+        std::promise<void> started;
+        std::promise<void> release;
+        auto loader = [&]() -> int {
+            started.set_value();
+            release.get_future().wait();
+            throw std::runtime_error("error");
+        };
+        std::future<int> first = std::async(std::launch::async, [&] { return requests.getOrLoad("key", loader); });
+        started.get_future().wait();
+        std::future<int> second
+            = std::async(std::launch::async, [&] { return requests.getOrLoad("key", [] { return 1; }); });
+        while (requests.getDeduplicatedCount() == 0)
+            std::this_thread::yield();
+        release.set_value();
+        EXPECT_THROW(first.get(), std::runtime_error);
+        EXPECT_THROW(second.get(), std::runtime_error);
+    }
+
+    TEST(ResourceInFlightRequests, concurrentRequestsForDifferentKeysShouldNotWait)
+    {
+        InFlightRequests<std::string, int> requests;
+        std::promise<void> started;
+        std::promise<void> release;
+        auto loader = [&] {
+            started.set_value();
+            release.get_future().wait();
+            return 1;
+        };
+        std::future<int> first = std::async(std::launch::async, [&] { return requests.getOrLoad("a", loader); });
+        started.get_future().wait();
+        EXPECT_EQ(requests.getOrLoad("b", [] { return 2; }), 2);
+        release.set_value();
+        EXPECT_EQ(first.get(), 1);
+        EXPECT_EQ(requests.getDeduplicatedCount(), 0);
+    }
+}
@@ -0,0 +1,130 @@
+#include <components/resource/niffilecache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    struct ResourceNifFileCacheTest : Test
+    {
+        const std::filesystem::path mDirectory = std::filesystem::temp_directory_path()
+            / ("openmw_resource_niffilecache_" + std::string(UnitTest::GetInstance()->current_test_info()->name()));
+        const std::filesystem::path mArchive = mDirectory / "archive.bsa";
+        const std::filesystem::path mOtherArchive = mDirectory / "other.bsa";
+        const std::filesystem::path mCache = mDirectory / "nif";
+        const std::string mContent = std::string("NetImmerse File Format\n\0\1\2", 26);
+
+        ResourceNifFileCacheTest()
+        {
+            std::filesystem::remove_all(mDirectory);
+            std::filesystem::create_directories(mDirectory);
+            writeFile(mArchive, "archive");
+            writeFile(mOtherArchive, "other");
+        }
+
+        ~ResourceNifFileCacheTest() override { std::filesystem::remove_all(mDirectory); }
+
+        static void writeFile(const std::filesystem::path& path, const std::string& content)
+        {
+            std::ofstream(path, std::ios_base::binary) << content;
+        }
+
+        static std::string readStream(std::istream& stream)
+        {
+            return std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        }
+    };
+
+    TEST_F(ResourceNifFileCacheTest, getShouldReturnNullptrForMissingEntry)
+    {
+        const NifFileCache cache(mCache);
+        EXPECT_EQ(cache.get("meshes/a.nif", mArchive), nullptr);
+        EXPECT_EQ(cache.getStats().mMisses, 1);
+    }
+
+    TEST_F(ResourceNifFileCacheTest, getShouldReturnStoredContent)
+    {
+        const NifFileCache cache(mCache);
+        cache.set("meshes/a.nif", mArchive, mContent);
+        const Files::IStreamPtr stream = cache.get("meshes/a.nif", mArchive);
+        ASSERT_NE(stream, nullptr);
+        EXPECT_EQ(readStream(*stream), mContent);
+        EXPECT_EQ(cache.getStats().mHits, 1);
+    }
+
+    TEST_F(ResourceNifFileCacheTest, getShouldReturnContentStoredByOtherInstance)
+    {
+        NifFileCache(mCache).set("meshes/a.nif", mArchive, mContent);
+        const NifFileCache cache(mCache);
+        const Files::IStreamPtr stream = cache.get("meshes/a.nif", mArchive);
+        ASSERT_NE(stream, nullptr);
+        EXPECT_EQ(readStream(*stream), mContent);
+    }
+
+    TEST_F(ResourceNifFileCacheTest, getShouldNormalizeName)
+    {
+        const NifFileCache cache(mCache);
+        cache.set("Meshes\\A.nif", mArchive, mContent);
+        const Files::IStreamPtr stream = cache.get("meshes/a.nif", mArchive);
+        ASSERT_NE(stream, nullptr);
+        EXPECT_EQ(readStream(*stream), mContent);
+    }
+
+    TEST_F(ResourceNifFileCacheTest, getShouldReturnNullptrForOtherArchive)
+    {
+        const NifFileCache cache(mCache);
+        cache.set("meshes/a.nif", mArchive, mContent);
+        EXPECT_EQ(cache.get("meshes/a.nif", mOtherArchive), nullptr);
+    }
+
+    TEST_F(ResourceNifFileCacheTest, getShouldReturnNullptrForModifiedArchive)
+    {
+        NifFileCache(mCache).set("meshes/a.nif", mArchive, mContent);
+        writeFile(mArchive, "modified archive");
+        const NifFileCache cache(mCache);
+        EXPECT_EQ(cache.get("meshes/a.nif", mArchive), nullptr);
+    }
+
+    TEST_F(ResourceNifFileCacheTest, getShouldReadArchiveIdentityOncePerInstance)
+    {
+        const NifFileCache cache(mCache);
+        cache.set("meshes/a.nif", mArchive, mContent);
+        writeFile(mArchive, "modified archive");
+        const Files::IStreamPtr stream = cache.get("meshes/a.nif", mArchive);
+        ASSERT_NE(stream, nullptr);
+        EXPECT_EQ(readStream(*stream), mContent);
+    }
+
+    TEST_F(ResourceNifFileCacheTest, setShouldReplaceExistingEntry)
+    {
+        const NifFileCache cache(mCache);
+        cache.set("meshes/a.nif", mArchive, "first");
+        cache.set("meshes/a.nif", mArchive, mContent);
+        const Files::IStreamPtr stream = cache.get("meshes/a.nif", mArchive);
+        ASSERT_NE(stream, nullptr);
+        EXPECT_EQ(readStream(*stream), mContent);
+    }
+
+    TEST_F(ResourceNifFileCacheTest, setShouldIgnoreNamesOutsideCacheDirectory)
+    {
+        const NifFileCache cache(mCache);
+        cache.set("../a.nif", mArchive, mContent);
+        EXPECT_FALSE(std::filesystem::exists(mDirectory / "a.nif.bin"));
+        EXPECT_EQ(cache.get("../a.nif", mArchive), nullptr);
+    }
+
+    TEST_F(ResourceNifFileCacheTest, getShouldReturnNullptrForCorruptedEntry)
+    {
+        const NifFileCache cache(mCache);
+        cache.set("meshes/a.nif", mArchive, mContent);
+        writeFile(mCache / "meshes/a.nif.bin", "corrupted");
+        EXPECT_EQ(cache.get("meshes/a.nif", mArchive), nullptr);
+    }
+}
@@ -0,0 +1,229 @@
+#include <components/resource/objectcache.hpp>
+
+#include <osg/Object>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace Resource;
+
+    template <class KeyType>
+    void sweep(GenericObjectCache<KeyType>& cache, double referenceTime, double expiryTime)
+    {
+        for (std::size_t i = 0; i < GenericObjectCache<KeyType>::sSweepPeriod; ++i)
+        {
+            cache.updateTimeStampOfObjectsInCacheWithExternalReferences(referenceTime);
+            cache.removeExpiredObjectsInCache(expiryTime);
+        }
+    }
+
+    TEST(ResourceObjectCache, getRefFromObjectCacheShouldReturnNullptrForMissingKey)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        EXPECT_EQ(cache->getRefFromObjectCache("key"), nullptr);
+    }
+
+    TEST(ResourceObjectCache, getRefFromObjectCacheShouldReturnAddedObject)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        osg::ref_ptr<osg::Object> object(new osg::Object);
+        cache->addEntryToObjectCache("key", object.get());
+        EXPECT_EQ(cache->getRefFromObjectCache("key"), object);
+    }
+
+    TEST(ResourceObjectCache, getCacheSizeShouldCountObjectsInAllShards)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        for (int i = 0; i < 100; ++i)
+            cache->addEntryToObjectCache(std::to_string(i), new osg::Object);
+        EXPECT_EQ(cache->getCacheSize(), 100);
+    }
+
+    TEST(ResourceObjectCache, removeFromObjectCacheShouldRemoveOnlyGivenKey)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        cache->addEntryToObjectCache("a", new osg::Object);
+        cache->addEntryToObjectCache("b", new osg::Object);
+        cache->removeFromObjectCache("a");
+        EXPECT_EQ(cache->getRefFromObjectCache("a"), nullptr);
+        EXPECT_NE(cache->getRefFromObjectCache("b"), nullptr);
+    }
+
+    TEST(ResourceObjectCache, clearShouldRemoveAllObjects)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        for (int i = 0; i < 100; ++i)
+            cache->addEntryToObjectCache(std::to_string(i), new osg::Object);
+        cache->clear();
+        EXPECT_EQ(cache->getCacheSize(), 0);
+    }
+
+    TEST(ResourceObjectCache, checkInObjectCacheShouldReturnWhetherObjectIsPresent)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        cache->addEntryToObjectCache("key", new osg::Object);
+        EXPECT_TRUE(cache->checkInObjectCache("key", 1.0));
+        EXPECT_FALSE(cache->checkInObjectCache("other", 1.0));
+    }
+
+    TEST(ResourceObjectCache, fullSweepShouldRemoveExpiredObjectsWithoutExternalReferences)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        for (int i = 0; i < 100; ++i)
+            cache->addEntryToObjectCache(std::to_string(i), new osg::Object, 1.0);
+        sweep(*cache, 10.0, 5.0);
+        EXPECT_EQ(cache->getCacheSize(), 0);
+    }
+
+    TEST(ResourceObjectCache, fullSweepShouldKeepObjectsWithExternalReferences)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        std::vector<osg::ref_ptr<osg::Object>> objects;
+        for (int i = 0; i < 100; ++i)
+        {
+            objects.emplace_back(new osg::Object);
+            cache->addEntryToObjectCache(std::to_string(i), objects.back().get(), 1.0);
+        }
+        sweep(*cache, 10.0, 5.0);
+        EXPECT_EQ(cache->getCacheSize(), 100);
+    }
+
+    TEST(ResourceObjectCache, removeExpiredObjectsInCacheShouldKeepObjectsWithExternalReferencesAndStaleTimeStamp)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        osg::ref_ptr<osg::Object> object(new osg::Object);
+        cache->addEntryToObjectCache("key", object.get(), 1.0);
+        for (std::size_t i = 0; i < ObjectCache::sSweepPeriod; ++i)
+            cache->removeExpiredObjectsInCache(5.0);
+        EXPECT_EQ(cache->getRefFromObjectCache("key"), object);
+    }
+
+    TEST(ResourceObjectCache, fullSweepShouldKeepObjectsWithUninitializedTimeStamp)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        cache->addEntryToObjectCache("key", new osg::Object);
+        sweep(*cache, 10.0, 5.0);
+        EXPECT_EQ(cache->getCacheSize(), 1);
+    }
+
+    TEST(ResourceObjectCache, singleSweepShouldVisitOnlyPartOfCache)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        for (int i = 0; i < 1000; ++i)
+            cache->addEntryToObjectCache(std::to_string(i), new osg::Object, 1.0);
+        cache->updateTimeStampOfObjectsInCacheWithExternalReferences(10.0);
+        cache->removeExpiredObjectsInCache(5.0);
+        EXPECT_GT(cache->getCacheSize(), 0);
+        EXPECT_LT(cache->getCacheSize(), 1000);
+    }
+
+    TEST(ResourceObjectCache, callShouldVisitAllObjects)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        for (int i = 0; i < 100; ++i)
+            cache->addEntryToObjectCache(std::to_string(i), new osg::Object);
+        std::size_t count = 0;
+        auto f = [&](const std::string&, osg::Object*) { ++count; };
+        cache->call(f);
+        EXPECT_EQ(count, 100);
+    }
+
+    std::size_t estimateSize(const osg::Object&)
+    {
+        return 10;
+    }
+
+    TEST(ResourceObjectCache, getCacheBytesShouldBeZeroWithoutSizeEstimator)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        cache->addEntryToObjectCache("key", new osg::Object);
+        EXPECT_EQ(cache->getCacheBytes(), 0);
+    }
+
+    TEST(ResourceObjectCache, getCacheBytesShouldReturnSumOfEstimatedSizes)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        cache->setSizeEstimator(estimateSize);
+        cache->addEntryToObjectCache("a", new osg::Object);
+        cache->addEntryToObjectCache("b", new osg::Object);
+        EXPECT_EQ(cache->getCacheBytes(), 20);
+    }
+
+    TEST(ResourceObjectCache, getCacheBytesShouldNotCountReplacedObjects)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        cache->setSizeEstimator(estimateSize);
+        cache->addEntryToObjectCache("a", new osg::Object);
+        cache->addEntryToObjectCache("a", new osg::Object);
+        EXPECT_EQ(cache->getCacheBytes(), 10);
+    }
+
+    TEST(ResourceObjectCache, getCacheBytesShouldNotCountRemovedObjects)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        cache->setSizeEstimator(estimateSize);
+        cache->addEntryToObjectCache("a", new osg::Object);
+        cache->addEntryToObjectCache("b", new osg::Object, 1.0);
+        cache->addEntryToObjectCache("c", new osg::Object);
+        cache->removeFromObjectCache("a");
+        sweep(*cache, 10.0, 5.0);
+        EXPECT_EQ(cache->getCacheBytes(), 10);
+        cache->clear();
+        EXPECT_EQ(cache->getCacheBytes(), 0);
+    }
+
+    TEST(ResourceObjectCache, collectEvictionCandidatesShouldReturnOnlyUnreferencedObjectsWithTimeStamp)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        cache->setSizeEstimator(estimateSize);
+        osg::ref_ptr<osg::Object> object(new osg::Object);
+        cache->addEntryToObjectCache("referenced", object.get(), 1.0);
+        cache->addEntryToObjectCache("uninitialized", new osg::Object);
+        cache->addEntryToObjectCache("unreferenced", new osg::Object, 2.0);
+        std::vector<CacheEvictionCandidate> candidates;
+        cache->collectEvictionCandidates(candidates);
+        ASSERT_EQ(candidates.size(), 1);
+        EXPECT_EQ(candidates[0].mTimeStamp, 2.0);
+        EXPECT_EQ(candidates[0].mSize, 10);
+    }
+
+    TEST(ResourceObjectCache, evictObjectsInCacheShouldRemoveUnreferencedObjectsUsedAtOrBeforeTimeStamp)
+    {
+        osg::ref_ptr<ObjectCache> cache(new ObjectCache);
+        osg::ref_ptr<osg::Object> object(new osg::Object);
+        cache->addEntryToObjectCache("referenced", object.get(), 1.0);
+        cache->addEntryToObjectCache("old", new osg::Object, 2.0);
+        cache->addEntryToObjectCache("new", new osg::Object, 3.0);
+        EXPECT_EQ(cache->evictObjectsInCache(2.0), 1);
+        EXPECT_EQ(cache->getRefFromObjectCache("old"), nullptr);
+        EXPECT_NE(cache->getRefFromObjectCache("new"), nullptr);
+        EXPECT_EQ(cache->getRefFromObjectCache("referenced"), object);
+    }
+
+    TEST(ResourceObjectCache, shouldSupportTupleKeys)
+    {
+        using Key = std::tuple<osg::Vec2f, float, bool>;
+        osg::ref_ptr<GenericObjectCache<Key>> cache(new GenericObjectCache<Key>);
+        osg::ref_ptr<osg::Object> object(new osg::Object);
+        cache->addEntryToObjectCache(Key(osg::Vec2f(1, 2), 3, true), object.get());
+        EXPECT_EQ(cache->getRefFromObjectCache(Key(osg::Vec2f(1, 2), 3, true)), object);
+        EXPECT_EQ(cache->getRefFromObjectCache(Key(osg::Vec2f(1, 2), 3, false)), nullptr);
+    }
+
+    TEST(ResourceObjectCache, shouldSupportPairKeys)
+    {
+        using Key = std::pair<int, int>;
+        osg::ref_ptr<GenericObjectCache<Key>> cache(new GenericObjectCache<Key>);
+        osg::ref_ptr<osg::Object> object(new osg::Object);
+        cache->addEntryToObjectCache(Key(1, 2), object.get());
+        EXPECT_EQ(cache->getRefFromObjectCache(Key(1, 2)), object);
+        EXPECT_EQ(cache->getRefFromObjectCache(Key(2, 1)), nullptr);
+    }
+}
@@ -0,0 +1,182 @@
+#include <components/sceneutil/workqueue.hpp>
+
+#include <gtest/gtest.h>
+
+#include <functional>
+#include <future>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace SceneUtil;
+
+    struct FunctionWorkItem : WorkItem
+    {
+        std::function<void()> mFunction;
+
+        explicit FunctionWorkItem(std::function<void()> function, WorkItemCategory category = WorkItemCategory::Other)
+            : WorkItem(category)
+            , mFunction(std::move(function))
+        {
+        }
+
+        void doWork() override { mFunction(); }
+    };
+
+    struct BlockingWorkItem : WorkItem
+    {
+        std::promise<void> mStarted;
+        std::shared_future<void> mRelease;
+
+        explicit BlockingWorkItem(std::shared_future<void> release)
+            : mRelease(std::move(release))
+        {
+        }
+
+        void doWork() override
+        {
+            mStarted.set_value();
+            mRelease.wait();
+        }
+    };
+
+    TEST(SceneUtilWorkQueue, shouldProcessAllItems)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(4));
+        std::atomic<int> count{ 0 };
+        std::vector<osg::ref_ptr<WorkItem>> items;
+        for (int i = 0; i < 100; ++i)
+        {
+            items.emplace_back(new FunctionWorkItem([&] { ++count; }));
+            queue->addWorkItem(items.back());
+        }
+        for (const auto& item : items)
+            item->waitTillDone();
+        EXPECT_EQ(count, 100);
+        EXPECT_EQ(queue->getNumItems(), 0);
+    }
+
+    TEST(SceneUtilWorkQueue, shouldStartItemsWithHigherPriorityFirst)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+        std::promise<void> release;
+        osg::ref_ptr<BlockingWorkItem> blocking(new BlockingWorkItem(release.get_future().share()));
+        queue->addWorkItem(blocking);
+        blocking->mStarted.get_future().wait();
+
+        std::mutex mutex;
+        std::vector<int> order;
+        std::vector<osg::ref_ptr<WorkItem>> items;
+        for (int i = 0; i < 5; ++i)
+        {
+            items.emplace_back(new FunctionWorkItem([&, i] {
+                const std::lock_guard lock(mutex);
+                order.push_back(i);
+            }));
+            items.back()->setPriority(static_cast<float>(i % 3));
+            queue->addWorkItem(items.back());
+        }
+        release.set_value();
+        for (const auto& item : items)
+            item->waitTillDone();
+        EXPECT_EQ(order, (std::vector<int>{ 2, 1, 4, 0, 3 }));
+    }
+
+    TEST(SceneUtilWorkQueue, shouldStartFrontItemsFirst)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+        std::promise<void> release;
+        osg::ref_ptr<BlockingWorkItem> blocking(new BlockingWorkItem(release.get_future().share()));
+        queue->addWorkItem(blocking);
+        blocking->mStarted.get_future().wait();
+
+        std::vector<int> order;
+        osg::ref_ptr<WorkItem> back(new FunctionWorkItem([&] { order.push_back(0); }));
+        back->setPriority(10);
+        queue->addWorkItem(back);
+        osg::ref_ptr<WorkItem> front(new FunctionWorkItem([&] { order.push_back(1); }));
+        queue->addWorkItem(front, true);
+        release.set_value();
+        back->waitTillDone();
+        front->waitTillDone();
+        EXPECT_EQ(order, (std::vector<int>{ 1, 0 }));
+    }
+
+    TEST(SceneUtilWorkQueue, shouldRespectPriorityChangedWhileQueued)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+        std::promise<void> release;
+        osg::ref_ptr<BlockingWorkItem> blocking(new BlockingWorkItem(release.get_future().share()));
+        queue->addWorkItem(blocking);
+        blocking->mStarted.get_future().wait();
+
+        std::vector<int> order;
+        osg::ref_ptr<WorkItem> first(new FunctionWorkItem([&] { order.push_back(0); }));
+        osg::ref_ptr<WorkItem> second(new FunctionWorkItem([&] { order.push_back(1); }));
+        queue->addWorkItem(first);
+        queue->addWorkItem(second);
+        second->setPriority(1);
+        release.set_value();
+        first->waitTillDone();
+        second->waitTillDone();
+        EXPECT_EQ(order, (std::vector<int>{ 1, 0 }));
+    }
+
+    TEST(SceneUtilWorkQueue, cancelledItemShouldBeDoneWithoutWork)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+        std::promise<void> release;
+        osg::ref_ptr<BlockingWorkItem> blocking(new BlockingWorkItem(release.get_future().share()));
+        queue->addWorkItem(blocking);
+        blocking->mStarted.get_future().wait();
+
+        bool called = false;
+        osg::ref_ptr<WorkItem> item(new FunctionWorkItem([&] { called = true; }));
+        queue->addWorkItem(item);
+        item->cancel();
+        release.set_value();
+        item->waitTillDone();
+        EXPECT_FALSE(called);
+        EXPECT_EQ(queue->getStats().mCancelled, 1);
+    }
+
+    TEST(SceneUtilWorkQueue, idleThreadShouldStealItemsFromOtherThreads)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(2));
+        std::promise<void> release;
+        osg::ref_ptr<BlockingWorkItem> blocking(new BlockingWorkItem(release.get_future().share()));
+        queue->addWorkItem(blocking);
+        blocking->mStarted.get_future().wait();
+
+        std::vector<osg::ref_ptr<WorkItem>> items;
+        for (int i = 0; i < 10; ++i)
+        {
+            items.emplace_back(new FunctionWorkItem([] {}));
+            queue->addWorkItem(items.back());
+        }
+        for (const auto& item : items)
+            item->waitTillDone();
+        release.set_value();
+        blocking->waitTillDone();
+        EXPECT_GT(queue->getStats().mStolen, 0);
+    }
+
+    TEST(SceneUtilWorkQueue, getStatsShouldReturnQueuedAndActiveItemsPerCategory)
+    {
+        osg::ref_ptr<WorkQueue> queue(new WorkQueue(1));
+        std::promise<void> release;
+        osg::ref_ptr<BlockingWorkItem> blocking(new BlockingWorkItem(release.get_future().share()));
+        queue->addWorkItem(blocking);
+        blocking->mStarted.get_future().wait();
+
+        osg::ref_ptr<WorkItem> item(new FunctionWorkItem([] {}, WorkItemCategory::Cell));
+        queue->addWorkItem(item);
+        const WorkQueueStats stats = queue->getStats();
+        EXPECT_EQ(stats.mCategories[static_cast<std::size_t>(WorkItemCategory::Other)].mActive, 1);
+        EXPECT_EQ(stats.mCategories[static_cast<std::size_t>(WorkItemCategory::Cell)].mQueued, 1);
+        release.set_value();
+        item->waitTillDone();
+    }
+}
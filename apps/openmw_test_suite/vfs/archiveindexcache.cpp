@@ -0,0 +1,99 @@
+#include <components/bsa/bsa_file.hpp>
+#include <components/vfs/archiveindexcache.hpp>
+
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+    using namespace testing;
+    using namespace VFS;
+
+    struct VFSArchiveIndexCacheTest : Test
+    {
+        const std::filesystem::path mDirectory = std::filesystem::temp_directory_path()
+            / ("openmw_vfs_archiveindexcache_" + std::string(UnitTest::GetInstance()->current_test_info()->name()));
+        const std::filesystem::path mArchive = mDirectory / "archive.bsa";
+        const std::filesystem::path mCache = mDirectory / "archiveindex.bin";
+
+        VFSArchiveIndexCacheTest()
+        {
+            std::filesystem::remove_all(mDirectory);
+            std::filesystem::create_directories(mDirectory);
+            Bsa::BSAFile file;
+            file.open(mArchive);
+            std::istringstream first("first");
+            file.addFile("meshes\\a.nif", first);
+            std::istringstream second("second");
+            file.addFile("textures\\b.dds", second);
+        }
+
+        ~VFSArchiveIndexCacheTest() override { std::filesystem::remove_all(mDirectory); }
+    };
+
+    TEST_F(VFSArchiveIndexCacheTest, getShouldReturnNullptrForUnknownArchive)
+    {
+        ArchiveIndexCache cache(mCache);
+        EXPECT_EQ(cache.get(mArchive), nullptr);
+    }
+
+    TEST_F(VFSArchiveIndexCacheTest, shouldRestoreFileTableAfterSave)
+    {
+        Bsa::BSAFile file;
+        file.open(mArchive);
+        {
+            ArchiveIndexCache cache(mCache);
+            cache.set(mArchive, file.saveFileTable());
+            cache.save();
+        }
+        ArchiveIndexCache cache(mCache);
+        const std::vector<std::byte>* const fileTable = cache.get(mArchive);
+        ASSERT_NE(fileTable, nullptr);
+        EXPECT_EQ(cache.getHits(), 1);
+
+        Bsa::BSAFile restored;
+        restored.openWithFileTable(mArchive, *fileTable);
+        ASSERT_EQ(restored.getList().size(), file.getList().size());
+        for (std::size_t i = 0; i < file.getList().size(); ++i)
+        {
+            EXPECT_STREQ(restored.getList()[i].name(), file.getList()[i].name());
+            EXPECT_EQ(restored.getList()[i].offset, file.getList()[i].offset);
+            EXPECT_EQ(restored.getList()[i].fileSize, file.getList()[i].fileSize);
+        }
+        const Files::IStreamPtr stream = restored.getFile(&restored.getList()[0]);
+        std::string content;
+        *stream >> content;
+        EXPECT_EQ(content, "first");
+    }
+
+    TEST_F(VFSArchiveIndexCacheTest, getShouldReturnNullptrForChangedArchive)
+    {
+        Bsa::BSAFile file;
+        file.open(mArchive);
+        {
+            ArchiveIndexCache cache(mCache);
+            cache.set(mArchive, file.saveFileTable());
+            cache.save();
+        }
+        std::ofstream(mArchive, std::ios_base::app | std::ios_base::binary) << "data";
+        ArchiveIndexCache cache(mCache);
+        EXPECT_EQ(cache.get(mArchive), nullptr);
+    }
+
+    TEST_F(VFSArchiveIndexCacheTest, shouldIgnoreInvalidCacheFile)
+    {
+        std::ofstream(mCache, std::ios_base::binary) << "invalid";
+        ArchiveIndexCache cache(mCache);
+        EXPECT_EQ(cache.get(mArchive), nullptr);
+    }
+
+    TEST_F(VFSArchiveIndexCacheTest, openWithFileTableShouldThrowOnInvalidData)
+    {
+        Bsa::BSAFile file;
+        const std::vector<std::byte> fileTable(3, std::byte{ 1 });
+        EXPECT_THROW(file.openWithFileTable(mArchive, fileTable), std::exception);
+    }
+}
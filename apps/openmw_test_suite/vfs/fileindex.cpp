@@ -0,0 +1,89 @@
+#include <components/misc/strings/lower.hpp>
+#include <components/vfs/archive.hpp>
+#include <components/vfs/fileindex.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace testing;
+    using namespace VFS;
+
+    struct TestFile : File
+    {
+        Files::IStreamPtr open() override { return nullptr; }
+
+        std::filesystem::path getPath() override { return {}; }
+    };
+
+    char normalize(char ch)
+    {
+        return ch == '\\' ? '/' : Misc::StringUtils::toLower(ch);
+    }
+
+    struct VFSFileIndexTest : Test
+    {
+        TestFile mFiles[4];
+        FileIndex mIndex;
+
+        VFSFileIndexTest()
+        {
+            mIndex.build({
+                { "meshes/a.nif", &mFiles[0] },
+                { "meshes/b.nif", &mFiles[1] },
+                { "meshes/x/c.nif", &mFiles[2] },
+                { "textures/a.dds", &mFiles[3] },
+            });
+        }
+    };
+
+    TEST_F(VFSFileIndexTest, findShouldReturnFileByNormalizedName)
+    {
+        EXPECT_EQ(mIndex.find("meshes/b.nif"), &mFiles[1]);
+        EXPECT_EQ(mIndex.find("textures/a.dds"), &mFiles[3]);
+    }
+
+    TEST_F(VFSFileIndexTest, findShouldReturnNullptrForMissingName)
+    {
+        EXPECT_EQ(mIndex.find("meshes/c.nif"), nullptr);
+        EXPECT_EQ(mIndex.find("meshes/a.ni"), nullptr);
+        EXPECT_EQ(mIndex.find(""), nullptr);
+    }
+
+    TEST_F(VFSFileIndexTest, findShouldNormalizeNameWithGivenFunction)
+    {
+        EXPECT_EQ(mIndex.find("Meshes\\X\\C.NIF", normalize), &mFiles[2]);
+        EXPECT_EQ(mIndex.find("Meshes\\X\\C.NIF"), nullptr);
+    }
+
+    TEST_F(VFSFileIndexTest, lowerBoundShouldSupportPrefixIteration)
+    {
+        std::vector<std::string> names;
+        for (auto it = mIndex.lowerBound("meshes/"); it != mIndex.lowerBound("meshes0"); ++it)
+            names.push_back(it->first);
+        EXPECT_EQ(names, (std::vector<std::string>{ "meshes/a.nif", "meshes/b.nif", "meshes/x/c.nif" }));
+    }
+
+    TEST(VFSFileIndex, findInEmptyIndexShouldReturnNullptr)
+    {
+        const FileIndex index;
+        EXPECT_EQ(index.find("meshes/a.nif"), nullptr);
+    }
+
+    TEST(VFSFileIndex, shouldFindAllOfManyFiles)
+    {
+        TestFile file;
+        std::map<std::string, File*> files;
+        for (int i = 0; i < 10000; ++i)
+            files.emplace("meshes/" + std::to_string(i) + ".nif", &file);
+        FileIndex index;
+        index.build(std::move(files));
+        ASSERT_EQ(index.size(), 10000);
+        for (int i = 0; i < 10000; ++i)
+            EXPECT_EQ(index.find("meshes/" + std::to_string(i) + ".nif"), &file) << i;
+        EXPECT_EQ(index.find("meshes/10000.nif"), nullptr);
+    }
+}
@@ -24,15 +24,41 @@
 #include "bsa_file.hpp"
 
 #include <components/files/constrainedfilestream.hpp>
+#include <components/files/memorystream.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
 
 #include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <filesystem>
 #include <fstream>
+#include <type_traits>
 
 using namespace Bsa;
 
+namespace
+{
+    template <Serialization::Mode mode>
+    struct BSAFileTableFormat : Serialization::Format<mode, BSAFileTableFormat<mode>>
+    {
+        using Serialization::Format<mode, BSAFileTableFormat<mode>>::operator();
+
+        template <class Visitor, class T>
+        auto operator()(Visitor&& visitor, T& value) const
+            -> std::enable_if_t<std::is_same_v<std::decay_t<T>, BSAFile::FileStruct>>
+        {
+            visitor(*this, value.fileSize);
+            visitor(*this, value.offset);
+            visitor(*this, value.hash.low);
+            visitor(*this, value.hash.high);
+            visitor(*this, value.namesOffset);
+        }
+    };
+}
+
 /// Error handling
 [[noreturn]] void BSAFile::fail(const std::string& msg) const
 {
@@ -251,19 +277,85 @@ void BSAFile::open(const std::filesystem::path& file)
     }
 }
 
+void BSAFile::openWithFileTable(const std::filesystem::path& file, const std::vector<std::byte>& fileTable)
+{
+    if (mIsLoaded)
+        close();
+
+    mFilepath = file;
+    try
+    {
+        loadFileTable(fileTable);
+    }
+    catch (...)
+    {
+        close();
+        throw;
+    }
+    mIsLoaded = true;
+}
+
+std::vector<std::byte> BSAFile::saveFileTable() const
+{
+    constexpr BSAFileTableFormat<Serialization::Mode::Write> format;
+    Serialization::SizeAccumulator sizeAccumulator;
+    format(sizeAccumulator, mStringBuf);
+    format(sizeAccumulator, mFiles);
+    std::vector<std::byte> result(sizeAccumulator.value());
+    Serialization::BinaryWriter writer(result.data(), result.data() + result.size());
+    format(writer, mStringBuf);
+    format(writer, mFiles);
+    return result;
+}
+
+void BSAFile::loadFileTable(const std::vector<std::byte>& data)
+{
+    constexpr BSAFileTableFormat<Serialization::Mode::Read> format;
+    Serialization::BinaryReader reader(data.data(), data.data() + data.size());
+    format(reader, mStringBuf);
+    format(reader, mFiles);
+
+    for (FileStruct& file : mFiles)
+    {
+        if (file.namesOffset >= mStringBuf.size())
+            fail("File table contains names offset outside of names buffer");
+        file.namesBuffer = &mStringBuf;
+    }
+    if (!mStringBuf.empty() && mStringBuf.back() != '\0')
+        fail("File table contains non-zero terminated string");
+}
+
 /// Close the archive, write the updated headers to the file
 void Bsa::BSAFile::close()
 {
     if (mHasChanged)
         writeHeader();
 
+    mMapping = Platform::File::ScopedMapping();
     mFiles.clear();
     mStringBuf.clear();
     mIsLoaded = false;
 }
 
+void Bsa::BSAFile::mapToMemory()
+{
+    if (!mIsLoaded)
+        fail("Unable to map the archive into memory: the archive is not opened");
+
+    Platform::File::ScopedHandle handle = Platform::File::open(mFilepath);
+    const std::size_t size = Platform::File::size(handle);
+    if (size == 0)
+        return;
+    const char* const data = Platform::File::map(handle, size);
+    if (data == nullptr)
+        fail("Unable to map the archive into memory: memory mapping is not supported");
+    mMapping = Platform::File::ScopedMapping(data, size);
+}
+
 Files::IStreamPtr Bsa::BSAFile::getFile(const FileStruct* file)
 {
+    if (mMapping.data() != nullptr && file->offset + file->fileSize <= mMapping.size())
+        return std::make_unique<Files::IMemStream>(mMapping.data() + file->offset, file->fileSize);
     return Files::openConstrainedFileStream(mFilepath, file->offset, file->fileSize);
 }
 
@@ -272,6 +364,9 @@ void Bsa::BSAFile::addFile(const std::string& filename, std::istream& file)
     if (!mIsLoaded)
         fail("Unable to add file " + filename + " the archive is not opened");
 
+    // Offsets are going to change and the file is going to grow
+    mMapping = Platform::File::ScopedMapping();
+
     auto newStartOfDataBuffer = 12 + (12 + 8) * (mFiles.size() + 1) + mStringBuf.size() + filename.size() + 1;
     if (mFiles.empty())
         std::filesystem::resize_file(mFilepath, newStartOfDataBuffer);
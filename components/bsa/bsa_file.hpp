@@ -24,6 +24,7 @@
 #ifndef BSA_BSA_FILE_H
 #define BSA_BSA_FILE_H
 
+#include <cstddef>
 #include <cstdint>
 #include <filesystem>
 #include <string>
@@ -31,6 +32,7 @@
 
 #include <components/files/conversion.hpp>
 #include <components/files/istreamptr.hpp>
+#include <components/platform/file.hpp>
 
 namespace Bsa
 {
@@ -87,6 +89,9 @@ namespace Bsa
         /// Used for error messages
         std::filesystem::path mFilepath;
 
+        /// Read-only view of the whole archive, empty unless mapToMemory() was called
+        Platform::File::ScopedMapping mMapping;
+
         /// Error handling
         [[noreturn]] void fail(const std::string& msg) const;
 
@@ -94,6 +99,9 @@ namespace Bsa
         virtual void readHeader();
         virtual void writeHeader();
 
+        /// Restore header information from data produced by saveFileTable
+        virtual void loadFileTable(const std::vector<std::byte>& data);
+
     public:
         /* -----------------------------------
          * BSA management methods
@@ -113,8 +121,23 @@ namespace Bsa
         /// Open an archive file.
         void open(const std::filesystem::path& file);
 
+        /// Open an archive file using file table stored by saveFileTable instead of reading the archive header.
+        /// @note Throws an exception if the data is invalid, the archive is left closed in that case.
+        void openWithFileTable(const std::filesystem::path& file, const std::vector<std::byte>& fileTable);
+
+        /// Serialize information read from the archive header to be used with openWithFileTable.
+        virtual std::vector<std::byte> saveFileTable() const;
+
         void close();
 
+        /// Map the opened archive into memory. Streams returned by getFile will then read the mapped region
+        /// directly instead of opening the archive file for each entry.
+        /// @note Streams are valid only while the archive is open.
+        /// @note Throws an exception if the archive can not be mapped.
+        void mapToMemory();
+
+        bool isMappedToMemory() const { return mMapping.data() != nullptr; }
+
         /* -----------------------------------
          * Archive file routines
          * -----------------------------------
@@ -138,6 +161,11 @@ namespace Bsa
         {
             return Files::pathToUnicodeString(mFilepath);
         }
+
+        const std::filesystem::path& getPath() const
+        {
+            return mFilepath;
+        }
     };
 
 }
@@ -46,10 +46,80 @@
 #include <components/bsa/memorystream.hpp>
 #include <components/files/constrainedfilestream.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/memorystream.hpp>
 #include <components/misc/strings/lower.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
 
 namespace Bsa
 {
+    namespace
+    {
+        struct CachedFolderRecord
+        {
+            std::uint64_t mHash = 0;
+            std::uint32_t mCount = 0;
+            std::uint64_t mOffset = 0;
+        };
+
+        struct CachedFileRecord
+        {
+            std::uint64_t mFolderHash = 0;
+            std::uint64_t mHash = 0;
+            std::uint32_t mSize = 0;
+            std::uint32_t mOffset = 0;
+        };
+
+        struct CompressedFileTable
+        {
+            std::vector<std::byte> mBase;
+            std::uint8_t mCompressedByDefault = 0;
+            std::uint8_t mEmbeddedFileNames = 0;
+            std::uint32_t mVersion = 0;
+            std::vector<CachedFolderRecord> mFolders;
+            std::vector<CachedFileRecord> mFiles;
+        };
+
+        template <Serialization::Mode mode>
+        struct CompressedFileTableFormat : Serialization::Format<mode, CompressedFileTableFormat<mode>>
+        {
+            using Serialization::Format<mode, CompressedFileTableFormat<mode>>::operator();
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, CachedFolderRecord>>
+            {
+                visitor(*this, value.mHash);
+                visitor(*this, value.mCount);
+                visitor(*this, value.mOffset);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, CachedFileRecord>>
+            {
+                visitor(*this, value.mFolderHash);
+                visitor(*this, value.mHash);
+                visitor(*this, value.mSize);
+                visitor(*this, value.mOffset);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, CompressedFileTable>>
+            {
+                visitor(*this, value.mBase);
+                visitor(*this, value.mCompressedByDefault);
+                visitor(*this, value.mEmbeddedFileNames);
+                visitor(*this, value.mVersion);
+                visitor(*this, value.mFolders);
+                visitor(*this, value.mFiles);
+            }
+        };
+    }
+
     // special marker for invalid records,
     // equal to max uint32_t value
     const uint32_t CompressedBSAFile::sInvalidOffset = std::numeric_limits<uint32_t>::max();
@@ -118,13 +188,27 @@ namespace Bsa
     {
     }
 
-    CompressedBSAFile::~CompressedBSAFile() = default;
+    CompressedBSAFile::~CompressedBSAFile()
+    {
+        if (mDecompressionCache != nullptr)
+            mDecompressionCache->remove(this);
+    }
+
+    void CompressedBSAFile::setDecompressionCache(std::shared_ptr<DecompressionCache> cache)
+    {
+        if (mDecompressionCache != nullptr)
+            mDecompressionCache->remove(this);
+        mDecompressionCache = std::move(cache);
+    }
 
     /// Read header information from the input source
     void CompressedBSAFile::readHeader()
     {
         assert(!mIsLoaded);
 
+        if (mDecompressionCache != nullptr)
+            mDecompressionCache->remove(this);
+
         std::ifstream input(mFilepath, std::ios_base::binary);
 
         // Total archive size
@@ -309,6 +393,61 @@ namespace Bsa
         mIsLoaded = true;
     }
 
+    std::vector<std::byte> CompressedBSAFile::saveFileTable() const
+    {
+        CompressedFileTable table;
+        table.mBase = BSAFile::saveFileTable();
+        table.mCompressedByDefault = mCompressedByDefault;
+        table.mEmbeddedFileNames = mEmbeddedFileNames;
+        table.mVersion = mVersion;
+        for (const auto& [folderHash, folder] : mFolders)
+        {
+            table.mFolders.push_back(CachedFolderRecord{ folderHash, folder.count, folder.offset });
+            for (const auto& [fileHash, file] : folder.files)
+                table.mFiles.push_back(CachedFileRecord{ folderHash, fileHash, file.size, file.offset });
+        }
+
+        constexpr CompressedFileTableFormat<Serialization::Mode::Write> format;
+        Serialization::SizeAccumulator sizeAccumulator;
+        format(sizeAccumulator, table);
+        std::vector<std::byte> result(sizeAccumulator.value());
+        Serialization::BinaryWriter writer(result.data(), result.data() + result.size());
+        format(writer, table);
+        return result;
+    }
+
+    void CompressedBSAFile::loadFileTable(const std::vector<std::byte>& data)
+    {
+        if (mDecompressionCache != nullptr)
+            mDecompressionCache->remove(this);
+
+        CompressedFileTable table;
+        constexpr CompressedFileTableFormat<Serialization::Mode::Read> format;
+        Serialization::BinaryReader reader(data.data(), data.data() + data.size());
+        format(reader, table);
+
+        BSAFile::loadFileTable(table.mBase);
+        mCompressedByDefault = table.mCompressedByDefault != 0;
+        mEmbeddedFileNames = table.mEmbeddedFileNames != 0;
+        mVersion = table.mVersion;
+        mFolders.clear();
+        for (const CachedFolderRecord& folder : table.mFolders)
+        {
+            FolderRecord& record = mFolders[folder.mHash];
+            record.count = folder.mCount;
+            record.offset = folder.mOffset;
+        }
+        for (const CachedFileRecord& file : table.mFiles)
+        {
+            const auto folder = mFolders.find(file.mFolderHash);
+            if (folder == mFolders.end())
+                fail("File table contains file outside of any folder");
+            FileRecord& record = folder->second.files[file.mHash];
+            record.size = file.mSize;
+            record.offset = file.mOffset;
+        }
+    }
+
     CompressedBSAFile::FileRecord CompressedBSAFile::getFileRecord(const std::string& str) const
     {
         for (const auto c : str)
@@ -374,11 +513,46 @@ namespace Bsa
     }
 
     Files::IStreamPtr CompressedBSAFile::getFile(const FileRecord& fileRecord)
+    {
+        const bool compressed = fileRecord.isCompressed(mCompressedByDefault);
+
+        if (compressed && mDecompressionCache != nullptr)
+            return std::make_unique<SharedMemoryInputStream>(
+                mDecompressionCache->get(this, fileRecord.offset, [&] { return readFile(fileRecord); }));
+
+        if (!compressed && mMapping.data() != nullptr)
+        {
+            std::size_t offset = fileRecord.offset;
+            std::size_t size = fileRecord.getSizeWithoutCompressionFlag();
+            if (offset + size > mMapping.size())
+                fail("Archive contains offsets outside itself");
+            if (mEmbeddedFileNames)
+            {
+                // Skip over the embedded file name
+                const std::size_t length = static_cast<unsigned char>(mMapping.data()[offset]) + sizeof(char);
+                if (length > size)
+                    fail("Embedded file name is longer than the file");
+                offset += length;
+                size -= length;
+            }
+            return std::make_unique<Files::IMemStream>(mMapping.data() + offset, size);
+        }
+
+        return std::make_unique<SharedMemoryInputStream>(
+            std::make_shared<const std::vector<char>>(readFile(fileRecord)));
+    }
+
+    std::vector<char> CompressedBSAFile::readFile(const FileRecord& fileRecord) const
     {
         size_t size = fileRecord.getSizeWithoutCompressionFlag();
         size_t uncompressedSize = size;
         bool compressed = fileRecord.isCompressed(mCompressedByDefault);
-        Files::IStreamPtr streamPtr = Files::openConstrainedFileStream(mFilepath, fileRecord.offset, size);
+        const bool mapped = mMapping.data() != nullptr;
+        if (mapped && fileRecord.offset + size > mMapping.size())
+            fail("Archive contains offsets outside itself");
+        Files::IStreamPtr streamPtr = mapped
+            ? std::make_unique<Files::IMemStream>(mMapping.data() + fileRecord.offset, size)
+            : Files::openConstrainedFileStream(mFilepath, fileRecord.offset, size);
         std::istream* fileStream = streamPtr.get();
         if (mEmbeddedFileNames)
         {
@@ -393,7 +567,7 @@ namespace Bsa
             fileStream->read(reinterpret_cast<char*>(&uncompressedSize), sizeof(uint32_t));
             size -= sizeof(uint32_t);
         }
-        auto memoryStreamPtr = std::make_unique<MemoryInputStream>(uncompressedSize);
+        std::vector<char> result(uncompressedSize);
 
         if (compressed)
         {
@@ -403,18 +577,30 @@ namespace Bsa
                 inputStreamBuf.push(boost::iostreams::zlib_decompressor());
                 inputStreamBuf.push(*fileStream);
 
-                boost::iostreams::basic_array_sink<char> sr(memoryStreamPtr->getRawData(), uncompressedSize);
+                boost::iostreams::basic_array_sink<char> sr(result.data(), uncompressedSize);
                 boost::iostreams::copy(inputStreamBuf, sr);
             }
             else // SSE: lz4
             {
-                auto buffer = std::vector<char>(size);
-                fileStream->read(buffer.data(), size);
+                std::vector<char> buffer;
+                const char* compressedData = nullptr;
+                if (mapped)
+                {
+                    // Data left after the embedded name and the uncompressed size
+                    compressedData
+                        = mMapping.data() + fileRecord.offset + fileRecord.getSizeWithoutCompressionFlag() - size;
+                }
+                else
+                {
+                    buffer.resize(size);
+                    fileStream->read(buffer.data(), size);
+                    compressedData = buffer.data();
+                }
                 LZ4F_decompressionContext_t context = nullptr;
                 LZ4F_createDecompressionContext(&context, LZ4F_VERSION);
                 LZ4F_decompressOptions_t options = {};
                 LZ4F_errorCode_t errorCode = LZ4F_decompress(
-                    context, memoryStreamPtr->getRawData(), &uncompressedSize, buffer.data(), &size, &options);
+                    context, result.data(), &uncompressedSize, compressedData, &size, &options);
                 if (LZ4F_isError(errorCode))
                     fail("LZ4 decompression error (file " + Files::pathToUnicodeString(mFilepath)
                         + "): " + LZ4F_getErrorName(errorCode));
@@ -426,10 +612,10 @@ namespace Bsa
         }
         else
         {
-            fileStream->read(memoryStreamPtr->getRawData(), size);
+            fileStream->read(result.data(), size);
         }
 
-        return std::make_unique<Files::StreamWithBuffer<MemoryInputStream>>(std::move(memoryStreamPtr));
+        return result;
     }
 
     BsaVersion CompressedBSAFile::detectVersion(const std::filesystem::path& filePath)
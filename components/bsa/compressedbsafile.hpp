@@ -27,8 +27,11 @@
 #define BSA_COMPRESSED_BSA_FILE_H
 
 #include <map>
+#include <memory>
+#include <vector>
 
 #include <components/bsa/bsa_file.hpp>
+#include <components/bsa/decompressioncache.hpp>
 #include <filesystem>
 
 namespace Bsa
@@ -77,6 +80,8 @@ namespace Bsa
         };
         std::map<std::uint64_t, FolderRecord> mFolders;
 
+        std::shared_ptr<DecompressionCache> mDecompressionCache;
+
         FileRecord getFileRecord(const std::string& str) const;
 
         void getBZString(std::string& str, std::istream& filestream);
@@ -86,21 +91,32 @@ namespace Bsa
         /// https://en.uesp.net/wiki/Tes4Mod:Hash_Calculation.
         static std::uint64_t generateHash(const std::filesystem::path& stem, std::string extension);
         Files::IStreamPtr getFile(const FileRecord& fileRecord);
+        std::vector<char> readFile(const FileRecord& fileRecord) const;
 
     public:
         using BSAFile::getFilename;
+        using BSAFile::getPath;
         using BSAFile::getList;
+        using BSAFile::isMappedToMemory;
+        using BSAFile::mapToMemory;
         using BSAFile::open;
+        using BSAFile::openWithFileTable;
 
         CompressedBSAFile();
         virtual ~CompressedBSAFile();
 
+        /// Keep decompressed files in the given cache, shared with other archives.
+        void setDecompressionCache(std::shared_ptr<DecompressionCache> cache);
+
         // checks version of BSA from file header
         static BsaVersion detectVersion(const std::filesystem::path& filePath);
 
         /// Read header information from the input source
         void readHeader() override;
 
+        void loadFileTable(const std::vector<std::byte>& data) override;
+        std::vector<std::byte> saveFileTable() const override;
+
         Files::IStreamPtr getFile(const char* filePath);
         Files::IStreamPtr getFile(const FileStruct* fileStruct);
         void addFile(const std::string& filename, std::istream& file);
@@ -0,0 +1,122 @@
+#include "decompressioncache.hpp"
+
+#include <exception>
+#include <iterator>
+
+namespace Bsa
+{
+    DecompressionCache::DecompressionCache(std::size_t maxBytes)
+        : mMaxBytes(maxBytes)
+    {
+    }
+
+    DecompressedData DecompressionCache::get(
+        const void* archive, std::uint32_t offset, const std::function<std::vector<char>()>& decompress)
+    {
+        const Key key(archive, offset);
+        std::promise<DecompressedData> promise;
+
+        {
+            std::unique_lock lock(mMutex);
+
+            if (const auto it = mIndex.find(key); it != mIndex.end())
+            {
+                mItems.splice(mItems.begin(), mItems, it->second);
+                ++mStats.mHits;
+                mStats.mBytesSaved += it->second->mData->size();
+                return it->second->mData;
+            }
+
+            if (const auto it = mPending.find(key); it != mPending.end())
+            {
+                const std::shared_future<DecompressedData> pending = it->second;
+                lock.unlock();
+                DecompressedData result = pending.get();
+                lock.lock();
+                ++mStats.mHits;
+                mStats.mBytesSaved += result->size();
+                return result;
+            }
+
+            ++mStats.mMisses;
+            mPending.emplace(key, promise.get_future().share());
+        }
+
+        DecompressedData result;
+
+        try
+        {
+            result = std::make_shared<const std::vector<char>>(decompress());
+        }
+        catch (...)
+        {
+            {
+                const std::lock_guard lock(mMutex);
+                mPending.erase(key);
+            }
+            promise.set_exception(std::current_exception());
+            throw;
+        }
+
+        {
+            const std::lock_guard lock(mMutex);
+            mPending.erase(key);
+            insert(key, result);
+        }
+
+        promise.set_value(result);
+
+        return result;
+    }
+
+    void DecompressionCache::remove(const void* archive)
+    {
+        const std::lock_guard lock(mMutex);
+        const auto begin = mIndex.lower_bound(Key(archive, 0));
+        auto it = begin;
+        for (; it != mIndex.end() && it->first.first == archive; ++it)
+        {
+            mStats.mCachedBytes -= it->second->mData->size();
+            mItems.erase(it->second);
+        }
+        mIndex.erase(begin, it);
+        mStats.mCachedEntries = mItems.size();
+    }
+
+    void DecompressionCache::clear()
+    {
+        const std::lock_guard lock(mMutex);
+        mItems.clear();
+        mIndex.clear();
+        mStats.mCachedBytes = 0;
+        mStats.mCachedEntries = 0;
+    }
+
+    DecompressionCacheStats DecompressionCache::getStats() const
+    {
+        const std::lock_guard lock(mMutex);
+        return mStats;
+    }
+
+    void DecompressionCache::insert(const Key& key, const DecompressedData& data)
+    {
+        if (data->size() > mMaxBytes || mIndex.find(key) != mIndex.end())
+            return;
+
+        mItems.push_front(Item{ key, data });
+        mIndex.emplace(key, mItems.begin());
+        mStats.mCachedBytes += data->size();
+
+        while (mStats.mCachedBytes > mMaxBytes)
+            erase(std::prev(mItems.end()));
+
+        mStats.mCachedEntries = mItems.size();
+    }
+
+    void DecompressionCache::erase(std::list<Item>::iterator it)
+    {
+        mStats.mCachedBytes -= it->mData->size();
+        mIndex.erase(it->mKey);
+        mItems.erase(it);
+    }
+}
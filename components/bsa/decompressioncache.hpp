@@ -0,0 +1,71 @@
+#ifndef OPENMW_COMPONENTS_BSA_DECOMPRESSIONCACHE_H
+#define OPENMW_COMPONENTS_BSA_DECOMPRESSIONCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace Bsa
+{
+    using DecompressedData = std::shared_ptr<const std::vector<char>>;
+
+    struct DecompressionCacheStats
+    {
+        std::size_t mHits = 0;
+        std::size_t mMisses = 0;
+        std::size_t mBytesSaved = 0;
+        std::size_t mCachedBytes = 0;
+        std::size_t mCachedEntries = 0;
+    };
+
+    /// @brief Size-bounded LRU cache of decompressed archive entries shared between archives.
+    /// @par Different entries are decompressed concurrently by the requesting threads. When several threads request
+    /// the same entry at once, only the first one decompresses it and the others wait for the result.
+    /// @note Thread safe.
+    class DecompressionCache
+    {
+    public:
+        explicit DecompressionCache(std::size_t maxBytes);
+
+        /// Get decompressed entry identified by archive and offset, or call decompress to produce it.
+        /// @note Exceptions thrown by decompress are rethrown to all the threads waiting for the entry.
+        DecompressedData get(
+            const void* archive, std::uint32_t offset, const std::function<std::vector<char>()>& decompress);
+
+        /// Drop all entries of the given archive. Has to be called when the archive is closed.
+        void remove(const void* archive);
+
+        void clear();
+
+        DecompressionCacheStats getStats() const;
+
+    private:
+        using Key = std::pair<const void*, std::uint32_t>;
+
+        struct Item
+        {
+            Key mKey;
+            DecompressedData mData;
+        };
+
+        const std::size_t mMaxBytes;
+        mutable std::mutex mMutex;
+        std::list<Item> mItems;
+        std::map<Key, std::list<Item>::iterator> mIndex;
+        std::map<Key, std::shared_future<DecompressedData>> mPending;
+        DecompressionCacheStats mStats;
+
+        void insert(const Key& key, const DecompressedData& data);
+
+        void erase(std::list<Item>::iterator it);
+    };
+}
+
+#endif
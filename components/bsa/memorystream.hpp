@@ -28,6 +28,7 @@
 
 #include <components/files/memorystream.hpp>
 #include <istream>
+#include <memory>
 #include <vector>
 
 namespace Bsa
@@ -53,5 +54,24 @@ namespace Bsa
         char* getRawData() { return this->data(); }
     };
 
+    /**
+        Allows to pass shared memory buffer as Files::IStreamPtr.
+
+        Memory buffer is kept alive as long as the class instance exists.
+     */
+    class SharedMemoryInputStream : public Files::MemBuf, public std::istream
+    {
+    public:
+        explicit SharedMemoryInputStream(std::shared_ptr<const std::vector<char>> buffer)
+            : Files::MemBuf(buffer->data(), buffer->size())
+            , std::istream(static_cast<std::streambuf*>(this))
+            , mBuffer(std::move(buffer))
+        {
+        }
+
+    private:
+        std::shared_ptr<const std::vector<char>> mBuffer;
+    };
+
 }
 #endif
@@ -39,7 +39,8 @@ namespace DetourNavigator
     GenerateNavMeshTile::GenerateNavMeshTile(ESM::RefId worldspace, const TilePosition& tilePosition,
         RecastMeshProvider recastMeshProvider, const AgentBounds& agentBounds,
         const DetourNavigator::Settings& settings, std::weak_ptr<NavMeshTileConsumer> consumer)
-        : mWorldspace(std::move(worldspace))
+        : SceneUtil::WorkItem(SceneUtil::WorkItemCategory::Navigation)
+        , mWorldspace(std::move(worldspace))
         , mTilePosition(tilePosition)
         , mRecastMeshProvider(recastMeshProvider)
         , mAgentBounds(agentBounds)
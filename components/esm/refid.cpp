@@ -1,19 +1,81 @@
 #include "refid.hpp"
 
+#include <array>
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 
 #include "components/misc/strings/algorithm.hpp"
 
 namespace ESM
 {
-    bool RefId::operator==(const RefId& rhs) const
+    namespace
     {
-        return Misc::StringUtils::ciEqual(mId, rhs.mId);
+        std::atomic<std::size_t> sInternedCount{ 0 };
+
+        template <class Data>
+        class InternTable
+        {
+        public:
+            const Data* intern(std::string_view value)
+            {
+                const std::size_t hash = Misc::StringUtils::CiHash()(value);
+                // Strings equal ignoring case have the same hash and go to the same shard
+                Shard& shard = mShards[hash % mShards.size()];
+                {
+                    const std::shared_lock lock(shard.mMutex);
+                    const auto it = shard.mExact.find(value);
+                    if (it != shard.mExact.end())
+                        return it->second.get();
+                }
+                const std::unique_lock lock(shard.mMutex);
+                const auto it = shard.mExact.find(value);
+                if (it != shard.mExact.end())
+                    return it->second.get();
+                auto data = std::make_unique<Data>(Data{ std::string(value), hash, nullptr });
+                const auto canonical = shard.mCanonical.find(value);
+                if (canonical == shard.mCanonical.end())
+                {
+                    data->mCanonical = data.get();
+                    shard.mCanonical.emplace(data->mValue, data.get());
+                }
+                else
+                    data->mCanonical = canonical->second;
+                const Data* const result = data.get();
+                shard.mExact.emplace(result->mValue, std::move(data));
+                ++sInternedCount;
+                return result;
+            }
+
+        private:
+            struct Shard
+            {
+                std::shared_mutex mMutex;
+                // Keys point to the values owned by the entries
+                std::unordered_map<std::string_view, std::unique_ptr<Data>> mExact;
+                std::unordered_map<std::string_view, const Data*, Misc::StringUtils::CiHash,
+                    Misc::StringUtils::CiEqual>
+                    mCanonical;
+            };
+
+            std::array<Shard, 64> mShards;
+        };
+    }
+
+    const RefId::Data* RefId::intern(std::string_view value)
+    {
+        static InternTable<Data> table;
+        return table.intern(value);
     }
 
     bool RefId::operator<(const RefId& rhs) const
     {
-        return Misc::StringUtils::ciLess(mId, rhs.mId);
+        if (getCanonical() == rhs.getCanonical())
+            return false;
+        return Misc::StringUtils::ciLess(getRefIdString(), rhs.getRefIdString());
     }
 
     std::ostream& operator<<(std::ostream& os, const RefId& refId)
@@ -25,7 +87,8 @@ namespace ESM
     RefId RefId::stringRefId(std::string_view id)
     {
         RefId newRefId;
-        newRefId.mId = id;
+        if (!id.empty())
+            newRefId.mData = intern(id);
         return newRefId;
     }
 
@@ -34,15 +97,15 @@ namespace ESM
         return ESM::RefId::stringRefId(ESM4::formIdToString(id));
     }
 
+    std::size_t RefId::getInternedCount()
+    {
+        return sInternedCount.load();
+    }
+
     bool RefId::operator==(std::string_view rhs) const
     {
-        return Misc::StringUtils::ciEqual(mId, rhs);
+        return Misc::StringUtils::ciEqual(getRefIdString(), rhs);
     }
 
     const RefId RefId::sEmpty = {};
 }
-
-std::size_t std::hash<ESM::RefId>::operator()(const ESM::RefId& k) const
-{
-    return Misc::StringUtils::CiHash()(k.getRefIdString());
-}
@@ -1,26 +1,33 @@
 #ifndef OPENMW_COMPONENTS_ESM_REFID_HPP
 #define OPENMW_COMPONENTS_ESM_REFID_HPP
 
+#include <cstddef>
 #include <functional>
 #include <iosfwd>
 #include <string>
 #include <string_view>
 
 #include <components/esm4/formid.hpp>
+#include <components/misc/strings/algorithm.hpp>
 
 namespace ESM
 {
     // RefId is used to represent an Id that identifies an ESM record. These Ids can then be used in
     // ESM::Stores to find the actual record. These Ids can be serialized/de-serialized, stored on disk and remain
     // valid. They are used by ESM files, by records to reference other ESM records.
+    //
+    // Ids are interned in a global thread safe table, RefId is a pointer to the table entry. All Ids equal ignoring
+    // case share a canonical entry, so equality and hashing don't touch the string. The string of an entry keeps the
+    // case it was created with. Entries are never freed.
     struct RefId
     {
         const static RefId sEmpty;
 
-        bool empty() const { return mId.empty(); }
+        bool empty() const { return mData == nullptr; }
 
-        bool operator==(const RefId& rhs) const;
+        bool operator==(const RefId& rhs) const { return getCanonical() == rhs.getCanonical(); }
 
+        // Case insensitive lexicographical order of the strings to keep ordered containers iteration stable
         bool operator<(const RefId& rhs) const;
 
         friend std::ostream& operator<<(std::ostream& os, const RefId& dt);
@@ -30,10 +37,35 @@ namespace ESM
         // very clear where in the code we need to convert from string to RefId and Vice versa.
         static RefId stringRefId(std::string_view id);
         static RefId formIdRefId(const ESM4::FormId id);
-        const std::string& getRefIdString() const { return mId; }
+
+        const std::string& getRefIdString() const
+        {
+            static const std::string empty;
+            return mData == nullptr ? empty : mData->mValue;
+        }
+
+        std::size_t getHash() const { return mData == nullptr ? sEmptyHash : mData->mHash; }
+
+        // Number of distinct strings interned so far
+        static std::size_t getInternedCount();
 
     private:
-        std::string mId;
+        struct Data
+        {
+            std::string mValue;
+            // Case insensitive hash of mValue
+            std::size_t mHash;
+            // First interned entry with mValue equal ignoring case, may point to itself
+            const Data* mCanonical;
+        };
+
+        static constexpr std::size_t sEmptyHash = Misc::StringUtils::CiHash()("");
+
+        const Data* mData = nullptr;
+
+        static const Data* intern(std::string_view value);
+
+        const Data* getCanonical() const { return mData == nullptr ? nullptr : mData->mCanonical; }
 
         bool operator==(std::string_view rhs) const;
 
@@ -52,7 +84,7 @@ namespace std
     template <>
     struct hash<ESM::RefId>
     {
-        std::size_t operator()(const ESM::RefId& k) const;
+        std::size_t operator()(const ESM::RefId& k) const { return k.getHash(); }
     };
 }
 #endif
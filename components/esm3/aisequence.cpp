@@ -50,11 +50,11 @@ namespace ESM
         void AiEscort::load(ESMReader& esm)
         {
             esm.getHNT(mData, "DATA");
-            mTargetId = ESM::RefId::stringRefId(esm.getHNString("TARG"));
+            mTargetId = esm.getHNRefId("TARG");
             mTargetActorId = -1;
             esm.getHNOT(mTargetActorId, "TAID");
             esm.getHNT(mRemainingDuration, "DURA");
-            mCellId = ESM::RefId::stringRefId(esm.getHNOString("CELL"));
+            mCellId = esm.getHNORefId("CELL");
             mRepeat = false;
             esm.getHNOT(mRepeat, "REPT");
             if (esm.getFormat() < 18)
@@ -82,11 +82,11 @@ namespace ESM
         void AiFollow::load(ESMReader& esm)
         {
             esm.getHNT(mData, "DATA");
-            mTargetId = ESM::RefId::stringRefId(esm.getHNString("TARG"));
+            mTargetId = esm.getHNRefId("TARG");
             mTargetActorId = -1;
             esm.getHNOT(mTargetActorId, "TAID");
             esm.getHNT(mRemainingDuration, "DURA");
-            mCellId = ESM::RefId::stringRefId(esm.getHNOString("CELL"));
+            mCellId = esm.getHNORefId("CELL");
             esm.getHNT(mAlwaysFollow, "ALWY");
             mCommanded = false;
             esm.getHNOT(mCommanded, "CMND");
@@ -122,7 +122,7 @@ namespace ESM
 
         void AiActivate::load(ESMReader& esm)
         {
-            mTargetId = ESM::RefId::stringRefId(esm.getHNString("TARG"));
+            mTargetId = esm.getHNRefId("TARG");
             mRepeat = false;
             esm.getHNOT(mRepeat, "REPT");
         }
@@ -10,7 +10,7 @@ namespace ESM
 
     void CellId::load(ESMReader& esm)
     {
-        mWorldspace = ESM::RefId::stringRefId(esm.getHNString("SPAC"));
+        mWorldspace = esm.getHNRefId("SPAC");
 
         if (esm.isNextSub("CIDX"))
         {
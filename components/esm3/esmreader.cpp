@@ -2,9 +2,12 @@
 
 #include "readerscache.hpp"
 
+#include <components/debug/debuglog.hpp>
 #include <components/files/conversion.hpp>
+#include <components/files/memorystream.hpp>
 #include <components/files/openfile.hpp>
 #include <components/misc/strings/algorithm.hpp>
+#include <components/platform/file.hpp>
 
 #include <filesystem>
 #include <fstream>
@@ -13,6 +16,43 @@
 
 namespace ESM
 {
+    namespace
+    {
+        class MappedFileStream : public Files::IMemStream
+        {
+        public:
+            explicit MappedFileStream(std::shared_ptr<const Platform::File::ScopedMapping> mapping)
+                : Files::MemBuf(mapping->data(), mapping->size())
+                , Files::IMemStream(mapping->data(), mapping->size())
+                , mMapping(std::move(mapping))
+            {
+            }
+
+        private:
+            std::shared_ptr<const Platform::File::ScopedMapping> mMapping;
+        };
+
+        std::shared_ptr<const Platform::File::ScopedMapping> mapFile(const std::filesystem::path& path)
+        {
+            try
+            {
+                Platform::File::ScopedHandle handle = Platform::File::open(path);
+                const std::size_t size = Platform::File::size(handle);
+                if (size == 0)
+                    return nullptr;
+                const char* const data = Platform::File::map(handle, size);
+                if (data == nullptr)
+                    return nullptr;
+                return std::make_shared<const Platform::File::ScopedMapping>(data, size);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Verbose) << "Failed to map " << path << " into memory, falling back to reading: "
+                                    << e.what();
+                return nullptr;
+            }
+        }
+    }
 
     ESM_Context ESMReader::getContext()
     {
@@ -46,7 +86,9 @@ namespace ESM
 
     void ESMReader::close()
     {
+        mMemStream = nullptr;
         mEsm.reset();
+        mMapping.reset();
         clearCtx();
         mHeader.blank();
     }
@@ -97,13 +139,30 @@ namespace ESM
 
     void ESMReader::openRaw(const std::filesystem::path& filename)
     {
-        openRaw(Files::openBinaryInputFileStream(filename), filename);
+        if (auto mapping = mapFile(filename))
+            openRaw(std::move(mapping), filename);
+        else
+            openRaw(Files::openBinaryInputFileStream(filename), filename);
+    }
+
+    void ESMReader::openRaw(
+        std::shared_ptr<const Platform::File::ScopedMapping> mapping, const std::filesystem::path& name)
+    {
+        auto stream = std::make_unique<MappedFileStream>(mapping);
+        Files::IMemStream* const memStream = stream.get();
+        openRaw(std::move(stream), name);
+        mMapping = std::move(mapping);
+        mMemStream = memStream;
     }
 
     void ESMReader::open(std::unique_ptr<std::istream>&& stream, const std::filesystem::path& name)
     {
         openRaw(std::move(stream), name);
+        readHeader();
+    }
 
+    void ESMReader::readHeader()
+    {
         if (getRecName() != "TES3")
             fail("Not a valid Morrowind file");
 
@@ -114,7 +173,15 @@ namespace ESM
 
     void ESMReader::open(const std::filesystem::path& file)
     {
-        open(Files::openBinaryInputFileStream(file), file);
+        openRaw(file);
+        readHeader();
+    }
+
+    void ESMReader::open(
+        std::shared_ptr<const Platform::File::ScopedMapping> mapping, const std::filesystem::path& name)
+    {
+        openRaw(std::move(mapping), name);
+        readHeader();
     }
 
     std::string ESMReader::getHNOString(NAME name)
@@ -143,28 +210,29 @@ namespace ESM
         return getHString();
     }
 
+    ESM::RefId ESMReader::getHNRefId(NAME name)
+    {
+        getSubNameIs(name);
+        return getRefId();
+    }
+
     std::string ESMReader::getHString()
     {
-        getSubHeader();
+        return std::string(getHStringView());
+    }
 
-        // Hack to make MultiMark.esp load. Zero-length strings do not
-        // occur in any of the official mods, but MultiMark makes use of
-        // them. For some reason, they break the rules, and contain a byte
-        // (value 0) even if the header says there is no data. If
-        // Morrowind accepts it, so should we.
-        if (mCtx.leftSub == 0 && hasMoreSubs() && !mEsm->peek())
-        {
-            // Skip the following zero byte
-            mCtx.leftRec--;
-            char c;
-            getT(c);
-            return std::string();
-        }
+    RefId ESMReader::getRefId()
+    {
+        return ESM::RefId::stringRefId(getHStringView());
+    }
 
-        return getString(mCtx.leftSub);
+    std::string_view ESMReader::getHNStringView(NAME name)
+    {
+        getSubNameIs(name);
+        return getHStringView();
     }
 
-    RefId ESMReader::getRefId()
+    std::string_view ESMReader::getHStringView()
     {
         getSubHeader();
 
@@ -179,10 +247,10 @@ namespace ESM
             mCtx.leftRec--;
             char c;
             getT(c);
-            return ESM::RefId::sEmpty;
+            return {};
         }
 
-        return getRefId(mCtx.leftSub);
+        return getStringView(mCtx.leftSub);
     }
 
     void ESMReader::skipHString()
@@ -361,30 +429,29 @@ namespace ESM
 
     std::string ESMReader::getString(int size)
     {
-        size_t s = size;
-        if (mBuffer.size() <= s)
-            // Add some extra padding to reduce the chance of having to resize
-            // again later.
-            mBuffer.resize(3 * s);
-
-        // And make sure the string is zero terminated
-        mBuffer[s] = 0;
-
-        // read ESM data
-        char* ptr = mBuffer.data();
-        getExact(ptr, size);
-
-        size = static_cast<int>(strnlen(ptr, size));
-
-        // Convert to UTF8 and return
-        if (mEncoder)
-            return std::string(mEncoder->getUtf8(std::string_view(ptr, size)));
-
-        return std::string(ptr, size);
+        return std::string(getStringView(size));
     }
 
     ESM::RefId ESMReader::getRefId(int size)
     {
+        return ESM::RefId::stringRefId(getStringView(size));
+    }
+
+    std::string_view ESMReader::getStringView(int size)
+    {
+        if (mMemStream != nullptr)
+        {
+            // Point directly to the mapped file
+            const char* const ptr = mMemStream->getCurrent();
+            if (size < 0 || mMemStream->getEnd() - ptr < size)
+                fail("Unexpected end of file reading a string of " + std::to_string(size) + " bytes");
+            mEsm->seekg(size, std::ios_base::cur);
+            const std::string_view value(ptr, strnlen(ptr, size));
+            if (mEncoder)
+                return mEncoder->getUtf8(value);
+            return value;
+        }
+
         size_t s = size;
         if (mBuffer.size() <= s)
             // Add some extra padding to reduce the chance of having to resize
@@ -402,9 +469,9 @@ namespace ESM
 
         // Convert to UTF8 and return
         if (mEncoder)
-            return ESM::RefId::stringRefId(mEncoder->getUtf8(std::string_view(ptr, size)));
+            return mEncoder->getUtf8(std::string_view(ptr, size));
 
-        return ESM::RefId::stringRefId(std::string_view(ptr, size));
+        return std::string_view(ptr, size);
     }
 
     [[noreturn]] void ESMReader::fail(const std::string& msg)
@@ -5,6 +5,7 @@
 #include <filesystem>
 #include <istream>
 #include <memory>
+#include <string_view>
 #include <vector>
 
 #include <components/to_utf8/to_utf8.hpp>
@@ -13,6 +14,16 @@
 #include "components/esm/refid.hpp"
 #include "loadtes3.hpp"
 
+namespace Files
+{
+    struct IMemStream;
+}
+
+namespace Platform::File
+{
+    class ScopedMapping;
+}
+
 namespace ESM
 {
 
@@ -69,10 +80,21 @@ namespace ESM
         /// currently open file first, if any.
         void open(std::unique_ptr<std::istream>&& stream, const std::filesystem::path& name);
 
+        /// Opens the file mapped into memory when possible, so seeking and skipping don't touch the file and
+        /// strings are read without copying.
         void open(const std::filesystem::path& file);
 
         void openRaw(const std::filesystem::path& filename);
 
+        /// Open a file already mapped into memory, see getMapping().
+        void open(std::shared_ptr<const Platform::File::ScopedMapping> mapping, const std::filesystem::path& name);
+
+        void openRaw(std::shared_ptr<const Platform::File::ScopedMapping> mapping, const std::filesystem::path& name);
+
+        /// Memory mapping of the opened file or nullptr if the file is read from a stream. Keeping the mapping
+        /// allows to reopen the file without touching the file system.
+        const std::shared_ptr<const Platform::File::ScopedMapping>& getMapping() const { return mMapping; }
+
         /// Get the current position in the file. Make sure that the file has been opened!
         size_t getFileOffset() const { return mEsm->tellg(); }
 
@@ -171,11 +193,17 @@ namespace ESM
 
         // Read a string with the given sub-record name
         std::string getHNString(NAME name);
+        ESM::RefId getHNRefId(NAME name);
 
         // Read a string, including the sub-record header (but not the name)
         std::string getHString();
         RefId getRefId();
 
+        // Same as getHNString and getHString but return a view to the internal buffer valid until the next read. Use
+        // to parse or compare a string without allocating memory.
+        std::string_view getHNStringView(NAME name);
+        std::string_view getHStringView();
+
         void skipHString();
 
         // Read the given number of bytes from a subrecord
@@ -274,10 +302,13 @@ namespace ESM
         std::string getString(int size);
         ESM::RefId getRefId(int size);
 
+        // Same as getString but returns a view to the internal buffer valid until the next read.
+        std::string_view getStringView(int size);
+
         void skip(std::size_t bytes)
         {
             char buffer[4096];
-            if (bytes > std::size(buffer))
+            if (mMemStream != nullptr || bytes > std::size(buffer))
                 mEsm->seekg(getFileOffset() + bytes);
             else
                 mEsm->read(buffer, bytes);
@@ -289,6 +320,8 @@ namespace ESM
         /// Sets font encoder for ESM strings
         void setEncoder(ToUTF8::Utf8Encoder* encoder) { mEncoder = encoder; }
 
+        ToUTF8::Utf8Encoder* getEncoder() const { return mEncoder; }
+
         /// Get record flags of last record
         unsigned int getRecordFlags() { return mRecordFlags; }
 
@@ -302,8 +335,15 @@ namespace ESM
 
         void clearCtx();
 
+        void readHeader();
+
         std::unique_ptr<std::istream> mEsm;
 
+        std::shared_ptr<const Platform::File::ScopedMapping> mMapping;
+
+        // Set when mEsm reads from mMapping
+        Files::IMemStream* mMemStream = nullptr;
+
         ESM_Context mCtx;
 
         unsigned int mRecordFlags;
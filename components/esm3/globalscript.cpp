@@ -8,7 +8,7 @@ namespace ESM
 
     void GlobalScript::load(ESMReader& esm)
     {
-        mId = ESM::RefId::stringRefId(esm.getHNString("NAME"));
+        mId = esm.getHNRefId("NAME");
 
         mLocals.load(esm);
 
@@ -16,7 +16,7 @@ namespace ESM
         esm.getHNOT(mRunning, "RUN_");
 
         mTargetRef = RefNum{};
-        mTargetId = ESM::RefId::stringRefId(esm.getHNOString("TARG"));
+        mTargetId = esm.getHNORefId("TARG");
         if (esm.peekNextSub("FRMR"))
             mTargetRef.load(esm, true, "FRMR");
     }
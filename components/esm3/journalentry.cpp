@@ -9,8 +9,8 @@ namespace ESM
     void JournalEntry::load(ESMReader& esm)
     {
         esm.getHNOT(mType, "JETY");
-        mTopic = ESM::RefId::stringRefId(esm.getHNString("YETO"));
-        mInfo = ESM::RefId::stringRefId(esm.getHNString("YEIN"));
+        mTopic = esm.getHNRefId("YETO");
+        mInfo = esm.getHNRefId("YEIN");
         mText = esm.getHNString("TEXT");
 
         if (mType == Type_Journal)
@@ -10,8 +10,8 @@ namespace ESM
     {
         PartReference pr;
         esm.getHT(pr.mPart); // The INDX byte
-        pr.mMale = ESM::RefId::stringRefId(esm.getHNOString("BNAM"));
-        pr.mFemale = ESM::RefId::stringRefId(esm.getHNOString("CNAM"));
+        pr.mMale = esm.getHNORefId("BNAM");
+        pr.mFemale = esm.getHNORefId("CNAM");
         mParts.push_back(pr);
     }
 
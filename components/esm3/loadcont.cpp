@@ -12,7 +12,7 @@ namespace ESM
         esm.getSubHeader();
         ContItem ci;
         esm.getT(ci.mCount);
-        ci.mItem = ESM::RefId::stringRefId(esm.getString(32));
+        ci.mItem = esm.getRefId(32);
         mList.push_back(ci);
     }
 
@@ -14,7 +14,7 @@ namespace ESM
 
     void Dialogue::loadId(ESMReader& esm)
     {
-        mId = ESM::RefId::stringRefId(esm.getHNString("NAME"));
+        mId = esm.getHNRefId("NAME");
     }
 
     void Dialogue::loadData(ESMReader& esm, bool& isDeleted)
@@ -10,7 +10,7 @@ namespace ESM
         isDeleted = false;
         mRecordFlags = esm.getRecordFlags();
 
-        mId = ESM::RefId::stringRefId(esm.getHNString("NAME"));
+        mId = esm.getHNRefId("NAME");
 
         if (esm.isNextSub("DELE"))
         {
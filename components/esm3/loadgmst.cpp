@@ -10,7 +10,7 @@ namespace ESM
         isDeleted = false; // GameSetting record can't be deleted now (may be changed in the future)
         mRecordFlags = esm.getRecordFlags();
 
-        mId = ESM::RefId::stringRefId(esm.getHNString("NAME"));
+        mId = esm.getHNRefId("NAME");
         mValue.read(esm, Variant::Format_Gmst);
     }
 
@@ -7,15 +7,15 @@ namespace ESM
 {
     void DialInfo::load(ESMReader& esm, bool& isDeleted)
     {
-        mId = ESM::RefId::stringRefId(esm.getHNString("INAM"));
+        mId = esm.getHNRefId("INAM");
 
         isDeleted = false;
 
         mQuestStatus = QS_None;
         mFactionLess = false;
 
-        mPrev = ESM::RefId::stringRefId(esm.getHNString("PNAM"));
-        mNext = ESM::RefId::stringRefId(esm.getHNString("NNAM"));
+        mPrev = esm.getHNRefId("PNAM");
+        mNext = esm.getHNRefId("NNAM");
 
         while (esm.hasMoreSubs())
         {
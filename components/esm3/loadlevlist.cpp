@@ -43,7 +43,7 @@ namespace ESM
                     for (size_t i = 0; i < mList.size(); i++)
                     {
                         LevelItem& li = mList[i];
-                        li.mId = ESM::RefId::stringRefId(esm.getHNString(recName));
+                        li.mId = esm.getHNRefId(recName);
                         esm.getHNT(li.mLevel, "INTV");
                     }
 
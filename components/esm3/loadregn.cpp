@@ -53,7 +53,7 @@ namespace ESM
                 {
                     esm.getSubHeader();
                     SoundRef sr;
-                    sr.mSound = ESM::RefId::stringRefId(esm.getString(32));
+                    sr.mSound = esm.getRefId(32);
                     esm.getT(sr.mChance);
                     mSoundList.push_back(sr);
                     break;
@@ -98,7 +98,7 @@ namespace ESM
                 case fourCC("SCHD"):
                 {
                     esm.getSubHeader();
-                    mId = ESM::RefId::stringRefId(esm.getString(32));
+                    mId = esm.getRefId(32);
                     esm.getT(mData);
 
                     hasHeader = true;
@@ -16,7 +16,7 @@ namespace ESM
 
     void BaseProjectileState::load(ESMReader& esm)
     {
-        mId = ESM::RefId::stringRefId(esm.getHNString("ID__"));
+        mId = esm.getHNRefId("ID__");
         esm.getHNT(mPosition, "VEC3");
         esm.getHNT(mOrientation, "QUAT");
         esm.getHNT(mActorId, "ACTO");
@@ -35,7 +35,7 @@ namespace ESM
     {
         BaseProjectileState::load(esm);
 
-        mSpellId = ESM::RefId::stringRefId(esm.getHNString("SPEL"));
+        mSpellId = esm.getHNRefId("SPEL");
         if (esm.isNextSub("SRCN")) // for backwards compatibility
             esm.skipHSub();
         EffectList().load(esm); // for backwards compatibility
@@ -63,7 +63,7 @@ namespace ESM
     {
         BaseProjectileState::load(esm);
 
-        mBowId = ESM::RefId::stringRefId(esm.getHNString("BOW_"));
+        mBowId = esm.getHNRefId("BOW_");
         esm.getHNT(mVelocity, "VEL_");
 
         mAttackStrength = 1.f;
@@ -8,7 +8,7 @@ namespace ESM
 
     void QuestState::load(ESMReader& esm)
     {
-        mTopic = ESM::RefId::stringRefId(esm.getHNString("YETO"));
+        mTopic = esm.getHNRefId("YETO");
         esm.getHNOT(mState, "QSTA");
         esm.getHNOT(mFinished, "QFIN");
     }
@@ -45,8 +45,12 @@ namespace ESM
                     it = indexIt->second;
                     if (it->mName.has_value())
                     {
-                        it->mReader.open(*it->mName);
+                        if (it->mMapping != nullptr)
+                            it->mReader.open(std::move(it->mMapping), *it->mName);
+                        else
+                            it->mReader.open(*it->mName);
                         it->mName.reset();
+                        it->mMapping.reset();
                     }
                     mBusyItems.splice(mBusyItems.end(), mClosedItems, it);
                     break;
@@ -65,6 +69,7 @@ namespace ESM
             if (it->mReader.isOpen())
             {
                 it->mName = it->mReader.getName();
+                it->mMapping = it->mReader.getMapping();
                 it->mReader.close();
             }
             mClosedItems.splice(mClosedItems.end(), mFreeItems, it);
@@ -6,6 +6,7 @@
 #include <cstddef>
 #include <list>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
 
@@ -26,6 +27,8 @@ namespace ESM
             State mState = State::Busy;
             ESMReader mReader;
             std::optional<std::filesystem::path> mName;
+            // Mapping of the closed file to reopen it without touching the file system
+            std::shared_ptr<const Platform::File::ScopedMapping> mMapping;
 
             Item() = default;
         };
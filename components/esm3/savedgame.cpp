@@ -13,10 +13,10 @@ namespace ESM
         mPlayerName = esm.getHNString("PLNA");
         esm.getHNOT(mPlayerLevel, "PLLE");
 
-        mPlayerClassId = ESM::RefId::stringRefId(esm.getHNOString("PLCL"));
+        mPlayerClassId = esm.getHNORefId("PLCL");
         mPlayerClassName = esm.getHNOString("PLCN");
 
-        mPlayerCell = ESM::RefId::stringRefId(esm.getHNString("PLCE"));
+        mPlayerCell = esm.getHNRefId("PLCE");
         esm.getHNTSized<16>(mInGameTime, "TSTM");
         esm.getHNT(mTimePlayed, "TIME");
         mDescription = esm.getHNString("DESC");
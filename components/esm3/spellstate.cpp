@@ -93,7 +93,7 @@ namespace ESM
             mUsedPowers[id] = time;
         }
 
-        mSelectedSpell = ESM::RefId::stringRefId(esm.getHNOString("SLCT"));
+        mSelectedSpell = esm.getHNORefId("SLCT");
     }
 
     void SpellState::save(ESMWriter& esm) const
@@ -78,7 +78,7 @@ namespace ESM
 
         if (format == Format_Global)
         {
-            std::string typeId = esm.getHNString("FNAM");
+            const std::string_view typeId = esm.getHNStringView("FNAM");
 
             if (typeId == "s")
                 type = VT_Short;
@@ -87,7 +87,7 @@ namespace ESM
             else if (typeId == "f")
                 type = VT_Float;
             else
-                esm.fail("illegal global variable type " + typeId);
+                esm.fail("illegal global variable type " + std::string(typeId));
         }
         else if (format == Format_Gmst)
         {
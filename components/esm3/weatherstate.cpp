@@ -25,7 +25,7 @@ namespace ESM
 {
     void WeatherState::load(ESMReader& esm)
     {
-        mCurrentRegion = ESM::RefId::stringRefId(esm.getHNString(currentRegionRecord));
+        mCurrentRegion = esm.getHNRefId(currentRegionRecord);
         esm.getHNT(mTimePassed, timePassedRecord);
         esm.getHNT(mFastForward, fastForwardRecord);
         esm.getHNT(mWeatherUpdateTime, weatherUpdateTimeRecord);
@@ -3,6 +3,7 @@
 
 #include <extern/smhasher/MurmurHash3.h>
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <istream>
@@ -40,4 +41,18 @@ namespace Files
         }
         return hash;
     }
+
+    std::array<std::uint64_t, 2> getHash(std::string_view content)
+    {
+        constexpr std::size_t blockSize = 4096;
+        std::array<std::uint64_t, 2> hash{ 0, 0 };
+        for (std::size_t offset = 0; offset < content.size(); offset += blockSize)
+        {
+            const std::size_t size = std::min(blockSize, content.size() - offset);
+            std::array<std::uint64_t, 2> blockHash{ 0, 0 };
+            MurmurHash3_x64_128(content.data() + offset, static_cast<int>(size), hash.data(), blockHash.data());
+            hash = blockHash;
+        }
+        return hash;
+    }
 }
@@ -31,6 +31,12 @@ namespace Files
             return seekoff(pos, std::ios_base::beg, which);
         }
 
+        /// Get pointer to the unread part of the buffer
+        const char* getCurrent() const { return gptr(); }
+
+        /// Get pointer past the end of the buffer
+        const char* getEnd() const { return egptr(); }
+
     protected:
         char* bufferStart;
         char* bufferEnd;
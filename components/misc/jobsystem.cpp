@@ -0,0 +1,180 @@
+#include "jobsystem.hpp"
+
+#include <components/debug/debuglog.hpp>
+
+#include <algorithm>
+
+namespace Misc
+{
+    bool JobHandle::isDone() const
+    {
+        const std::lock_guard lock(mState->mMutex);
+        return mState->mDone;
+    }
+
+    void JobHandle::wait() const
+    {
+        std::unique_lock lock(mState->mMutex);
+        mState->mCondition.wait(lock, [&] { return mState->mDone; });
+        if (mState->mException != nullptr)
+            std::rethrow_exception(mState->mException);
+    }
+
+    JobSystem::JobSystem(std::size_t threads)
+        : mThreadJobs(threads)
+    {
+        mThreads.reserve(threads);
+        for (std::size_t i = 0; i < threads; ++i)
+            mThreads.emplace_back([this, i] { work(i); });
+        Log(Debug::Info) << "Using " << threads << " job threads";
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            const std::lock_guard lock(mMutex);
+            mShouldStop = true;
+        }
+        mHasJob.notify_all();
+        for (std::thread& thread : mThreads)
+            thread.join();
+    }
+
+    std::size_t JobSystem::getDefaultThreadsCount(std::size_t hardwareThreads, std::size_t reservedThreads)
+    {
+        if (hardwareThreads <= reservedThreads)
+            return 1;
+        return hardwareThreads - reservedThreads;
+    }
+
+    JobSubsystem JobSystem::registerSubsystem(const std::string& name)
+    {
+        const std::lock_guard lock(mMutex);
+        mSubsystems.push_back(name);
+        return mSubsystems.size() - 1;
+    }
+
+    std::vector<std::string> JobSystem::getSubsystemNames() const
+    {
+        const std::lock_guard lock(mMutex);
+        return mSubsystems;
+    }
+
+    JobHandle JobSystem::submit(JobSubsystem subsystem, std::function<void()> job, std::size_t affinity)
+    {
+        JobHandle handle;
+        handle.mState = std::make_shared<JobHandle::State>();
+        Job value{ subsystem, std::move(job), handle.mState };
+        if (mThreads.empty())
+        {
+            execute(value, anyJobThread);
+            return handle;
+        }
+        {
+            const std::lock_guard lock(mMutex);
+            if (affinity == anyJobThread)
+                mJobs.push_back(std::move(value));
+            else
+                mThreadJobs[affinity % mThreads.size()].push_back(std::move(value));
+        }
+        // Notify all to wake up the thread a job with affinity is waiting for
+        if (affinity == anyJobThread)
+            mHasJob.notify_one();
+        else
+            mHasJob.notify_all();
+        return handle;
+    }
+
+    void JobSystem::run(JobSubsystem subsystem, const std::function<void()>& job)
+    {
+        const Clock::time_point begin = Clock::now();
+        job();
+        const Clock::time_point end = Clock::now();
+        const std::lock_guard lock(mMutex);
+        mTimeline.push_back(JobTimelineEntry{ subsystem, anyJobThread,
+            std::chrono::duration<double>(begin - mFrameBegin).count(),
+            std::chrono::duration<double>(end - mFrameBegin).count() });
+    }
+
+    void JobSystem::beginFrame()
+    {
+        const std::lock_guard lock(mMutex);
+        mFrameBegin = Clock::now();
+        mTimeline.clear();
+    }
+
+    JobFrame JobSystem::endFrame()
+    {
+        JobFrame result;
+        {
+            const std::lock_guard lock(mMutex);
+            result.mTimeline = std::move(mTimeline);
+            mTimeline.clear();
+            result.mSubsystems.resize(mSubsystems.size());
+        }
+        for (JobTimelineEntry& entry : result.mTimeline)
+        {
+            // Jobs started in the previous frame
+            entry.mBegin = std::max(0.0, entry.mBegin);
+            JobSubsystemFrameStats& stats = result.mSubsystems[entry.mSubsystem];
+            if (stats.mJobs == 0)
+            {
+                stats.mBegin = entry.mBegin;
+                stats.mEnd = entry.mEnd;
+            }
+            else
+            {
+                stats.mBegin = std::min(stats.mBegin, entry.mBegin);
+                stats.mEnd = std::max(stats.mEnd, entry.mEnd);
+            }
+            stats.mTaken += entry.mEnd - entry.mBegin;
+            ++stats.mJobs;
+        }
+        return result;
+    }
+
+    void JobSystem::execute(Job& job, std::size_t thread)
+    {
+        std::exception_ptr exception;
+        const Clock::time_point begin = Clock::now();
+        try
+        {
+            job.mFunction();
+        }
+        catch (...)
+        {
+            exception = std::current_exception();
+        }
+        const Clock::time_point end = Clock::now();
+        {
+            const std::lock_guard lock(mMutex);
+            mTimeline.push_back(JobTimelineEntry{ job.mSubsystem, thread,
+                std::chrono::duration<double>(begin - mFrameBegin).count(),
+                std::chrono::duration<double>(end - mFrameBegin).count() });
+        }
+        {
+            const std::lock_guard lock(job.mState->mMutex);
+            job.mState->mDone = true;
+            job.mState->mException = std::move(exception);
+        }
+        job.mState->mCondition.notify_all();
+    }
+
+    void JobSystem::work(std::size_t thread)
+    {
+        std::deque<Job>& threadJobs = mThreadJobs[thread];
+        while (true)
+        {
+            std::unique_lock lock(mMutex);
+            mHasJob.wait(lock, [&] { return mShouldStop || !threadJobs.empty() || !mJobs.empty(); });
+            // Finish queued jobs before stopping so nobody waits for them forever
+            if (threadJobs.empty() && mJobs.empty())
+                return;
+            std::deque<Job>& jobs = threadJobs.empty() ? mJobs : threadJobs;
+            Job job = std::move(jobs.front());
+            jobs.pop_front();
+            lock.unlock();
+            execute(job, thread);
+        }
+    }
+}
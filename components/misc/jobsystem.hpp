@@ -0,0 +1,144 @@
+#ifndef OPENMW_COMPONENTS_MISC_JOBSYSTEM_H
+#define OPENMW_COMPONENTS_MISC_JOBSYSTEM_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Misc
+{
+    /// Identifies a subsystem submitting jobs, CPU time is accounted per subsystem.
+    using JobSubsystem = std::size_t;
+
+    /// Job runs on any worker thread.
+    constexpr std::size_t anyJobThread = std::numeric_limits<std::size_t>::max();
+
+    struct JobTimelineEntry
+    {
+        JobSubsystem mSubsystem;
+        // Worker thread index or anyJobThread for jobs run on the calling thread
+        std::size_t mThread;
+        // Seconds since the frame begin
+        double mBegin;
+        double mEnd;
+    };
+
+    struct JobSubsystemFrameStats
+    {
+        std::size_t mJobs = 0;
+        // Seconds since the frame begin of the first job start and the last job end
+        double mBegin = 0;
+        double mEnd = 0;
+        // Sum of the jobs durations in seconds
+        double mTaken = 0;
+    };
+
+    struct JobFrame
+    {
+        std::vector<JobTimelineEntry> mTimeline;
+        // Indexed by JobSubsystem
+        std::vector<JobSubsystemFrameStats> mSubsystems;
+    };
+
+    class JobHandle
+    {
+    public:
+        JobHandle() = default;
+
+        bool isValid() const { return mState != nullptr; }
+
+        bool isDone() const;
+
+        /// Wait until the job is finished and rethrow the exception thrown by the job if any.
+        void wait() const;
+
+    private:
+        struct State
+        {
+            mutable std::mutex mMutex;
+            std::condition_variable mCondition;
+            bool mDone = false;
+            std::exception_ptr mException;
+        };
+
+        std::shared_ptr<State> mState;
+
+        friend class JobSystem;
+    };
+
+    /// @brief Pool of worker threads shared by the engine subsystems running short jobs each frame.
+    /// @par Jobs submitted with an affinity run only on the given worker thread in the order of submission. This
+    /// allows to keep thread affine state like a Lua VM on the same thread. Other jobs are taken by any worker.
+    /// @par Each finished job is recorded in the timeline of the current frame, see beginFrame() and endFrame().
+    /// @note Thread safe.
+    class JobSystem
+    {
+    public:
+        /// @param threads number of worker threads, with zero all jobs are run on the calling thread by submit().
+        explicit JobSystem(std::size_t threads);
+
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        /// Number of worker threads to use when reservedThreads of the hardwareThreads are taken by the main thread
+        /// and dedicated threads of other subsystems. Uses at least one thread.
+        static std::size_t getDefaultThreadsCount(std::size_t hardwareThreads, std::size_t reservedThreads);
+
+        /// Subsystems should be registered during the engine initialization to be shown by the profiler.
+        JobSubsystem registerSubsystem(const std::string& name);
+
+        std::vector<std::string> getSubsystemNames() const;
+
+        std::size_t getThreadsCount() const { return mThreads.size(); }
+
+        /// @param affinity worker thread index, wrapped around the number of threads, or anyJobThread.
+        JobHandle submit(JobSubsystem subsystem, std::function<void()> job, std::size_t affinity = anyJobThread);
+
+        /// Run the job on the calling thread and record it in the timeline.
+        void run(JobSubsystem subsystem, const std::function<void()>& job);
+
+        /// Start a new timeline frame. Jobs are recorded in the frame they have finished in.
+        void beginFrame();
+
+        /// Return the timeline of the frame started by the last beginFrame() call.
+        JobFrame endFrame();
+
+    private:
+        using Clock = std::chrono::steady_clock;
+
+        struct Job
+        {
+            JobSubsystem mSubsystem;
+            std::function<void()> mFunction;
+            std::shared_ptr<JobHandle::State> mState;
+        };
+
+        mutable std::mutex mMutex;
+        std::condition_variable mHasJob;
+        bool mShouldStop = false;
+        std::deque<Job> mJobs;
+        // Jobs with affinity per worker thread
+        std::vector<std::deque<Job>> mThreadJobs;
+        std::vector<std::string> mSubsystems;
+        Clock::time_point mFrameBegin = Clock::now();
+        std::vector<JobTimelineEntry> mTimeline;
+        std::vector<std::thread> mThreads;
+
+        void execute(Job& job, std::size_t thread);
+
+        void work(std::size_t thread);
+    };
+}
+
+#endif
@@ -1,13 +1,53 @@
 #include "nifstream.hpp"
 // For error reporting
+#include "exception.hpp"
 #include "niffile.hpp"
 
+#include <components/files/memorystream.hpp>
+
 namespace Nif
 {
+    NIFStream::NIFStream(const Reader& file, Files::IStreamPtr&& inp)
+        : file(file)
+        , inp(std::move(inp))
+    {
+        if (const auto* memBuf = dynamic_cast<const Files::MemBuf*>(this->inp->rdbuf()))
+        {
+            mBegin = memBuf->getCurrent();
+            mPos = mBegin;
+            mEnd = memBuf->getEnd();
+            return;
+        }
+
+        constexpr std::size_t chunkSize = 64 * 1024;
+        std::size_t size = 0;
+        while (true)
+        {
+            mBuffer.resize(size + chunkSize);
+            this->inp->read(mBuffer.data() + size, chunkSize);
+            size += static_cast<std::size_t>(this->inp->gcount());
+            if (!this->inp->good())
+                break;
+        }
+        if (this->inp->bad())
+            throw Nif::Exception("Failed to read file", file.getFilename());
+        mBuffer.resize(size);
+        mBegin = mBuffer.data();
+        mPos = mBegin;
+        mEnd = mBegin + size;
+    }
+
+    void NIFStream::failRead(std::size_t size) const
+    {
+        throw Nif::Exception("Failed to read " + std::to_string(size) + " bytes at offset "
+                + std::to_string(mPos - mBegin) + ": unexpected end of file",
+            file.getFilename());
+    }
+
     osg::Quat NIFStream::getQuaternion()
     {
         float f[4];
-        readLittleEndianBufferOfType<4, float>(inp, f);
+        readBufferOfType<4>(f);
         osg::Quat quat;
         quat.w() = f[0];
         quat.x() = f[1];
@@ -3,10 +3,14 @@
 #ifndef OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 #define OPENMW_COMPONENTS_NIF_NIFSTREAM_HPP
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 #include <istream>
 #include <stdexcept>
 #include <stdint.h>
+#include <string>
+#include <string_view>
 #include <type_traits>
 #include <vector>
 
@@ -24,94 +28,107 @@ namespace Nif
 
     class Reader;
 
-    template <std::size_t numInstances, typename T>
-    inline void readLittleEndianBufferOfType(Files::IStreamPtr& pIStream, T* dest)
-    {
-        static_assert(std::is_arithmetic_v<T>, "Buffer element type is not arithmetic");
-        pIStream->read((char*)dest, numInstances * sizeof(T));
-        if (pIStream->bad())
-            throw std::runtime_error("Failed to read little endian typed (" + std::string(typeid(T).name())
-                + ") buffer of " + std::to_string(numInstances) + " instances");
-        if constexpr (Misc::IS_BIG_ENDIAN)
-            for (std::size_t i = 0; i < numInstances; i++)
-                Misc::swapEndiannessInplace(dest[i]);
-    }
-
-    template <typename T>
-    inline void readLittleEndianDynamicBufferOfType(Files::IStreamPtr& pIStream, T* dest, std::size_t numInstances)
-    {
-        static_assert(std::is_arithmetic_v<T>, "Buffer element type is not arithmetic");
-        pIStream->read((char*)dest, numInstances * sizeof(T));
-        if (pIStream->bad())
-            throw std::runtime_error(
-                "Failed to read little endian dynamic buffer of " + std::to_string(numInstances) + " instances");
-        if constexpr (Misc::IS_BIG_ENDIAN)
-            for (std::size_t i = 0; i < numInstances; i++)
-                Misc::swapEndiannessInplace(dest[i]);
-    }
-    template <typename type>
-    type inline readLittleEndianType(Files::IStreamPtr& pIStream)
-    {
-        type val;
-        readLittleEndianBufferOfType<1, type>(pIStream, &val);
-        return val;
-    }
-
+    /// @brief Reads NIF data from memory.
+    /// @par The content is read directly when the stream is backed by a memory buffer (Files::MemBuf), otherwise
+    /// it's copied into an internal buffer at once. Each read is a bounds checked copy from the buffer.
     class NIFStream
     {
         const Reader& file;
 
-        /// Input stream
+        /// Input stream, keeps the memory alive
         Files::IStreamPtr inp;
 
-    public:
-        explicit NIFStream(const Reader& file, Files::IStreamPtr&& inp)
-            : file(file)
-            , inp(std::move(inp))
+        /// Content copied from the input stream if it's not backed by memory
+        std::vector<char> mBuffer;
+
+        const char* mBegin = nullptr;
+        const char* mPos = nullptr;
+        const char* mEnd = nullptr;
+
+        [[noreturn]] void failRead(std::size_t size) const;
+
+        const char* read(std::size_t size)
         {
+            if (static_cast<std::size_t>(mEnd - mPos) < size)
+                failRead(size);
+            const char* const result = mPos;
+            mPos += size;
+            return result;
         }
 
+        template <typename T>
+        void readDynamicBufferOfType(T* dest, std::size_t numInstances)
+        {
+            static_assert(std::is_arithmetic_v<T>, "Buffer element type is not arithmetic");
+            if (numInstances == 0)
+                return;
+            std::memcpy(dest, read(numInstances * sizeof(T)), numInstances * sizeof(T));
+            if constexpr (Misc::IS_BIG_ENDIAN)
+                for (std::size_t i = 0; i < numInstances; i++)
+                    Misc::swapEndiannessInplace(dest[i]);
+        }
+
+        template <std::size_t numInstances, typename T>
+        void readBufferOfType(T* dest)
+        {
+            readDynamicBufferOfType(dest, numInstances);
+        }
+
+        template <typename T>
+        T readType()
+        {
+            T value;
+            readBufferOfType<1>(&value);
+            return value;
+        }
+
+    public:
+        explicit NIFStream(const Reader& file, Files::IStreamPtr&& inp);
+
         const Reader& getFile() const { return file; }
 
-        void skip(size_t size) { inp->ignore(size); }
+        /// Get the whole file content
+        std::string_view getContent() const { return std::string_view(mBegin, mEnd - mBegin); }
+
+        void skip(size_t size) { mPos += std::min(size, static_cast<size_t>(mEnd - mPos)); }
 
-        char getChar() { return readLittleEndianType<char>(inp); }
+        char getChar() { return readType<char>(); }
 
-        short getShort() { return readLittleEndianType<short>(inp); }
+        short getShort() { return readType<short>(); }
 
-        unsigned short getUShort() { return readLittleEndianType<unsigned short>(inp); }
+        unsigned short getUShort() { return readType<unsigned short>(); }
 
-        int getInt() { return readLittleEndianType<int>(inp); }
+        int getInt() { return readType<int>(); }
 
-        unsigned int getUInt() { return readLittleEndianType<unsigned int>(inp); }
+        unsigned int getUInt() { return readType<unsigned int>(); }
 
-        float getFloat() { return readLittleEndianType<float>(inp); }
+        float getFloat() { return readType<float>(); }
 
         osg::Vec2f getVector2()
         {
             osg::Vec2f vec;
-            readLittleEndianBufferOfType<2, float>(inp, vec._v);
+            readBufferOfType<2>(vec._v);
             return vec;
         }
 
         osg::Vec3f getVector3()
         {
             osg::Vec3f vec;
-            readLittleEndianBufferOfType<3, float>(inp, vec._v);
+            readBufferOfType<3>(vec._v);
             return vec;
         }
 
         osg::Vec4f getVector4()
         {
             osg::Vec4f vec;
-            readLittleEndianBufferOfType<4, float>(inp, vec._v);
+            readBufferOfType<4>(vec._v);
             return vec;
         }
 
         Matrix3 getMatrix3()
         {
             Matrix3 mat;
-            readLittleEndianBufferOfType<9, float>(inp, (float*)&mat.mValues);
+            readBufferOfType<9>((float*)&mat.mValues);
             return mat;
         }
 
@@ -136,94 +153,87 @@ namespace Nif
         /// Read in a string of the given length
         std::string getSizedString(size_t length)
         {
-            std::string str(length, '\0');
-            inp->read(str.data(), length);
-            if (inp->bad())
-                throw std::runtime_error("Failed to read sized string of " + std::to_string(length) + " chars");
-            size_t end = str.find('\0');
-            if (end != std::string::npos)
-                str.erase(end);
-            return str;
+            const char* const data = read(length);
+            return std::string(data, std::find(data, data + length, '\0'));
         }
         /// Read in a string of the length specified in the file
         std::string getSizedString()
         {
-            size_t size = readLittleEndianType<uint32_t>(inp);
+            size_t size = readType<uint32_t>();
             return getSizedString(size);
         }
 
         /// Specific to Bethesda headers, uses a byte for length
         std::string getExportString()
         {
-            size_t size = static_cast<size_t>(readLittleEndianType<uint8_t>(inp));
+            size_t size = static_cast<size_t>(readType<uint8_t>());
             return getSizedString(size);
         }
 
         /// This is special since the version string doesn't start with a number, and ends with "\n"
         std::string getVersionString()
         {
-            std::string result;
-            std::getline(*inp, result);
-            if (inp->bad())
-                throw std::runtime_error("Failed to read version string");
+            const char* const end = std::find(mPos, mEnd, '\n');
+            std::string result(mPos, end);
+            mPos = end == mEnd ? end : end + 1;
             return result;
         }
 
         void getChars(std::vector<char>& vec, size_t size)
         {
             vec.resize(size);
-            readLittleEndianDynamicBufferOfType<char>(inp, vec.data(), size);
+            readDynamicBufferOfType(vec.data(), size);
         }
 
         void getUChars(std::vector<unsigned char>& vec, size_t size)
         {
             vec.resize(size);
-            readLittleEndianDynamicBufferOfType<unsigned char>(inp, vec.data(), size);
+            readDynamicBufferOfType(vec.data(), size);
         }
 
         void getUShorts(std::vector<unsigned short>& vec, size_t size)
         {
             vec.resize(size);
-            readLittleEndianDynamicBufferOfType<unsigned short>(inp, vec.data(), size);
+            readDynamicBufferOfType(vec.data(), size);
         }
 
         void getFloats(std::vector<float>& vec, size_t size)
         {
             vec.resize(size);
-            readLittleEndianDynamicBufferOfType<float>(inp, vec.data(), size);
+            readDynamicBufferOfType(vec.data(), size);
         }
 
         void getInts(std::vector<int>& vec, size_t size)
         {
             vec.resize(size);
-            readLittleEndianDynamicBufferOfType<int>(inp, vec.data(), size);
+            readDynamicBufferOfType(vec.data(), size);
         }
 
         void getUInts(std::vector<unsigned int>& vec, size_t size)
         {
             vec.resize(size);
-            readLittleEndianDynamicBufferOfType<unsigned int>(inp, vec.data(), size);
+            readDynamicBufferOfType(vec.data(), size);
         }
 
         void getVector2s(std::vector<osg::Vec2f>& vec, size_t size)
         {
             vec.resize(size);
             /* The packed storage of each Vec2f is 2 floats exactly */
-            readLittleEndianDynamicBufferOfType<float>(inp, (float*)vec.data(), size * 2);
+            readDynamicBufferOfType((float*)vec.data(), size * 2);
         }
 
         void getVector3s(std::vector<osg::Vec3f>& vec, size_t size)
         {
             vec.resize(size);
             /* The packed storage of each Vec3f is 3 floats exactly */
-            readLittleEndianDynamicBufferOfType<float>(inp, (float*)vec.data(), size * 3);
+            readDynamicBufferOfType((float*)vec.data(), size * 3);
         }
 
         void getVector4s(std::vector<osg::Vec4f>& vec, size_t size)
         {
             vec.resize(size);
             /* The packed storage of each Vec4f is 4 floats exactly */
-            readLittleEndianDynamicBufferOfType<float>(inp, (float*)vec.data(), size * 4);
+            readDynamicBufferOfType((float*)vec.data(), size * 4);
         }
 
         void getQuaternions(std::vector<osg::Quat>& quat, size_t size)
@@ -30,6 +30,11 @@ namespace Platform::File
 
     size_t read(Handle handle, void* data, size_t size);
 
+    /// Map first size bytes of the file into memory for reading. Returns nullptr when memory mapping is not supported.
+    const char* map(Handle handle, size_t size);
+
+    void unmap(const char* data, size_t size);
+
     class ScopedHandle
     {
         Handle mHandle{ Handle::Invalid };
@@ -63,6 +68,48 @@ namespace Platform::File
 
         operator Handle() const { return mHandle; }
     };
+
+    class ScopedMapping
+    {
+        const char* mData = nullptr;
+        size_t mSize = 0;
+
+    public:
+        ScopedMapping() noexcept = default;
+        ScopedMapping(ScopedMapping& other) = delete;
+        ScopedMapping(const char* data, size_t size) noexcept
+            : mData(data)
+            , mSize(size)
+        {
+        }
+        ScopedMapping(ScopedMapping&& other) noexcept
+            : mData(other.mData)
+            , mSize(other.mSize)
+        {
+            other.mData = nullptr;
+            other.mSize = 0;
+        }
+        ScopedMapping& operator=(const ScopedMapping& other) = delete;
+        ScopedMapping& operator=(ScopedMapping&& other) noexcept
+        {
+            if (mData != nullptr)
+                unmap(mData, mSize);
+            mData = other.mData;
+            mSize = other.mSize;
+            other.mData = nullptr;
+            other.mSize = 0;
+            return *this;
+        }
+        ~ScopedMapping()
+        {
+            if (mData != nullptr)
+                unmap(mData, mSize);
+        }
+
+        const char* data() const { return mData; }
+
+        size_t size() const { return mSize; }
+    };
 }
 
 #endif // OPENMW_COMPONENTS_PLATFORM_FILE_HPP
@@ -6,6 +6,7 @@
 #include <stdexcept>
 #include <string.h>
 #include <string>
+#include <sys/mman.h>
 #include <sys/types.h>
 #include <unistd.h>
 
@@ -103,4 +104,22 @@ namespace Platform::File
         return amount;
     }
 
+    const char* map(Handle handle, size_t size)
+    {
+        auto nativeHandle = getNativeHandle(handle);
+
+        void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, nativeHandle, 0);
+        if (data == MAP_FAILED)
+        {
+            throw std::runtime_error(
+                "An attempt to map " + std::to_string(size) + " bytes failed: " + strerror(errno));
+        }
+        return static_cast<const char*>(data);
+    }
+
+    void unmap(const char* data, size_t size)
+    {
+        ::munmap(const_cast<char*>(data), size);
+    }
+
 }
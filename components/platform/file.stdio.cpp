@@ -93,4 +93,11 @@ namespace Platform::File
         return static_cast<size_t>(amount);
     }
 
+    const char* map(Handle /*handle*/, size_t /*size*/)
+    {
+        return nullptr;
+    }
+
+    void unmap(const char* /*data*/, size_t /*size*/) {}
+
 }
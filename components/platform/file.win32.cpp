@@ -99,4 +99,33 @@ namespace Platform::File
 
         return bytesRead;
     }
+
+    const char* map(Handle handle, size_t size)
+    {
+        auto nativeHandle = getNativeHandle(handle);
+
+        HANDLE mapping = CreateFileMappingW(nativeHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            throw std::runtime_error(
+                "An attempt to create file mapping failed: " + std::to_string(GetLastError()));
+        }
+
+        // The view keeps the mapping object alive
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+        const auto errCode = GetLastError();
+        CloseHandle(mapping);
+        if (data == nullptr)
+        {
+            throw std::runtime_error(
+                "An attempt to map " + std::to_string(size) + " bytes failed: " + std::to_string(errCode));
+        }
+        return static_cast<const char*>(data);
+    }
+
+    void unmap(const char* data, size_t /*size*/)
+    {
+        UnmapViewOfFile(data);
+    }
+
 }
@@ -21,6 +21,7 @@
 #include "niffilemanager.hpp"
 #include "objectcache.hpp"
 #include "scenemanager.hpp"
+#include "sizeestimator.hpp"
 
 namespace Resource
 {
@@ -103,6 +104,8 @@ namespace Resource
         , mSceneManager(sceneMgr)
         , mNifFileManager(nifFileManager)
     {
+        mCache->setSizeEstimator(estimateBulletShapeSize);
+        mInstanceCache->setSizeEstimator(estimateBulletShapeSize);
     }
 
     BulletShapeManager::~BulletShapeManager() {}
@@ -214,6 +217,13 @@ namespace Resource
     {
         stats->setAttribute(frameNumber, "Shape", mCache->getCacheSize());
         stats->setAttribute(frameNumber, "Shape Instance", mInstanceCache->getCacheSize());
+        stats->setAttribute(frameNumber, "Shape MB", toMegabytes(mCache->getCacheBytes()));
+        stats->setAttribute(frameNumber, "Shape Instance MB", toMegabytes(mInstanceCache->getCacheBytes()));
+    }
+
+    std::size_t BulletShapeManager::getCacheBytes() const
+    {
+        return ResourceManager::getCacheBytes() + mInstanceCache->getCacheBytes();
     }
 
 }
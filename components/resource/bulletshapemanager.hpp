@@ -47,6 +47,8 @@ namespace Resource
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
+        std::size_t getCacheBytes() const override;
+
     private:
         osg::ref_ptr<BulletShapeInstance> createInstance(const std::string& name);
 
@@ -0,0 +1,151 @@
+#include "ddsmipmaps.hpp"
+
+#include <components/misc/endianness.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+namespace Resource
+{
+    namespace
+    {
+        constexpr std::size_t heightOffset = 12;
+        constexpr std::size_t widthOffset = 16;
+        constexpr std::size_t pitchOrLinearSizeOffset = 20;
+        constexpr std::size_t mipMapCountOffset = 28;
+        constexpr std::size_t pixelFormatFlagsOffset = 80;
+        constexpr std::size_t fourCCOffset = 84;
+        constexpr std::size_t rgbBitCountOffset = 88;
+        constexpr std::size_t caps2Offset = 112;
+
+        constexpr std::uint32_t flagPitch = 0x8;
+        constexpr std::uint32_t flagMipMapCount = 0x20000;
+        constexpr std::uint32_t flagLinearSize = 0x80000;
+
+        constexpr std::uint32_t pixelFormatFourCC = 0x4;
+
+        constexpr std::uint32_t caps2CubeMap = 0x200;
+        constexpr std::uint32_t caps2Volume = 0x200000;
+
+        constexpr std::uint32_t makeFourCC(const char (&value)[5])
+        {
+            return static_cast<std::uint32_t>(value[0]) | (static_cast<std::uint32_t>(value[1]) << 8)
+                | (static_cast<std::uint32_t>(value[2]) << 16) | (static_cast<std::uint32_t>(value[3]) << 24);
+        }
+
+        std::uint32_t readUInt32(std::string_view content, std::size_t offset)
+        {
+            std::uint32_t value;
+            std::memcpy(&value, content.data() + offset, sizeof(value));
+            return Misc::toLittleEndian(value);
+        }
+
+        void writeUInt32(std::string& content, std::size_t offset, std::uint32_t value)
+        {
+            value = Misc::toLittleEndian(value);
+            std::memcpy(content.data() + offset, &value, sizeof(value));
+        }
+
+        struct PixelFormat
+        {
+            bool mCompressed = false;
+            // Bytes per 4x4 block for compressed formats and per pixel for others
+            std::size_t mBytes = 0;
+        };
+
+        std::optional<PixelFormat> getPixelFormat(std::string_view content)
+        {
+            if ((readUInt32(content, pixelFormatFlagsOffset) & pixelFormatFourCC) == 0)
+            {
+                const std::uint32_t bitCount = readUInt32(content, rgbBitCountOffset);
+                if (bitCount == 0 || bitCount % 8 != 0)
+                    return std::nullopt;
+                return PixelFormat{ false, bitCount / 8 };
+            }
+            switch (readUInt32(content, fourCCOffset))
+            {
+                case makeFourCC("DXT1"):
+                    return PixelFormat{ true, 8 };
+                case makeFourCC("DXT2"):
+                case makeFourCC("DXT3"):
+                case makeFourCC("DXT4"):
+                case makeFourCC("DXT5"):
+                    return PixelFormat{ true, 16 };
+            }
+            return std::nullopt;
+        }
+
+        std::size_t getMipmapSize(const PixelFormat& format, std::size_t width, std::size_t height)
+        {
+            if (format.mCompressed)
+                return std::max<std::size_t>(1, (width + 3) / 4) * std::max<std::size_t>(1, (height + 3) / 4)
+                    * format.mBytes;
+            return width * height * format.mBytes;
+        }
+    }
+
+    std::optional<DdsMipmapsReduction> getDdsMipmapsReduction(std::string_view header, unsigned maxSize)
+    {
+        if (header.size() < ddsHeaderSize || header.substr(0, 4) != "DDS " || maxSize == 0)
+            return std::nullopt;
+
+        const std::uint32_t flags = readUInt32(header, 8);
+        if ((flags & flagMipMapCount) == 0)
+            return std::nullopt;
+        if ((readUInt32(header, caps2Offset) & (caps2CubeMap | caps2Volume)) != 0)
+            return std::nullopt;
+
+        const std::optional<PixelFormat> format = getPixelFormat(header);
+        if (!format.has_value())
+            return std::nullopt;
+
+        const std::size_t height = readUInt32(header, heightOffset);
+        const std::size_t width = readUInt32(header, widthOffset);
+        const std::size_t mipMapCount = readUInt32(header, mipMapCountOffset);
+        if (width == 0 || height == 0)
+            return std::nullopt;
+
+        std::size_t level = 0;
+        std::size_t offset = 0;
+        while (level < mipMapCount && std::max(width >> level, height >> level) > maxSize)
+        {
+            offset += getMipmapSize(*format, std::max<std::size_t>(1, width >> level),
+                std::max<std::size_t>(1, height >> level));
+            ++level;
+        }
+        if (level == 0 || level >= mipMapCount)
+            return std::nullopt;
+
+        std::size_t size = 0;
+        for (std::size_t i = level; i < mipMapCount; ++i)
+            size += getMipmapSize(
+                *format, std::max<std::size_t>(1, width >> i), std::max<std::size_t>(1, height >> i));
+
+        const std::size_t reducedWidth = std::max<std::size_t>(1, width >> level);
+        const std::size_t reducedHeight = std::max<std::size_t>(1, height >> level);
+
+        DdsMipmapsReduction result{ std::string(header.substr(0, ddsHeaderSize)), ddsHeaderSize + offset, size };
+        writeUInt32(result.mHeader, heightOffset, static_cast<std::uint32_t>(reducedHeight));
+        writeUInt32(result.mHeader, widthOffset, static_cast<std::uint32_t>(reducedWidth));
+        writeUInt32(result.mHeader, mipMapCountOffset, static_cast<std::uint32_t>(mipMapCount - level));
+        if ((flags & flagLinearSize) != 0)
+            writeUInt32(result.mHeader, pitchOrLinearSizeOffset,
+                static_cast<std::uint32_t>(getMipmapSize(*format, reducedWidth, reducedHeight)));
+        else if ((flags & flagPitch) != 0)
+            writeUInt32(
+                result.mHeader, pitchOrLinearSizeOffset, static_cast<std::uint32_t>(reducedWidth * format->mBytes));
+        return result;
+    }
+
+    std::optional<std::string> reduceDdsMipmaps(std::string_view content, unsigned maxSize)
+    {
+        std::optional<DdsMipmapsReduction> reduction = getDdsMipmapsReduction(content, maxSize);
+        if (!reduction.has_value() || content.size() < reduction->mOffset + reduction->mSize)
+            return std::nullopt;
+        std::string result = std::move(reduction->mHeader);
+        result.append(content.substr(reduction->mOffset, reduction->mSize));
+        return result;
+    }
+}
@@ -0,0 +1,32 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_DDSMIPMAPS_H
+#define OPENMW_COMPONENTS_RESOURCE_DDSMIPMAPS_H
+
+#include <cstddef>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Resource
+{
+    constexpr std::size_t ddsHeaderSize = 128;
+
+    struct DdsMipmapsReduction
+    {
+        /// Header of the reduced file
+        std::string mHeader;
+        /// Position of the kept mipmaps in the original file
+        std::size_t mOffset = 0;
+        std::size_t mSize = 0;
+    };
+
+    /// Same as reduceDdsMipmaps but needs only the header, so the kept mipmaps can be read without the rest of the
+    /// file. Doesn't check that the file is large enough.
+    std::optional<DdsMipmapsReduction> getDdsMipmapsReduction(std::string_view header, unsigned maxSize);
+
+    /// Make a DDS file containing only the mipmaps of the given DDS file content not larger than maxSize in both
+    /// dimensions. Returns nullopt for cube maps, volume textures, DX10 and other unsupported formats, files without
+    /// enough mipmaps and files that already fit.
+    std::optional<std::string> reduceDdsMipmaps(std::string_view content, unsigned maxSize);
+}
+
+#endif
@@ -1,13 +1,19 @@
 #include "imagemanager.hpp"
 
 #include <cassert>
+#include <optional>
 #include <osgDB/Registry>
 
 #include <components/debug/debuglog.hpp>
+#include <components/files/memorystream.hpp>
 #include <components/misc/pathhelpers.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/vfs/manager.hpp>
 
+#include "ddsmipmaps.hpp"
+#include "imagestreamer.hpp"
 #include "objectcache.hpp"
+#include "sizeestimator.hpp"
 
 #ifdef OSG_LIBRARY_STATIC
 // This list of plugins should match with the list in the top-level CMakelists.txt.
@@ -51,6 +57,7 @@ namespace Resource
         , mOptions(new osgDB::Options("dds_flip dds_dxt1_detect_rgba ignoreTga2Fields"))
         , mOptionsNoFlip(new osgDB::Options("dds_dxt1_detect_rgba ignoreTga2Fields"))
     {
+        mCache->setSizeEstimator(estimateImageSize);
     }
 
     ImageManager::~ImageManager() {}
@@ -83,34 +90,21 @@ namespace Resource
         return true;
     }
 
-    osg::ref_ptr<osg::Image> ImageManager::getImage(const std::string& filename, bool disableFlip)
+    namespace
     {
-        const std::string normalized = mVFS->normalizeFilename(filename);
+        // Can't be a part of a file name
+        constexpr char unstreamedKeySuffix[] = "|full";
 
-        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(normalized);
-        if (obj)
-            return osg::ref_ptr<osg::Image>(static_cast<osg::Image*>(obj.get()));
-        else
+        /// Read an image from the stream. Returns nullptr when the image can't be read.
+        osg::ref_ptr<osg::Image> readImage(const std::string& filename, const std::string& normalized,
+            std::istream& stream, const osgDB::Options* options)
         {
-            Files::IStreamPtr stream;
-            try
-            {
-                stream = mVFS->get(normalized);
-            }
-            catch (std::exception& e)
-            {
-                Log(Debug::Error) << "Failed to open image: " << e.what();
-                mCache->addEntryToObjectCache(normalized, mWarningImage);
-                return mWarningImage;
-            }
-
             const std::string ext(Misc::getFileExtension(normalized));
             osgDB::ReaderWriter* reader = osgDB::Registry::instance()->getReaderWriterForExtension(ext);
             if (!reader)
             {
                 Log(Debug::Error) << "Error loading " << filename << ": no readerwriter for '" << ext << "' found";
-                mCache->addEntryToObjectCache(normalized, mWarningImage);
-                return mWarningImage;
+                return nullptr;
             }
 
             bool killAlpha = false;
@@ -118,12 +112,11 @@ namespace Resource
             {
                 // Morrowind ignores the alpha channel of 16bpp TGA files even when the header says not to
                 unsigned char header[18];
-                stream->read((char*)header, 18);
-                if (stream->gcount() != 18)
+                stream.read((char*)header, 18);
+                if (stream.gcount() != 18)
                 {
                     Log(Debug::Error) << "Error loading " << filename << ": couldn't read TGA header";
-                    mCache->addEntryToObjectCache(normalized, mWarningImage);
-                    return mWarningImage;
+                    return nullptr;
                 }
                 int type = header[2];
                 int depth;
@@ -133,17 +126,15 @@ namespace Resource
                     depth = header[16];
                 int alphaBPP = header[17] & 0x0F;
                 killAlpha = depth == 16 && alphaBPP == 1;
-                stream->seekg(0);
+                stream.seekg(0);
             }
 
-            osgDB::ReaderWriter::ReadResult result
-                = reader->readImage(*stream, disableFlip ? mOptionsNoFlip : mOptions);
+            osgDB::ReaderWriter::ReadResult result = reader->readImage(stream, options);
             if (!result.success())
             {
                 Log(Debug::Error) << "Error loading " << filename << ": " << result.message() << " code "
                                   << result.status();
-                mCache->addEntryToObjectCache(normalized, mWarningImage);
-                return mWarningImage;
+                return nullptr;
             }
 
             osg::ref_ptr<osg::Image> image = result.getImage();
@@ -156,8 +147,7 @@ namespace Resource
                 {
                     Log(Debug::Error) << "Error loading " << filename
                                       << ": no S3TC texture compression support installed";
-                    mCache->addEntryToObjectCache(normalized, mWarningImage);
-                    return mWarningImage;
+                    return nullptr;
                 }
                 else
                 {
@@ -187,7 +177,41 @@ namespace Resource
                 image = newImage;
             }
 
-            mCache->addEntryToObjectCache(normalized, image);
+            return image;
+        }
+    }
+
+    osg::ref_ptr<osg::Image> ImageManager::getImage(const std::string& filename, bool disableFlip)
+    {
+        return getImage(filename, disableFlip, true);
+    }
+
+    osg::ref_ptr<osg::Image> ImageManager::getFullImage(const std::string& filename)
+    {
+        return getImage(filename, false, false);
+    }
+
+    osg::ref_ptr<osg::Image> ImageManager::getImage(
+        const std::string& filename, bool disableFlip, bool allowStreaming)
+    {
+        const std::string normalized = mVFS->normalizeFilename(filename);
+        const bool streaming = mStreamer != nullptr && allowStreaming;
+        // Full images of streamed files are cached separately from the streamed ones
+        const std::string key = mStreamer == nullptr || allowStreaming ? normalized : normalized + unstreamedKeySuffix;
+
+        osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(key);
+        if (obj)
+        {
+            if (streaming)
+                mStreamer->request(normalized);
+            return osg::ref_ptr<osg::Image>(static_cast<osg::Image*>(obj.get()));
+        }
+        else
+        {
+            osg::ref_ptr<osg::Image> image = loadImage(filename, normalized, disableFlip, streaming);
+            if (image == nullptr)
+                image = mWarningImage;
+            mCache->addEntryToObjectCache(key, image);
             return image;
         }
     }
@@ -197,9 +221,78 @@ namespace Resource
         return mWarningImage;
     }
 
+    void ImageManager::setStreaming(
+        osg::ref_ptr<SceneUtil::WorkQueue> workQueue, unsigned baseSize, std::size_t budget)
+    {
+        mStreamingBaseSize = baseSize;
+        mStreamer = std::make_unique<ImageStreamer>(
+            std::move(workQueue),
+            [this](const std::string& normalized, bool disableFlip) -> osg::ref_ptr<osg::Image> {
+                Files::IStreamPtr stream = mVFS->get(normalized);
+                return readImage(normalized, normalized, *stream, disableFlip ? mOptionsNoFlip : mOptions);
+            },
+            budget);
+    }
+
+    void ImageManager::updateStreaming(unsigned frameNumber)
+    {
+        if (mStreamer != nullptr)
+            mStreamer->update(frameNumber);
+    }
+
     void ImageManager::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         stats->setAttribute(frameNumber, "Image", mCache->getCacheSize());
+        stats->setAttribute(frameNumber, "Image MB", toMegabytes(mCache->getCacheBytes()));
+
+        if (mStreamer != nullptr)
+        {
+            const ImageStreamerStats streamerStats = mStreamer->getStats();
+            stats->setAttribute(frameNumber, "Image Streamed", streamerStats.mStreamed);
+            stats->setAttribute(frameNumber, "Image Streaming", streamerStats.mLoading);
+            stats->setAttribute(frameNumber, "Image Full MB", toMegabytes(streamerStats.mFullBytes));
+        }
+    }
+
+    osg::ref_ptr<osg::Image> ImageManager::loadImage(
+        const std::string& filename, const std::string& normalized, bool disableFlip, bool allowStreaming)
+    {
+        Files::IStreamPtr stream;
+        try
+        {
+            stream = mVFS->get(normalized);
+        }
+        catch (std::exception& e)
+        {
+            Log(Debug::Error) << "Failed to open image: " << e.what();
+            return nullptr;
+        }
+
+        const osgDB::Options* const options = disableFlip ? mOptionsNoFlip : mOptions;
+
+        if (!allowStreaming || Misc::getFileExtension(normalized) != "dds")
+            return readImage(filename, normalized, *stream, options);
+
+        // Read only the header and the kept mipmaps, the full image is loaded later by the streamer
+        std::string header(ddsHeaderSize, '\0');
+        stream->read(header.data(), static_cast<std::streamsize>(header.size()));
+        header.resize(static_cast<std::size_t>(stream->gcount()));
+        if (std::optional<DdsMipmapsReduction> reduction = getDdsMipmapsReduction(header, mStreamingBaseSize))
+        {
+            std::string reduced = std::move(reduction->mHeader);
+            reduced.resize(ddsHeaderSize + reduction->mSize);
+            stream->seekg(static_cast<std::streamoff>(reduction->mOffset));
+            stream->read(reduced.data() + ddsHeaderSize, static_cast<std::streamsize>(reduction->mSize));
+            if (static_cast<std::size_t>(stream->gcount()) == reduction->mSize)
+            {
+                Files::IMemStream reducedStream(reduced.data(), reduced.size());
+                if (osg::ref_ptr<osg::Image> low = readImage(filename, normalized, reducedStream, options))
+                    return mStreamer->add(normalized, std::move(low), disableFlip);
+            }
+        }
+        stream->clear();
+        stream->seekg(0);
+        return readImage(filename, normalized, *stream, options);
     }
 
 }
@@ -1,7 +1,9 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_IMAGEMANAGER_H
 #define OPENMW_COMPONENTS_RESOURCE_IMAGEMANAGER_H
 
+#include <cstddef>
 #include <map>
+#include <memory>
 #include <string>
 
 #include <osg/Image>
@@ -15,10 +17,20 @@ namespace osgDB
     class Options;
 }
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Resource
 {
 
+    class ImageStreamer;
+
     /// @brief Handles loading/caching of Images.
+    /// @par With streaming enabled, DDS images are returned with only the small mipmaps. The full mipmap chain is
+    /// loaded on the work queue and swapped in by the update traversal, see ImageStreamer. Images used outside of the
+    /// scene graph should be retrieved with getFullImage.
     /// @note May be used from any thread.
     class ImageManager : public ResourceManager
     {
@@ -30,8 +42,22 @@ namespace Resource
         /// Returns the dummy image if the given image is not found.
         osg::ref_ptr<osg::Image> getImage(const std::string& filename, bool disableFlip = false);
 
+        /// Create or retrieve an Image that is never streamed, for images not visited by the update traversal or read
+        /// on the CPU, like GUI textures.
+        /// Returns the dummy image if the given image is not found.
+        osg::ref_ptr<osg::Image> getFullImage(const std::string& filename);
+
         osg::Image* getWarningImage();
 
+        /// Enable streaming of DDS images. Initially only mipmaps not larger than baseSize are loaded. Zero budget
+        /// means no limit for memory used by the full images.
+        /// @note Should be called before any image is loaded.
+        void setStreaming(osg::ref_ptr<SceneUtil::WorkQueue> workQueue, unsigned baseSize, std::size_t budget);
+
+        /// Pick loaded images to be swapped in by the update traversal and drop the full mipmaps over budget.
+        /// @note Should be called once per frame from the main thread before the update traversal.
+        void updateStreaming(unsigned frameNumber);
+
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
 
     private:
@@ -39,6 +65,14 @@ namespace Resource
         osg::ref_ptr<osgDB::Options> mOptions;
         osg::ref_ptr<osgDB::Options> mOptionsNoFlip;
 
+        unsigned mStreamingBaseSize = 0;
+        std::unique_ptr<ImageStreamer> mStreamer;
+
+        osg::ref_ptr<osg::Image> getImage(const std::string& filename, bool disableFlip, bool allowStreaming);
+
+        osg::ref_ptr<osg::Image> loadImage(
+            const std::string& filename, const std::string& normalized, bool disableFlip, bool allowStreaming);
+
         ImageManager(const ImageManager&);
         void operator=(const ImageManager&);
     };
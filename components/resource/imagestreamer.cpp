@@ -0,0 +1,258 @@
+#include "imagestreamer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+#include <osg/NodeVisitor>
+#include <osg/StateSet>
+
+#include <components/debug/debuglog.hpp>
+#include <components/sceneutil/workqueue.hpp>
+
+#include "sizeestimator.hpp"
+
+namespace Resource
+{
+    namespace
+    {
+        /// Make the image use pixel data of the source without copying. The source must outlive the image or the
+        /// next assignment.
+        void assignImageData(osg::Image& image, osg::Image& source)
+        {
+            image.setImage(source.s(), source.t(), source.r(), source.getInternalTextureFormat(),
+                source.getPixelFormat(), source.getDataType(), source.data(), osg::Image::NO_DELETE,
+                source.getPacking());
+            image.setMipmapLevels(source.getMipmapLevels());
+        }
+
+        // Replaced pixel data is shown until the next update traversal and drawn by the following draw traversal
+        constexpr unsigned retiredImageFrames = 3;
+
+        // One reference is held by the image cache and one by the update
+        constexpr int unusedImageReferences = 2;
+    }
+
+    class StreamedImage : public osg::Image
+    {
+    public:
+        /// Textures of images requiring update calls are DYNAMIC and have an update callback calling update.
+        bool requiresUpdateCall() const override { return true; }
+
+        void update(osg::NodeVisitor* nv) override
+        {
+            // The viewer lets the next update traversal start before the draw traversal is done with STATIC state
+            // sets. Textures are updated with the state set of the last node in the path.
+            const osg::NodePath& nodePath = nv->getNodePath();
+            if (!nodePath.empty())
+                if (osg::StateSet* stateSet = nodePath.back()->getStateSet())
+                    stateSet->setDataVariance(osg::Object::DYNAMIC);
+
+            // The state sets found in the previous frame are DYNAMIC for the draw traversal which is now done
+            if (mSource == nullptr || nv->getTraversalNumber() <= mSourceFrame)
+                return;
+            assignImageData(*this, *mSource);
+            mSource = nullptr;
+        }
+
+        /// Show the source starting from the update traversal after the given frame. Called from the main thread like
+        /// the update traversal.
+        void setSource(osg::ref_ptr<osg::Image> source, unsigned frameNumber)
+        {
+            mSource = std::move(source);
+            mSourceFrame = frameNumber;
+        }
+
+    private:
+        osg::ref_ptr<osg::Image> mSource;
+        unsigned mSourceFrame = 0;
+    };
+
+    class LoadFullImageWorkItem : public SceneUtil::WorkItem
+    {
+    public:
+        osg::ref_ptr<osg::Image> mImage;
+
+        explicit LoadFullImageWorkItem(
+            const ImageStreamer::LoadFullImage& loadFullImage, const std::string& name, bool disableFlip)
+            : SceneUtil::WorkItem(SceneUtil::WorkItemCategory::Texture)
+            , mLoadFullImage(loadFullImage)
+            , mName(name)
+            , mDisableFlip(disableFlip)
+        {
+        }
+
+        void doWork() override
+        {
+            if (mAborted)
+                return;
+            try
+            {
+                mImage = mLoadFullImage(mName, mDisableFlip);
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Error) << "Failed to stream image " << mName << ": " << e.what();
+            }
+        }
+
+        void abort() override { mAborted = true; }
+
+    private:
+        const ImageStreamer::LoadFullImage& mLoadFullImage;
+        const std::string mName;
+        const bool mDisableFlip;
+        std::atomic_bool mAborted{ false };
+    };
+
+    ImageStreamer::ImageStreamer(
+        osg::ref_ptr<SceneUtil::WorkQueue> workQueue, LoadFullImage loadFullImage, std::size_t budget)
+        : mWorkQueue(std::move(workQueue))
+        , mLoadFullImage(std::move(loadFullImage))
+        , mBudget(budget)
+    {
+    }
+
+    ImageStreamer::~ImageStreamer()
+    {
+        // Work items reference the load function, wait until they're done
+        for (auto& [name, streamed] : mStreamedImages)
+            if (streamed.mLoading != nullptr)
+                abort(streamed.mLoading);
+        for (const osg::ref_ptr<LoadFullImageWorkItem>& loading : mAbortedLoads)
+            loading->waitTillDone();
+    }
+
+    osg::ref_ptr<osg::Image> ImageStreamer::add(
+        const std::string& name, osg::ref_ptr<osg::Image>&& low, bool disableFlip)
+    {
+        // Not shared yet, so the pixel data can be assigned right away
+        osg::ref_ptr<StreamedImage> image = new StreamedImage;
+        image->setFileName(name);
+        assignImageData(*image, *low);
+
+        const std::lock_guard lock(mMutex);
+        StreamedImageState& streamed = mStreamedImages[name];
+        if (streamed.mLoading != nullptr)
+            abort(streamed.mLoading);
+        if (streamed.mFull != nullptr)
+        {
+            mFullBytes -= estimateImageSize(*streamed.mFull);
+            retire(streamed.mFull);
+        }
+        if (streamed.mLow != nullptr)
+            retire(streamed.mLow);
+        streamed = StreamedImageState{ image, std::move(low), nullptr, nullptr, disableFlip, mFrame };
+        requestFullImage(name, streamed);
+        return image;
+    }
+
+    void ImageStreamer::request(std::string_view name)
+    {
+        const std::lock_guard lock(mMutex);
+        const auto it = mStreamedImages.find(name);
+        if (it != mStreamedImages.end())
+            requestFullImage(it->first, it->second);
+    }
+
+    void ImageStreamer::update(unsigned frameNumber)
+    {
+        const std::lock_guard lock(mMutex);
+
+        mFrame = frameNumber;
+
+        mRetiredImages.erase(std::remove_if(mRetiredImages.begin(), mRetiredImages.end(),
+                                 [&](const RetiredImage& v) { return mFrame - v.mFrame > retiredImageFrames; }),
+            mRetiredImages.end());
+
+        mAbortedLoads.erase(std::remove_if(mAbortedLoads.begin(), mAbortedLoads.end(),
+                                [](const osg::ref_ptr<LoadFullImageWorkItem>& v) { return v->isDone(); }),
+            mAbortedLoads.end());
+
+        std::vector<std::pair<StreamedImageState*, osg::ref_ptr<StreamedImage>>> resident;
+
+        for (auto it = mStreamedImages.begin(); it != mStreamedImages.end();)
+        {
+            StreamedImageState& streamed = it->second;
+            osg::ref_ptr<StreamedImage> image;
+            if (!streamed.mImage.lock(image))
+            {
+                if (streamed.mLoading != nullptr)
+                    abort(streamed.mLoading);
+                if (streamed.mFull != nullptr)
+                    mFullBytes -= estimateImageSize(*streamed.mFull);
+                it = mStreamedImages.erase(it);
+                continue;
+            }
+
+            if (streamed.mLoading != nullptr && streamed.mLoading->isDone())
+            {
+                if (streamed.mLoading->mImage != nullptr)
+                {
+                    streamed.mFull = std::move(streamed.mLoading->mImage);
+                    image->setSource(streamed.mFull, mFrame);
+                    mFullBytes += estimateImageSize(*streamed.mFull);
+                }
+                streamed.mLoading = nullptr;
+            }
+
+            if (streamed.mFull != nullptr)
+                resident.emplace_back(&streamed, std::move(image));
+
+            ++it;
+        }
+
+        if (mBudget == 0 || mFullBytes <= mBudget)
+            return;
+
+        std::sort(resident.begin(), resident.end(), [](const auto& l, const auto& r) {
+            const bool lUnused = l.second->referenceCount() <= unusedImageReferences;
+            const bool rUnused = r.second->referenceCount() <= unusedImageReferences;
+            if (lUnused != rUnused)
+                return lUnused;
+            return l.first->mLastRequested < r.first->mLastRequested;
+        });
+
+        for (auto& [streamed, image] : resident)
+        {
+            if (mFullBytes <= mBudget)
+                break;
+            image->setSource(streamed->mLow, mFrame);
+            mFullBytes -= estimateImageSize(*streamed->mFull);
+            retire(streamed->mFull);
+        }
+    }
+
+    ImageStreamerStats ImageStreamer::getStats() const
+    {
+        const std::lock_guard lock(mMutex);
+        ImageStreamerStats result;
+        result.mStreamed = mStreamedImages.size();
+        result.mLoading = std::count_if(mStreamedImages.begin(), mStreamedImages.end(),
+            [](const auto& v) { return v.second.mLoading != nullptr; });
+        result.mFullBytes = mFullBytes;
+        return result;
+    }
+
+    void ImageStreamer::requestFullImage(const std::string& name, StreamedImageState& streamed)
+    {
+        streamed.mLastRequested = mFrame;
+        if (streamed.mFull != nullptr || streamed.mLoading != nullptr)
+            return;
+        streamed.mLoading = new LoadFullImageWorkItem(mLoadFullImage, name, streamed.mDisableFlip);
+        mWorkQueue->addWorkItem(streamed.mLoading);
+    }
+
+    void ImageStreamer::retire(osg::ref_ptr<osg::Image>& image)
+    {
+        mRetiredImages.push_back(RetiredImage{ image, mFrame });
+        image = nullptr;
+    }
+
+    void ImageStreamer::abort(osg::ref_ptr<LoadFullImageWorkItem>& loading)
+    {
+        loading->abort();
+        mAbortedLoads.push_back(loading);
+        loading = nullptr;
+    }
+}
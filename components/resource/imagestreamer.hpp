@@ -0,0 +1,102 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_IMAGESTREAMER_H
+#define OPENMW_COMPONENTS_RESOURCE_IMAGESTREAMER_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <osg/Image>
+#include <osg/observer_ptr>
+#include <osg/ref_ptr>
+
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
+namespace Resource
+{
+    class LoadFullImageWorkItem;
+    class StreamedImage;
+
+    struct ImageStreamerStats
+    {
+        std::size_t mStreamed = 0;
+        std::size_t mLoading = 0;
+        std::size_t mFullBytes = 0;
+    };
+
+    /// @brief Swaps full mipmap chains into images created with only the small mipmaps.
+    /// @par Images made by add never own pixel data. They point either at the small or at the full image, so a swap
+    /// only changes the pointer and dirties the image. Full images are loaded on the work queue. When the full images
+    /// take more memory than the budget, the ones referenced only by the image cache go back to the small mipmaps
+    /// first, then the least recently requested ones, until requested again.
+    /// @par The images are never changed while the draw traversal may read them. Textures using them are DYNAMIC and
+    /// have an update callback, which also makes DYNAMIC the state sets the textures are found in. The image is
+    /// changed by the update traversal following the frame in which update picked the new pixel data, after the draw
+    /// traversal of the DYNAMIC state sets is done. Images not used by the scene graph keep the small mipmaps.
+    /// @note add, request and getStats may be called from any thread, update only from the main thread between frames.
+    class ImageStreamer
+    {
+    public:
+        /// Called on the work queue to load the full image. Returns nullptr when the image can't be loaded.
+        using LoadFullImage = std::function<osg::ref_ptr<osg::Image>(const std::string& name, bool disableFlip)>;
+
+        /// Zero budget means no limit for memory used by the full images.
+        explicit ImageStreamer(
+            osg::ref_ptr<SceneUtil::WorkQueue> workQueue, LoadFullImage loadFullImage, std::size_t budget);
+
+        ~ImageStreamer();
+
+        /// Make an image showing the given small mipmaps and start loading the full ones.
+        osg::ref_ptr<osg::Image> add(const std::string& name, osg::ref_ptr<osg::Image>&& low, bool disableFlip);
+
+        /// Mark the image as used and load the full mipmaps again if they were dropped.
+        void request(std::string_view name);
+
+        /// Pick loaded images to be swapped in and drop the full mipmaps over budget. Should be called before the
+        /// update traversal of the given frame.
+        void update(unsigned frameNumber);
+
+        ImageStreamerStats getStats() const;
+
+    private:
+        struct StreamedImageState
+        {
+            osg::observer_ptr<StreamedImage> mImage;
+            osg::ref_ptr<osg::Image> mLow;
+            osg::ref_ptr<osg::Image> mFull;
+            osg::ref_ptr<LoadFullImageWorkItem> mLoading;
+            bool mDisableFlip = false;
+            unsigned mLastRequested = 0;
+        };
+
+        struct RetiredImage
+        {
+            osg::ref_ptr<osg::Image> mImage;
+            unsigned mFrame = 0;
+        };
+
+        const osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        const LoadFullImage mLoadFullImage;
+        const std::size_t mBudget;
+        mutable std::mutex mMutex;
+        std::map<std::string, StreamedImageState, std::less<>> mStreamedImages;
+        std::vector<RetiredImage> mRetiredImages;
+        std::vector<osg::ref_ptr<LoadFullImageWorkItem>> mAbortedLoads;
+        std::size_t mFullBytes = 0;
+        unsigned mFrame = 0;
+
+        void requestFullImage(const std::string& name, StreamedImageState& streamed);
+
+        void retire(osg::ref_ptr<osg::Image>& image);
+
+        void abort(osg::ref_ptr<LoadFullImageWorkItem>& loading);
+    };
+}
+
+#endif
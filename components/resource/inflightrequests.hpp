@@ -0,0 +1,83 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_INFLIGHTREQUESTS_H
+#define OPENMW_COMPONENTS_RESOURCE_INFLIGHTREQUESTS_H
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+namespace Resource
+{
+    /// @brief Deduplicates concurrent loading of the same resource.
+    /// @par The first request for a key runs the loader, following requests for the same key made before it is
+    /// finished wait for its result instead of loading the resource again. Exceptions are propagated to all
+    /// requesters. Requests from the thread that is already loading the key run the loader to avoid a deadlock.
+    /// @note Thread safe.
+    template <class KeyType, class ValueType>
+    class InFlightRequests
+    {
+    public:
+        template <class Loader>
+        ValueType getOrLoad(const KeyType& key, Loader&& loader)
+        {
+            std::promise<ValueType> promise;
+            {
+                std::unique_lock lock(mMutex);
+                const auto it = mRequests.find(key);
+                if (it != mRequests.end() && it->second.mThreadId != std::this_thread::get_id())
+                {
+                    std::shared_future<ValueType> future = it->second.mFuture;
+                    lock.unlock();
+                    ++mDeduplicated;
+                    return future.get();
+                }
+                if (it != mRequests.end())
+                {
+                    lock.unlock();
+                    return loader();
+                }
+                mRequests.emplace(key, Request{ std::this_thread::get_id(), promise.get_future().share() });
+            }
+
+            try
+            {
+                ValueType result = loader();
+                finish(key);
+                promise.set_value(result);
+                return result;
+            }
+            catch (...)
+            {
+                finish(key);
+                promise.set_exception(std::current_exception());
+                throw;
+            }
+        }
+
+        /// Number of requests that waited for the result of another one instead of loading the resource.
+        std::size_t getDeduplicatedCount() const { return mDeduplicated.load(); }
+
+    private:
+        struct Request
+        {
+            std::thread::id mThreadId;
+            std::shared_future<ValueType> mFuture;
+        };
+
+        std::mutex mMutex;
+        std::map<KeyType, Request, std::less<>> mRequests;
+        std::atomic<std::size_t> mDeduplicated{ 0 };
+
+        void finish(const KeyType& key)
+        {
+            const std::lock_guard lock(mMutex);
+            mRequests.erase(key);
+        }
+    };
+}
+
+#endif
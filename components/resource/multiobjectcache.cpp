@@ -21,9 +21,10 @@ namespace Resource
             ObjectCacheMap::iterator oitr = _objectCache.begin();
             while (oitr != _objectCache.end())
             {
-                if (oitr->second->referenceCount() <= 1)
+                if (oitr->second.first->referenceCount() <= 1)
                 {
-                    objectsToRemove.push_back(oitr->second);
+                    objectsToRemove.push_back(oitr->second.first);
+                    mCacheBytes -= oitr->second.second;
                     _objectCache.erase(oitr++);
                 }
                 else
@@ -41,6 +42,7 @@ namespace Resource
     {
         std::lock_guard<std::mutex> lock(_objectCacheMutex);
         _objectCache.clear();
+        mCacheBytes = 0;
     }
 
     void MultiObjectCache::addEntryToObjectCache(const std::string& filename, osg::Object* object)
@@ -50,8 +52,10 @@ namespace Resource
             OSG_ALWAYS << " trying to add NULL object to cache for " << filename << std::endl;
             return;
         }
+        const std::size_t size = mSizeEstimator != nullptr ? mSizeEstimator(*object) : 0;
         std::lock_guard<std::mutex> lock(_objectCacheMutex);
-        _objectCache.insert(std::make_pair(filename, object));
+        _objectCache.emplace(filename, std::make_pair(osg::ref_ptr<osg::Object>(object), size));
+        mCacheBytes += size;
     }
 
     osg::ref_ptr<osg::Object> MultiObjectCache::takeFromObjectCache(const std::string& fileName)
@@ -62,7 +66,8 @@ namespace Resource
             return osg::ref_ptr<osg::Object>();
         else
         {
-            osg::ref_ptr<osg::Object> object = found->second;
+            osg::ref_ptr<osg::Object> object = found->second.first;
+            mCacheBytes -= found->second.second;
             _objectCache.erase(found);
             return object;
         }
@@ -74,7 +79,7 @@ namespace Resource
 
         for (ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
         {
-            osg::Object* object = itr->second.get();
+            osg::Object* object = itr->second.first.get();
             object->releaseGLObjects(state);
         }
     }
@@ -1,13 +1,18 @@
 #ifndef OPENMW_COMPONENTS_MULTIOBJECTCACHE_H
 #define OPENMW_COMPONENTS_MULTIOBJECTCACHE_H
 
+#include <atomic>
+#include <cstddef>
 #include <map>
 #include <mutex>
 #include <string>
+#include <utility>
 
 #include <osg/Referenced>
 #include <osg/ref_ptr>
 
+#include "objectcache.hpp"
+
 namespace osg
 {
     class Object;
@@ -39,11 +44,19 @@ namespace Resource
 
         unsigned int getCacheSize() const;
 
+        /** Set function to estimate memory used by objects added after the call. */
+        void setSizeEstimator(ObjectSizeEstimator estimator) { mSizeEstimator = std::move(estimator); }
+
+        /** Get the estimated memory used by the objects in the cache in bytes. */
+        std::size_t getCacheBytes() const { return mCacheBytes; }
+
     protected:
-        typedef std::multimap<std::string, osg::ref_ptr<osg::Object>> ObjectCacheMap;
+        typedef std::multimap<std::string, std::pair<osg::ref_ptr<osg::Object>, std::size_t>> ObjectCacheMap;
 
         ObjectCacheMap _objectCache;
         mutable std::mutex _objectCacheMutex;
+        std::atomic<std::size_t> mCacheBytes{ 0 };
+        ObjectSizeEstimator mSizeEstimator;
     };
 
 }
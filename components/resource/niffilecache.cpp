@@ -0,0 +1,253 @@
+#include "niffilecache.hpp"
+
+#include <components/bsa/memorystream.hpp>
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/files/memorystream.hpp>
+#include <components/misc/strings/lower.hpp>
+#include <components/platform/file.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace Resource
+{
+    namespace
+    {
+        constexpr char nifFileCacheMagic[] = { 'O', 'M', 'W', 'N', 'I', 'F', 'F', 'C' };
+        constexpr std::uint32_t nifFileCacheVersion = 1;
+
+        struct CachedNifFile
+        {
+            std::vector<char> mName;
+            std::vector<char> mArchive;
+            std::uint64_t mArchiveSize = 0;
+            std::int64_t mArchiveModificationTime = 0;
+            std::uint64_t mContentSize = 0;
+        };
+
+        template <Serialization::Mode mode>
+        struct NifFileCacheFormat : Serialization::Format<mode, NifFileCacheFormat<mode>>
+        {
+            using Serialization::Format<mode, NifFileCacheFormat<mode>>::operator();
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, CachedNifFile>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                {
+                    visitor(*this, nifFileCacheMagic);
+                    visitor(*this, nifFileCacheVersion);
+                }
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    char magic[std::size(nifFileCacheMagic)];
+                    visitor(*this, magic);
+                    if (std::memcmp(magic, nifFileCacheMagic, sizeof(magic)) != 0)
+                        throw std::runtime_error("Bad NIF file cache magic");
+                    std::uint32_t version = 0;
+                    visitor(*this, version);
+                    if (version != nifFileCacheVersion)
+                        throw std::runtime_error("Unsupported NIF file cache version");
+                }
+                visitor(*this, value.mName);
+                visitor(*this, value.mArchive);
+                visitor(*this, value.mArchiveSize);
+                visitor(*this, value.mArchiveModificationTime);
+                visitor(*this, value.mContentSize);
+            }
+        };
+
+        /// Keeps the cache entry mapped while the content is being read.
+        class MappedInputStream : private Platform::File::ScopedMapping, public Files::MemBuf, public std::istream
+        {
+        public:
+            explicit MappedInputStream(Platform::File::ScopedMapping&& mapping, std::size_t offset)
+                : Platform::File::ScopedMapping(std::move(mapping))
+                , Files::MemBuf(this->data() + offset, this->size() - offset)
+                , std::istream(static_cast<std::streambuf*>(this))
+            {
+            }
+        };
+
+        std::string normalizeName(std::string_view name)
+        {
+            std::string result = Misc::StringUtils::lowerCase(name);
+            std::replace(result.begin(), result.end(), '\\', '/');
+            return result;
+        }
+
+        CachedNifFile makeCachedNifFile(const std::string& name, const NifFileCache::ArchiveIdentity& archive)
+        {
+            CachedNifFile result;
+            result.mName.assign(name.begin(), name.end());
+            result.mArchive.assign(archive.mName.begin(), archive.mName.end());
+            result.mArchiveSize = archive.mSize;
+            result.mArchiveModificationTime = archive.mModificationTime;
+            return result;
+        }
+
+        bool isSameSource(const CachedNifFile& l, const CachedNifFile& r)
+        {
+            return l.mName == r.mName && l.mArchive == r.mArchive && l.mArchiveSize == r.mArchiveSize
+                && l.mArchiveModificationTime == r.mArchiveModificationTime;
+        }
+    }
+
+    NifFileCache::NifFileCache(const std::filesystem::path& directory)
+        : mDirectory(directory)
+    {
+    }
+
+    Files::IStreamPtr NifFileCache::get(std::string_view name, const std::filesystem::path& archive) const
+    {
+        const std::string normalized = normalizeName(name);
+        const std::filesystem::path path = getEntryPath(normalized);
+
+        std::error_code ec;
+        if (path.empty() || !std::filesystem::is_regular_file(path, ec))
+        {
+            ++mMisses;
+            return nullptr;
+        }
+
+        try
+        {
+            const CachedNifFile expected = makeCachedNifFile(normalized, getArchiveIdentity(archive));
+
+            Platform::File::ScopedHandle handle = Platform::File::open(path);
+            const std::size_t size = Platform::File::size(handle);
+            Platform::File::ScopedMapping mapping(Platform::File::map(handle, size), size);
+
+            std::vector<char> buffer;
+            if (mapping.data() == nullptr)
+            {
+                buffer.resize(size);
+                if (Platform::File::read(handle, buffer.data(), size) != size)
+                    throw std::runtime_error("Failed to read cache entry");
+            }
+
+            const char* const data = mapping.data() != nullptr ? mapping.data() : buffer.data();
+            const std::byte* const begin = reinterpret_cast<const std::byte*>(data);
+
+            CachedNifFile cached;
+            constexpr NifFileCacheFormat<Serialization::Mode::Read> format;
+            Serialization::BinaryReader reader(begin, begin + size);
+            format(reader, cached);
+
+            if (!isSameSource(cached, expected) || cached.mContentSize > size)
+            {
+                ++mMisses;
+                return nullptr;
+            }
+
+            const std::size_t offset = size - static_cast<std::size_t>(cached.mContentSize);
+
+            ++mHits;
+
+            if (mapping.data() != nullptr)
+                return std::make_unique<MappedInputStream>(std::move(mapping), offset);
+
+            auto stream = std::make_unique<Bsa::MemoryInputStream>(size - offset);
+            std::memcpy(stream->getRawData(), buffer.data() + offset, size - offset);
+            return stream;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to read NIF file cache entry " << path << ": " << e.what();
+            ++mMisses;
+            return nullptr;
+        }
+    }
+
+    void NifFileCache::set(std::string_view name, const std::filesystem::path& archive, std::string_view content) const
+    {
+        const std::string normalized = normalizeName(name);
+        const std::filesystem::path path = getEntryPath(normalized);
+        if (path.empty())
+            return;
+
+        try
+        {
+            CachedNifFile cached = makeCachedNifFile(normalized, getArchiveIdentity(archive));
+            cached.mContentSize = content.size();
+
+            constexpr NifFileCacheFormat<Serialization::Mode::Write> format;
+            Serialization::SizeAccumulator sizeAccumulator;
+            format(sizeAccumulator, cached);
+            const std::size_t headerSize = sizeAccumulator.value();
+            std::vector<std::byte> data(headerSize + content.size());
+            Serialization::BinaryWriter writer(data.data(), data.data() + headerSize);
+            format(writer, cached);
+            std::memcpy(data.data() + headerSize, content.data(), content.size());
+
+            std::filesystem::create_directories(path.parent_path());
+            // Different threads may store the same file at once
+            std::filesystem::path tmpPath = path;
+            tmpPath += ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id()));
+            {
+                std::ofstream stream(tmpPath, std::ios_base::binary | std::ios_base::trunc);
+                stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+                if (!stream)
+                    throw std::runtime_error("Failed to write " + Files::pathToUnicodeString(tmpPath));
+            }
+            std::filesystem::rename(tmpPath, path);
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to write NIF file cache entry " << path << ": " << e.what();
+        }
+    }
+
+    NifFileCacheStats NifFileCache::getStats() const
+    {
+        return NifFileCacheStats{ mHits, mMisses };
+    }
+
+    const NifFileCache::ArchiveIdentity& NifFileCache::getArchiveIdentity(const std::filesystem::path& archive) const
+    {
+        const std::lock_guard lock(mArchivesMutex);
+        const auto it = mArchives.find(archive);
+        if (it != mArchives.end())
+            return it->second;
+        ArchiveIdentity result;
+        // The same archive may be referred by different paths by different tools
+        result.mName = Files::pathToUnicodeString(std::filesystem::weakly_canonical(archive));
+        result.mSize = static_cast<std::uint64_t>(std::filesystem::file_size(archive));
+        result.mModificationTime
+            = static_cast<std::int64_t>(std::filesystem::last_write_time(archive).time_since_epoch().count());
+        return mArchives.emplace(archive, std::move(result)).first->second;
+    }
+
+    std::filesystem::path NifFileCache::getEntryPath(std::string_view name) const
+    {
+        const std::filesystem::path relative = Files::pathFromUnicodeString(name);
+        if (relative.empty() || relative.is_absolute() || relative.has_root_name())
+            return {};
+        for (const auto& part : relative)
+            if (part == "..")
+                return {};
+        std::filesystem::path result = mDirectory / relative;
+        result += ".bin";
+        return result;
+    }
+}
@@ -0,0 +1,64 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_NIFFILECACHE_H
+#define OPENMW_COMPONENTS_RESOURCE_NIFFILECACHE_H
+
+#include <components/files/istreamptr.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace Resource
+{
+    struct NifFileCacheStats
+    {
+        std::size_t mHits = 0;
+        std::size_t mMisses = 0;
+    };
+
+    /// @brief Persistent storage for NIF files extracted from archives.
+    /// @par Each file is stored in a separate versioned entry under the cache directory mirroring its VFS path. An
+    /// entry is invalidated when size or modification time of the archive it was extracted from changes. Entries are
+    /// memory mapped when possible, so cached files are parsed directly from memory without archive lookup and
+    /// decompression. Size and modification time of each archive are read once per instance since archives are not
+    /// expected to change while they are in use.
+    /// @note Thread safe.
+    class NifFileCache
+    {
+    public:
+        struct ArchiveIdentity
+        {
+            std::string mName;
+            std::uint64_t mSize = 0;
+            std::int64_t mModificationTime = 0;
+        };
+
+        explicit NifFileCache(const std::filesystem::path& directory);
+
+        /// Get stream over the cached content of the file extracted from the given archive. Returns nullptr when there
+        /// is no valid entry.
+        Files::IStreamPtr get(std::string_view name, const std::filesystem::path& archive) const;
+
+        /// Store content of the file extracted from the given archive replacing the existing entry.
+        void set(std::string_view name, const std::filesystem::path& archive, std::string_view content) const;
+
+        NifFileCacheStats getStats() const;
+
+    private:
+        const std::filesystem::path mDirectory;
+        mutable std::atomic<std::size_t> mHits{ 0 };
+        mutable std::atomic<std::size_t> mMisses{ 0 };
+        mutable std::mutex mArchivesMutex;
+        mutable std::map<std::filesystem::path, ArchiveIdentity> mArchives;
+
+        const ArchiveIdentity& getArchiveIdentity(const std::filesystem::path& archive) const;
+
+        std::filesystem::path getEntryPath(std::string_view name) const;
+    };
+}
+
+#endif
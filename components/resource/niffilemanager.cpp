@@ -1,13 +1,19 @@
 #include "niffilemanager.hpp"
 
 #include <iostream>
+#include <iterator>
+#include <vector>
 
 #include <osg/Object>
 #include <osg/Stats>
 
+#include <components/bsa/memorystream.hpp>
+#include <components/sceneutil/workqueue.hpp>
 #include <components/vfs/manager.hpp>
 
+#include "niffilecache.hpp"
 #include "objectcache.hpp"
+#include "sizeestimator.hpp"
 
 namespace Resource
 {
@@ -15,12 +21,14 @@ namespace Resource
     class NifFileHolder : public osg::Object
     {
     public:
-        NifFileHolder(const Nif::NIFFilePtr& file)
+        NifFileHolder(const Nif::NIFFilePtr& file, std::size_t size)
             : mNifFile(file)
+            , mSize(size)
         {
         }
         NifFileHolder(const NifFileHolder& copy, const osg::CopyOp& copyop)
             : mNifFile(copy.mNifFile)
+            , mSize(copy.mSize)
         {
         }
 
@@ -29,11 +37,75 @@ namespace Resource
         META_Object(Resource, NifFileHolder)
 
         Nif::NIFFilePtr mNifFile;
+        // Parsed records take roughly the same amount of memory as the file they are read from
+        std::size_t mSize = 0;
     };
 
+    namespace
+    {
+        std::size_t estimateNifFileSize(const osg::Object& object)
+        {
+            return static_cast<const NifFileHolder&>(object).mSize;
+        }
+
+        std::size_t getStreamSize(std::istream& stream)
+        {
+            const std::istream::pos_type begin = stream.tellg();
+            stream.seekg(0, std::ios_base::end);
+            const std::istream::pos_type end = stream.tellg();
+            stream.seekg(begin);
+            if (begin == std::istream::pos_type(-1) || end == std::istream::pos_type(-1))
+            {
+                stream.clear();
+                return 0;
+            }
+            return static_cast<std::size_t>(end - begin);
+        }
+
+        std::shared_ptr<const std::vector<char>> readStream(std::istream& stream)
+        {
+            auto result = std::make_shared<std::vector<char>>();
+            if (const std::size_t size = getStreamSize(stream); size != 0)
+            {
+                result->resize(size);
+                stream.read(result->data(), static_cast<std::streamsize>(size));
+                result->resize(static_cast<std::size_t>(stream.gcount()));
+            }
+            else
+                result->assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+            return result;
+        }
+
+        class StoreNifFileWorkItem : public SceneUtil::WorkItem
+        {
+        public:
+            explicit StoreNifFileWorkItem(std::shared_ptr<const NifFileCache> cache, const std::string& name,
+                const std::filesystem::path& archive, std::shared_ptr<const std::vector<char>> content)
+                : SceneUtil::WorkItem(SceneUtil::WorkItemCategory::Cache)
+                , mCache(std::move(cache))
+                , mName(name)
+                , mArchive(archive)
+                , mContent(std::move(content))
+            {
+            }
+
+            void doWork() override
+            {
+                mCache->set(mName, mArchive, std::string_view(mContent->data(), mContent->size()));
+            }
+
+        private:
+            const std::shared_ptr<const NifFileCache> mCache;
+            const std::string mName;
+            const std::filesystem::path mArchive;
+            const std::shared_ptr<const std::vector<char>> mContent;
+        };
+    }
+
     NifFileManager::NifFileManager(const VFS::Manager* vfs)
         : ResourceManager(vfs)
     {
+        mCache->setSizeEstimator(estimateNifFileSize);
     }
 
     NifFileManager::~NifFileManager() {}
@@ -43,20 +115,64 @@ namespace Resource
         osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(name);
         if (obj)
             return static_cast<NifFileHolder*>(obj.get())->mNifFile;
-        else
-        {
-            auto file = std::make_shared<Nif::NIFFile>(name);
-            Nif::Reader reader(*file);
-            reader.parse(mVFS->get(name));
-            obj = new NifFileHolder(file);
-            mCache->addEntryToObjectCache(name, obj);
-            return file;
-        }
+        return mInFlight.getOrLoad(name, [&] { return load(name); });
+    }
+
+    Nif::NIFFilePtr NifFileManager::load(const std::string& name)
+    {
+        // Another request might have finished loading after the cache lookup
+        if (osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(name))
+            return static_cast<NifFileHolder*>(obj.get())->mNifFile;
+        auto file = std::make_shared<Nif::NIFFile>(name);
+        Nif::Reader reader(*file);
+        Files::IStreamPtr stream = open(name);
+        const std::size_t size = getStreamSize(*stream);
+        reader.parse(std::move(stream));
+        mCache->addEntryToObjectCache(name, new NifFileHolder(file, size));
+        return file;
     }
 
     void NifFileManager::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         stats->setAttribute(frameNumber, "Nif", mCache->getCacheSize());
+        stats->setAttribute(frameNumber, "Nif MB", toMegabytes(mCache->getCacheBytes()));
+        stats->setAttribute(frameNumber, "Nif Deduplicated", static_cast<double>(mInFlight.getDeduplicatedCount()));
+
+        if (mFileCache != nullptr)
+        {
+            const NifFileCacheStats cacheStats = mFileCache->getStats();
+            stats->setAttribute(frameNumber, "Nif Cache Hits", static_cast<double>(cacheStats.mHits));
+            stats->setAttribute(frameNumber, "Nif Cache Misses", static_cast<double>(cacheStats.mMisses));
+        }
+    }
+
+    void NifFileManager::setFileCache(
+        std::shared_ptr<const NifFileCache> cache, osg::ref_ptr<SceneUtil::WorkQueue> workQueue)
+    {
+        mFileCache = std::move(cache);
+        mWorkQueue = std::move(workQueue);
+    }
+
+    Files::IStreamPtr NifFileManager::open(const std::string& name) const
+    {
+        if (mFileCache == nullptr)
+            return mVFS->get(name);
+
+        // Loose files and files of uncompressed archives are read as fast as the cache entries would be
+        const std::filesystem::path archive = mVFS->getCompressedArchivePath(name);
+        if (archive.empty())
+            return mVFS->get(name);
+
+        if (Files::IStreamPtr cached = mFileCache->get(name, archive))
+            return cached;
+
+        std::shared_ptr<const std::vector<char>> content = readStream(*mVFS->get(name));
+        // Writing the entry takes longer than parsing the file, so don't make the caller wait for it
+        if (mWorkQueue != nullptr)
+            mWorkQueue->addWorkItem(new StoreNifFileWorkItem(mFileCache, name, archive, content));
+        else
+            mFileCache->set(name, archive, std::string_view(content->data(), content->size()));
+        return std::make_unique<Bsa::SharedMemoryInputStream>(std::move(content));
     }
 
 }
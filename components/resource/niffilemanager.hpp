@@ -3,12 +3,21 @@
 
 #include <osg/ref_ptr>
 
+#include <memory>
+
 #include <components/nif/niffile.hpp>
 
+#include "inflightrequests.hpp"
 #include "resourcemanager.hpp"
 
+namespace SceneUtil
+{
+    class WorkQueue;
+}
+
 namespace Resource
 {
+    class NifFileCache;
 
     /// @brief Handles caching of NIFFiles.
     /// @note May be used from any thread.
@@ -24,6 +33,19 @@ namespace Resource
         Nif::NIFFilePtr get(const std::string& name);
 
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const override;
+
+        /// Load NIF files extracted from compressed archives from the cache and store them there. New entries are
+        /// written by the work queue when it is given.
+        void setFileCache(std::shared_ptr<const NifFileCache> cache, osg::ref_ptr<SceneUtil::WorkQueue> workQueue);
+
+    private:
+        std::shared_ptr<const NifFileCache> mFileCache;
+        osg::ref_ptr<SceneUtil::WorkQueue> mWorkQueue;
+        InFlightRequests<std::string, Nif::NIFFilePtr> mInFlight;
+
+        Nif::NIFFilePtr load(const std::string& name);
+
+        Files::IStreamPtr open(const std::string& name) const;
     };
 
 }
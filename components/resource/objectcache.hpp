@@ -3,6 +3,9 @@
 // - removeExpiredObjectsInCache no longer keeps a lock while the unref happens.
 // - template allows customized KeyType.
 // - objects with uninitialized time stamp are not removed.
+// - objects are stored in hash sharded maps each guarded by its own mutex.
+// - time stamps are updated and expired objects are removed incrementally, few shards per call.
+// - optional estimation of the memory used by cached objects.
 
 /* -*-c++-*- OpenSceneGraph - Copyright (C) 1998-2006 Robert Osfield
  *
@@ -22,11 +25,22 @@
 
 #include <osg/Node>
 #include <osg/Referenced>
+#include <osg/Vec2f>
 #include <osg/ref_ptr>
 
-#include <map>
+#include <components/misc/hash.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
 #include <mutex>
 #include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace osg
 {
@@ -37,11 +51,75 @@ namespace osg
 
 namespace Resource
 {
+    namespace ObjectCacheDetail
+    {
+        template <class T>
+        std::size_t hashKey(const T& value)
+        {
+            return std::hash<T>()(value);
+        }
+
+        inline std::size_t hashKey(const osg::Vec2f& value)
+        {
+            std::size_t seed = 0;
+            Misc::hashCombine(seed, value.x());
+            Misc::hashCombine(seed, value.y());
+            return seed;
+        }
+
+        template <class First, class Second>
+        std::size_t hashKey(const std::pair<First, Second>& value)
+        {
+            std::size_t seed = 0;
+            Misc::hashCombine(seed, hashKey(value.first));
+            Misc::hashCombine(seed, hashKey(value.second));
+            return seed;
+        }
+
+        template <class... Types>
+        std::size_t hashKey(const std::tuple<Types...>& value)
+        {
+            std::size_t seed = 0;
+            std::apply([&](const auto&... v) { (Misc::hashCombine(seed, hashKey(v)), ...); }, value);
+            return seed;
+        }
+
+        struct KeyHash
+        {
+            template <class T>
+            std::size_t operator()(const T& value) const
+            {
+                return hashKey(value);
+            }
+        };
+    }
+
+    /// Estimates memory used by a cached object in bytes.
+    using ObjectSizeEstimator = std::function<std::size_t(const osg::Object& object)>;
+
+    /// Unreferenced cached object which may be removed to fit into the memory budget.
+    struct CacheEvictionCandidate
+    {
+        double mTimeStamp;
+        std::size_t mSize;
+    };
 
     template <typename KeyType>
     class GenericObjectCache : public osg::Referenced
     {
     public:
+        /// Number of independently locked parts of the cache.
+        static constexpr std::size_t sShardsCount = 16;
+
+        /// Number of shards visited by a single call of updateTimeStampOfObjectsInCacheWithExternalReferences or
+        /// removeExpiredObjectsInCache.
+        static constexpr std::size_t sShardsPerSweep = 2;
+
+        /// Number of calls required to visit the whole cache.
+        static constexpr std::size_t sSweepPeriod = sShardsCount / sShardsPerSweep;
+
+        static_assert(sShardsCount % sShardsPerSweep == 0);
+
         GenericObjectCache()
             : osg::Referenced(true)
         {
@@ -52,37 +130,49 @@ namespace Resource
          * for that object in the cache to specified time.
          * This would typically be called once per frame by applications which are doing database paging,
          * and need to prune objects that are no longer required.
-         * The time used should be taken from the FrameStamp::getReferenceTime().*/
+         * The time used should be taken from the FrameStamp::getReferenceTime().
+         * Only sShardsPerSweep shards are visited per call so the cost is spread over sSweepPeriod calls.*/
         void updateTimeStampOfObjectsInCacheWithExternalReferences(double referenceTime)
         {
-            // look for objects with external references and update their time stamp.
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for (typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
+            const std::size_t first = mUpdateCursor.fetch_add(sShardsPerSweep, std::memory_order_relaxed);
+            for (std::size_t i = 0; i < sShardsPerSweep; ++i)
             {
-                // If ref count is greater than 1, the object has an external reference.
-                // If the timestamp is yet to be initialized, it needs to be updated too.
-                if (itr->second.first->referenceCount() > 1 || itr->second.second == 0.0)
-                    itr->second.second = referenceTime;
+                Shard& shard = mShards[(first + i) % sShardsCount];
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                // look for objects with external references and update their time stamp.
+                for (auto& [key, value] : shard.mObjects)
+                {
+                    // If ref count is greater than 1, the object has an external reference.
+                    // If the timestamp is yet to be initialized, it needs to be updated too.
+                    if (value.mObject->referenceCount() > 1 || value.mTimeStamp == 0.0)
+                        value.mTimeStamp = referenceTime;
+                }
             }
         }
 
         /** Removed object in the cache which have a time stamp at or before the specified expiry time.
          * This would typically be called once per frame by applications which are doing database paging,
          * and need to prune objects that are no longer required, and called after the a called
-         * after the call to updateTimeStampOfObjectsInCacheWithExternalReferences(expirtyTime).*/
+         * after the call to updateTimeStampOfObjectsInCacheWithExternalReferences(expirtyTime).
+         * Only sShardsPerSweep shards are visited per call. Objects with external references are never removed
+         * because their time stamps may not be updated yet.*/
         void removeExpiredObjectsInCache(double expiryTime)
         {
             std::vector<osg::ref_ptr<osg::Object>> objectsToRemove;
+            const std::size_t first = mExpiryCursor.fetch_add(sShardsPerSweep, std::memory_order_relaxed);
+            for (std::size_t i = 0; i < sShardsPerSweep; ++i)
             {
-                std::lock_guard<std::mutex> lock(_objectCacheMutex);
+                Shard& shard = mShards[(first + i) % sShardsCount];
+                std::lock_guard<std::mutex> lock(shard.mMutex);
                 // Remove expired entries from object cache
-                typename ObjectCacheMap::iterator oitr = _objectCache.begin();
-                while (oitr != _objectCache.end())
+                auto oitr = shard.mObjects.begin();
+                while (oitr != shard.mObjects.end())
                 {
-                    if (oitr->second.second <= expiryTime)
+                    if (oitr->second.mTimeStamp != 0.0 && oitr->second.mTimeStamp <= expiryTime
+                        && oitr->second.mObject->referenceCount() <= 1)
                     {
-                        objectsToRemove.push_back(oitr->second.first);
-                        _objectCache.erase(oitr++);
+                        objectsToRemove.push_back(std::move(oitr->second.mObject));
+                        oitr = erase(shard, oitr);
                     }
                     else
                         ++oitr;
@@ -95,33 +185,50 @@ namespace Resource
         /** Remove all objects in the cache regardless of having external references or expiry times.*/
         void clear()
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            _objectCache.clear();
+            for (Shard& shard : mShards)
+            {
+                ObjectCacheMap objects;
+                {
+                    std::lock_guard<std::mutex> lock(shard.mMutex);
+                    objects.swap(shard.mObjects);
+                    for (const auto& [key, value] : objects)
+                        mCacheBytes -= value.mSize;
+                }
+            }
         }
 
         /** Add a key,object,timestamp triple to the Registry::ObjectCache.*/
         void addEntryToObjectCache(const KeyType& key, osg::Object* object, double timestamp = 0.0)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            _objectCache[key] = ObjectTimeStampPair(object, timestamp);
+            const std::size_t size = object != nullptr && mSizeEstimator != nullptr ? mSizeEstimator(*object) : 0;
+            Shard& shard = getShard(key);
+            osg::ref_ptr<osg::Object> replaced;
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            Item& item = shard.mObjects[key];
+            mCacheBytes -= item.mSize;
+            mCacheBytes += size;
+            replaced = std::move(item.mObject);
+            item = Item{ object, timestamp, size };
         }
 
         /** Remove Object from cache.*/
         void removeFromObjectCache(const KeyType& key)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr != _objectCache.end())
-                _objectCache.erase(itr);
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            const auto itr = shard.mObjects.find(key);
+            if (itr != shard.mObjects.end())
+                erase(shard, itr);
         }
 
         /** Get an ref_ptr<Object> from the object cache*/
         osg::ref_ptr<osg::Object> getRefFromObjectCache(const KeyType& key)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr != _objectCache.end())
-                return itr->second.first;
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            const auto itr = shard.mObjects.find(key);
+            if (itr != shard.mObjects.end())
+                return itr->second.mObject;
             else
                 return nullptr;
         }
@@ -129,11 +236,12 @@ namespace Resource
         /** Check if an object is in the cache, and if it is, update its usage time stamp. */
         bool checkInObjectCache(const KeyType& key, double timeStamp)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            typename ObjectCacheMap::iterator itr = _objectCache.find(key);
-            if (itr != _objectCache.end())
+            Shard& shard = getShard(key);
+            std::lock_guard<std::mutex> lock(shard.mMutex);
+            const auto itr = shard.mObjects.find(key);
+            if (itr != shard.mObjects.end())
             {
-                itr->second.second = timeStamp;
+                itr->second.mTimeStamp = timeStamp;
                 return true;
             }
             else
@@ -143,26 +251,29 @@ namespace Resource
         /** call releaseGLObjects on all objects attached to the object cache.*/
         void releaseGLObjects(osg::State* state)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for (typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
+            for (Shard& shard : mShards)
             {
-                osg::Object* object = itr->second.first.get();
-                object->releaseGLObjects(state);
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                for (auto& [key, value] : shard.mObjects)
+                    value.mObject->releaseGLObjects(state);
             }
         }
 
         /** call node->accept(nv); for all nodes in the objectCache. */
         void accept(osg::NodeVisitor& nv)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for (typename ObjectCacheMap::iterator itr = _objectCache.begin(); itr != _objectCache.end(); ++itr)
+            for (Shard& shard : mShards)
             {
-                osg::Object* object = itr->second.first.get();
-                if (object)
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                for (auto& [key, value] : shard.mObjects)
                 {
-                    osg::Node* node = dynamic_cast<osg::Node*>(object);
-                    if (node)
-                        node->accept(nv);
+                    osg::Object* object = value.mObject.get();
+                    if (object)
+                    {
+                        osg::Node* node = dynamic_cast<osg::Node*>(object);
+                        if (node)
+                            node->accept(nv);
+                    }
                 }
             }
         }
@@ -171,26 +282,106 @@ namespace Resource
         template <class Functor>
         void call(Functor& f)
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            for (typename ObjectCacheMap::iterator it = _objectCache.begin(); it != _objectCache.end(); ++it)
-                f(it->first, it->second.first.get());
+            for (Shard& shard : mShards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                for (auto& [key, value] : shard.mObjects)
+                    f(key, value.mObject.get());
+            }
         }
 
         /** Get the number of objects in the cache. */
         unsigned int getCacheSize() const
         {
-            std::lock_guard<std::mutex> lock(_objectCacheMutex);
-            return _objectCache.size();
+            std::size_t result = 0;
+            for (const Shard& shard : mShards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                result += shard.mObjects.size();
+            }
+            return static_cast<unsigned int>(result);
+        }
+
+        /** Set function to estimate memory used by objects added after the call. Without estimator objects are
+         * accounted with zero size.*/
+        void setSizeEstimator(ObjectSizeEstimator estimator) { mSizeEstimator = std::move(estimator); }
+
+        /** Get the estimated memory used by the objects in the cache in bytes. */
+        std::size_t getCacheBytes() const { return mCacheBytes; }
+
+        /** Append objects without external references and with initialized time stamp to the output. */
+        void collectEvictionCandidates(std::vector<CacheEvictionCandidate>& out) const
+        {
+            for (const Shard& shard : mShards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                for (const auto& [key, value] : shard.mObjects)
+                    if (value.mTimeStamp != 0.0 && value.mObject->referenceCount() <= 1)
+                        out.push_back(CacheEvictionCandidate{ value.mTimeStamp, value.mSize });
+            }
+        }
+
+        /** Remove all objects without external references which have a time stamp at or before the specified time
+         * regardless of the sweep progress. Returns the number of removed objects.*/
+        std::size_t evictObjectsInCache(double timeStamp)
+        {
+            std::vector<osg::ref_ptr<osg::Object>> objectsToRemove;
+            for (Shard& shard : mShards)
+            {
+                std::lock_guard<std::mutex> lock(shard.mMutex);
+                auto oitr = shard.mObjects.begin();
+                while (oitr != shard.mObjects.end())
+                {
+                    if (oitr->second.mTimeStamp != 0.0 && oitr->second.mTimeStamp <= timeStamp
+                        && oitr->second.mObject->referenceCount() <= 1)
+                    {
+                        objectsToRemove.push_back(std::move(oitr->second.mObject));
+                        oitr = erase(shard, oitr);
+                    }
+                    else
+                        ++oitr;
+                }
+            }
+            // note, actual unref happens outside of the lock
+            return objectsToRemove.size();
         }
 
     protected:
         virtual ~GenericObjectCache() {}
 
-        typedef std::pair<osg::ref_ptr<osg::Object>, double> ObjectTimeStampPair;
-        typedef std::map<KeyType, ObjectTimeStampPair> ObjectCacheMap;
+        struct Item
+        {
+            osg::ref_ptr<osg::Object> mObject;
+            double mTimeStamp = 0.0;
+            std::size_t mSize = 0;
+        };
+
+        typedef std::unordered_map<KeyType, Item, ObjectCacheDetail::KeyHash> ObjectCacheMap;
 
-        ObjectCacheMap _objectCache;
-        mutable std::mutex _objectCacheMutex;
+        struct Shard
+        {
+            mutable std::mutex mMutex;
+            ObjectCacheMap mObjects;
+        };
+
+        std::array<Shard, sShardsCount> mShards;
+        std::atomic<std::size_t> mUpdateCursor{ 0 };
+        std::atomic<std::size_t> mExpiryCursor{ 0 };
+        std::atomic<std::size_t> mCacheBytes{ 0 };
+        ObjectSizeEstimator mSizeEstimator;
+
+        Shard& getShard(const KeyType& key)
+        {
+            // Use high bits of the mixed hash to keep shard selection independent from buckets inside the shard
+            const std::uint64_t hash = static_cast<std::uint64_t>(ObjectCacheDetail::hashKey(key));
+            return mShards[((hash * 0x9E3779B97F4A7C15ull) >> 32) % sShardsCount];
+        }
+
+        typename ObjectCacheMap::iterator erase(Shard& shard, typename ObjectCacheMap::iterator itr)
+        {
+            mCacheBytes -= itr->second.mSize;
+            return shard.mObjects.erase(itr);
+        }
     };
 
     class ObjectCache : public GenericObjectCache<std::string>
@@ -3,6 +3,9 @@
 
 #include <osg/ref_ptr>
 
+#include <cstddef>
+#include <vector>
+
 #include "objectcache.hpp"
 
 namespace VFS
@@ -28,6 +31,13 @@ namespace Resource
         virtual void setExpiryDelay(double expiryDelay) {}
         virtual void reportStats(unsigned int frameNumber, osg::Stats* stats) const {}
         virtual void releaseGLObjects(osg::State* state) {}
+
+        /// Estimated memory used by the cached objects in bytes.
+        virtual std::size_t getCacheBytes() const { return 0; }
+        /// Append cached objects which may be evicted to fit into the memory budget.
+        virtual void collectEvictionCandidates(std::vector<CacheEvictionCandidate>& out) const {}
+        /// Remove unreferenced cached objects last used at or before the given time, return number of removed ones.
+        virtual std::size_t evictCache(double timeStamp) { return 0; }
     };
 
     /// @brief Base class for managers that require a virtual file system and object cache.
@@ -68,6 +78,15 @@ namespace Resource
 
         void releaseGLObjects(osg::State* state) override { mCache->releaseGLObjects(state); }
 
+        std::size_t getCacheBytes() const override { return mCache->getCacheBytes(); }
+
+        void collectEvictionCandidates(std::vector<CacheEvictionCandidate>& out) const override
+        {
+            mCache->collectEvictionCandidates(out);
+        }
+
+        std::size_t evictCache(double timeStamp) override { return mCache->evictObjectsInCache(timeStamp); }
+
     protected:
         const VFS::Manager* mVFS;
         osg::ref_ptr<CacheType> mCache;
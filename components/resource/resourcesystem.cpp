@@ -2,10 +2,15 @@
 
 #include <algorithm>
 
+#include <osg/Stats>
+
+#include <components/bsa/decompressioncache.hpp>
+
 #include "imagemanager.hpp"
 #include "keyframemanager.hpp"
 #include "niffilemanager.hpp"
 #include "scenemanager.hpp"
+#include "sizeestimator.hpp"
 
 namespace Resource
 {
@@ -63,11 +68,70 @@ namespace Resource
         mNifFileManager->setExpiryDelay(0.0);
     }
 
+    void ResourceSystem::setMemoryBudget(std::size_t bytes)
+    {
+        mMemoryBudget = bytes;
+    }
+
     void ResourceSystem::updateCache(double referenceTime)
     {
         for (std::vector<BaseResourceManager*>::iterator it = mResourceManagers.begin(); it != mResourceManagers.end();
              ++it)
             (*it)->updateCache(referenceTime);
+
+        evictCache(referenceTime);
+    }
+
+    void ResourceSystem::evictCache(double referenceTime)
+    {
+        std::size_t cacheBytes = 0;
+        for (const BaseResourceManager* manager : mResourceManagers)
+            cacheBytes += manager->getCacheBytes();
+        mCacheBytes = cacheBytes;
+
+        if (mMemoryBudget == 0 || cacheBytes <= mMemoryBudget)
+            return;
+
+        const std::lock_guard lock(mEvictionMutex);
+
+        // When referenced objects alone exceed the budget there is nothing to evict, so don't collect candidates
+        // every frame until the caches grow or enough time passes for more objects to become unreferenced.
+        constexpr double retryDelay = 1;
+        if (cacheBytes <= mLastEvictionBytes && referenceTime < mLastEvictionTime + retryDelay)
+            return;
+
+        std::vector<CacheEvictionCandidate> candidates;
+        for (const BaseResourceManager* manager : mResourceManagers)
+            manager->collectEvictionCandidates(candidates);
+
+        // Least recently used first, bigger objects first among the ones used at the same time
+        std::sort(candidates.begin(), candidates.end(),
+            [](const CacheEvictionCandidate& l, const CacheEvictionCandidate& r) {
+                if (l.mTimeStamp != r.mTimeStamp)
+                    return l.mTimeStamp < r.mTimeStamp;
+                return l.mSize > r.mSize;
+            });
+
+        std::size_t remaining = cacheBytes;
+        double evictionTime = 0;
+        for (const CacheEvictionCandidate& candidate : candidates)
+        {
+            if (remaining <= mMemoryBudget)
+                break;
+            remaining -= std::min(remaining, candidate.mSize);
+            evictionTime = candidate.mTimeStamp;
+        }
+
+        if (evictionTime != 0)
+        {
+            std::size_t evicted = 0;
+            for (BaseResourceManager* manager : mResourceManagers)
+                evicted += manager->evictCache(evictionTime);
+            mEvictedObjects += evicted;
+        }
+
+        mLastEvictionTime = referenceTime;
+        mLastEvictionBytes = remaining;
     }
 
     void ResourceSystem::clearCache()
@@ -95,11 +159,31 @@ namespace Resource
         return mVFS;
     }
 
+    void ResourceSystem::setDecompressionCache(std::shared_ptr<const Bsa::DecompressionCache> cache)
+    {
+        mDecompressionCache = std::move(cache);
+    }
+
     void ResourceSystem::reportStats(unsigned int frameNumber, osg::Stats* stats) const
     {
         for (std::vector<BaseResourceManager*>::const_iterator it = mResourceManagers.begin();
              it != mResourceManagers.end(); ++it)
             (*it)->reportStats(frameNumber, stats);
+
+        stats->setAttribute(frameNumber, "Resource MB", toMegabytes(mCacheBytes));
+        if (mMemoryBudget != 0)
+            stats->setAttribute(frameNumber, "Resource Budget MB", toMegabytes(mMemoryBudget));
+        stats->setAttribute(frameNumber, "Resource Evicted", static_cast<double>(mEvictedObjects));
+
+        if (mDecompressionCache != nullptr)
+        {
+            const Bsa::DecompressionCacheStats cacheStats = mDecompressionCache->getStats();
+            constexpr double megabyte = 1024.0 * 1024.0;
+            stats->setAttribute(frameNumber, "BSA Cache Hits", static_cast<double>(cacheStats.mHits));
+            stats->setAttribute(frameNumber, "BSA Cache Misses", static_cast<double>(cacheStats.mMisses));
+            stats->setAttribute(frameNumber, "BSA Cache Saved MB", cacheStats.mBytesSaved / megabyte);
+            stats->setAttribute(frameNumber, "BSA Cache Size MB", cacheStats.mCachedBytes / megabyte);
+        }
     }
 
     void ResourceSystem::releaseGLObjects(osg::State* state)
@@ -1,7 +1,10 @@
 #ifndef OPENMW_COMPONENTS_RESOURCE_RESOURCESYSTEM_H
 #define OPENMW_COMPONENTS_RESOURCE_RESOURCESYSTEM_H
 
+#include <atomic>
+#include <cstddef>
 #include <memory>
+#include <mutex>
 #include <vector>
 
 namespace VFS
@@ -9,6 +12,11 @@ namespace VFS
     class Manager;
 }
 
+namespace Bsa
+{
+    class DecompressionCache;
+}
+
 namespace osg
 {
     class Stats;
@@ -39,7 +47,8 @@ namespace Resource
         KeyframeManager* getKeyframeManager();
 
         /// Indicates to each resource manager to clear the cache, i.e. to drop cached objects that are no longer
-        /// referenced.
+        /// referenced. When the memory budget is exceeded, least recently used unreferenced objects are dropped
+        /// from all resource managers regardless of the expiry delay.
         /// @note May be called from any thread if you do not add or remove resource managers at that point.
         void updateCache(double referenceTime);
 
@@ -57,9 +66,15 @@ namespace Resource
         /// How long to keep objects in cache after no longer being referenced.
         void setExpiryDelay(double expiryDelay);
 
+        /// Limit estimated memory used by the caches of all resource managers. 0 means no limit.
+        void setMemoryBudget(std::size_t bytes);
+
         /// @note May be called from any thread.
         const VFS::Manager* getVFS() const;
 
+        /// Report stats of the cache used by the compressed archives of the VFS.
+        void setDecompressionCache(std::shared_ptr<const Bsa::DecompressionCache> cache);
+
         void reportStats(unsigned int frameNumber, osg::Stats* stats) const;
 
         /// Call releaseGLObjects for each resource manager.
@@ -77,6 +92,17 @@ namespace Resource
 
         const VFS::Manager* mVFS;
 
+        std::shared_ptr<const Bsa::DecompressionCache> mDecompressionCache;
+
+        std::size_t mMemoryBudget = 0;
+        std::mutex mEvictionMutex;
+        double mLastEvictionTime = 0;
+        std::size_t mLastEvictionBytes = 0;
+        std::atomic<std::size_t> mCacheBytes{ 0 };
+        std::atomic<std::size_t> mEvictedObjects{ 0 };
+
+        void evictCache(double referenceTime);
+
         ResourceSystem(const ResourceSystem&);
         void operator=(const ResourceSystem&);
     };
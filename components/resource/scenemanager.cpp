@@ -53,6 +53,7 @@
 #include "imagemanager.hpp"
 #include "niffilemanager.hpp"
 #include "objectcache.hpp"
+#include "sizeestimator.hpp"
 
 namespace
 {
@@ -372,6 +373,7 @@ namespace Resource
         , mUnRefImageDataAfterApply(false)
         , mParticleSystemMask(~0u)
     {
+        mCache->setSizeEstimator(estimateNodeSize);
     }
 
     void SceneManager::setForceShaders(bool force)
@@ -838,70 +840,75 @@ namespace Resource
         osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(normalized);
         if (obj)
             return osg::ref_ptr<const osg::Node>(static_cast<osg::Node*>(obj.get()));
-        else
-        {
-            osg::ref_ptr<osg::Node> loaded;
-            try
-            {
-                loaded = load(normalized, mVFS, mImageManager, mNifFileManager);
+        return mInFlight.getOrLoad(normalized, [&] { return loadTemplate(name, normalized, compile); });
+    }
 
-                SceneUtil::ProcessExtraDataVisitor extraDataVisitor(this);
-                loaded->accept(extraDataVisitor);
-            }
-            catch (const std::exception& e)
-            {
-                static osg::ref_ptr<osg::Node> errorMarkerNode = [&] {
-                    static const char* const sMeshTypes[] = { "nif", "osg", "osgt", "osgb", "osgx", "osg2", "dae" };
+    osg::ref_ptr<const osg::Node> SceneManager::loadTemplate(
+        const std::string& name, std::string normalized, bool compile)
+    {
+        // Another request might have finished loading after the cache lookup
+        if (osg::ref_ptr<osg::Object> obj = mCache->getRefFromObjectCache(normalized))
+            return osg::ref_ptr<const osg::Node>(static_cast<osg::Node*>(obj.get()));
 
-                    for (unsigned int i = 0; i < sizeof(sMeshTypes) / sizeof(sMeshTypes[0]); ++i)
-                    {
-                        normalized = "meshes/marker_error." + std::string(sMeshTypes[i]);
-                        if (mVFS->exists(normalized))
-                            return load(normalized, mVFS, mImageManager, mNifFileManager);
-                    }
-                    Files::IMemStream file(ErrorMarker::sValue.data(), ErrorMarker::sValue.size());
-                    return loadNonNif("error_marker.osgt", file, mImageManager);
-                }();
+        osg::ref_ptr<osg::Node> loaded;
+        try
+        {
+            loaded = load(normalized, mVFS, mImageManager, mNifFileManager);
 
-                Log(Debug::Error) << "Failed to load '" << name << "': " << e.what() << ", using marker_error instead";
-                loaded = static_cast<osg::Node*>(errorMarkerNode->clone(osg::CopyOp::DEEP_COPY_ALL));
-            }
+            SceneUtil::ProcessExtraDataVisitor extraDataVisitor(this);
+            loaded->accept(extraDataVisitor);
+        }
+        catch (const std::exception& e)
+        {
+            static osg::ref_ptr<osg::Node> errorMarkerNode = [&] {
+                static const char* const sMeshTypes[] = { "nif", "osg", "osgt", "osgb", "osgx", "osg2", "dae" };
 
-            // set filtering settings
-            SetFilterSettingsVisitor setFilterSettingsVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
-            loaded->accept(setFilterSettingsVisitor);
-            SetFilterSettingsControllerVisitor setFilterSettingsControllerVisitor(
-                mMinFilter, mMagFilter, mMaxAnisotropy);
-            loaded->accept(setFilterSettingsControllerVisitor);
+                for (unsigned int i = 0; i < sizeof(sMeshTypes) / sizeof(sMeshTypes[0]); ++i)
+                {
+                    normalized = "meshes/marker_error." + std::string(sMeshTypes[i]);
+                    if (mVFS->exists(normalized))
+                        return load(normalized, mVFS, mImageManager, mNifFileManager);
+                }
+                Files::IMemStream file(ErrorMarker::sValue.data(), ErrorMarker::sValue.size());
+                return loadNonNif("error_marker.osgt", file, mImageManager);
+            }();
 
-            SceneUtil::ReplaceDepthVisitor replaceDepthVisitor;
-            loaded->accept(replaceDepthVisitor);
+            Log(Debug::Error) << "Failed to load '" << name << "': " << e.what() << ", using marker_error instead";
+            loaded = static_cast<osg::Node*>(errorMarkerNode->clone(osg::CopyOp::DEEP_COPY_ALL));
+        }
 
-            osg::ref_ptr<Shader::ShaderVisitor> shaderVisitor(createShaderVisitor());
-            loaded->accept(*shaderVisitor);
+        // set filtering settings
+        SetFilterSettingsVisitor setFilterSettingsVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
+        loaded->accept(setFilterSettingsVisitor);
+        SetFilterSettingsControllerVisitor setFilterSettingsControllerVisitor(mMinFilter, mMagFilter, mMaxAnisotropy);
+        loaded->accept(setFilterSettingsControllerVisitor);
 
-            if (canOptimize(normalized))
-            {
-                SceneUtil::Optimizer optimizer;
-                optimizer.setSharedStateManager(mSharedStateManager, &mSharedStateMutex);
-                optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
+        SceneUtil::ReplaceDepthVisitor replaceDepthVisitor;
+        loaded->accept(replaceDepthVisitor);
 
-                static const unsigned int options
-                    = getOptimizationOptions() | SceneUtil::Optimizer::SHARE_DUPLICATE_STATE;
+        osg::ref_ptr<Shader::ShaderVisitor> shaderVisitor(createShaderVisitor());
+        loaded->accept(*shaderVisitor);
 
-                optimizer.optimize(loaded, options);
-            }
-            else
-                shareState(loaded);
+        if (canOptimize(normalized))
+        {
+            SceneUtil::Optimizer optimizer;
+            optimizer.setSharedStateManager(mSharedStateManager, &mSharedStateMutex);
+            optimizer.setIsOperationPermissibleForObjectCallback(new CanOptimizeCallback);
 
-            if (compile && mIncrementalCompileOperation)
-                mIncrementalCompileOperation->add(loaded);
-            else
-                loaded->getBound();
+            static const unsigned int options = getOptimizationOptions() | SceneUtil::Optimizer::SHARE_DUPLICATE_STATE;
 
-            mCache->addEntryToObjectCache(normalized, loaded);
-            return loaded;
+            optimizer.optimize(loaded, options);
         }
+        else
+            shareState(loaded);
+
+        if (compile && mIncrementalCompileOperation)
+            mIncrementalCompileOperation->add(loaded);
+        else
+            loaded->getBound();
+
+        mCache->addEntryToObjectCache(normalized, loaded);
+        return loaded;
     }
 
     osg::ref_ptr<osg::Node> SceneManager::getInstance(const std::string& name)
@@ -1094,6 +1101,8 @@ namespace Resource
         }
 
         stats->setAttribute(frameNumber, "Node", mCache->getCacheSize());
+        stats->setAttribute(frameNumber, "Node MB", toMegabytes(mCache->getCacheBytes()));
+        stats->setAttribute(frameNumber, "Node Deduplicated", static_cast<double>(mInFlight.getDeduplicatedCount()));
     }
 
     Shader::ShaderVisitor* SceneManager::createShaderVisitor(const std::string& shaderPrefix)
@@ -8,6 +8,7 @@
 #include <osg/Texture>
 #include <osg/ref_ptr>
 
+#include "inflightrequests.hpp"
 #include "resourcemanager.hpp"
 
 #include <components/sceneutil/lightmanager.hpp>
@@ -227,6 +228,8 @@ namespace Resource
         bool getSoftParticles() const { return mSoftParticles; }
 
     private:
+        osg::ref_ptr<const osg::Node> loadTemplate(const std::string& name, std::string normalized, bool compile);
+
         Shader::ShaderVisitor* createShaderVisitor(const std::string& shaderPrefix = "objects");
 
         std::unique_ptr<Shader::ShaderManager> mShaderManager;
@@ -261,6 +264,8 @@ namespace Resource
 
         unsigned int mParticleSystemMask;
 
+        InFlightRequests<std::string, osg::ref_ptr<const osg::Node>> mInFlight;
+
         SceneManager(const SceneManager&);
         void operator=(const SceneManager&);
     };
@@ -0,0 +1,139 @@
+#include "sizeestimator.hpp"
+
+#include <osg/Geometry>
+#include <osg/Image>
+#include <osg/NodeVisitor>
+
+#include <BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h>
+#include <BulletCollision/CollisionShapes/btCompoundShape.h>
+#include <BulletCollision/CollisionShapes/btOptimizedBvh.h>
+#include <BulletCollision/CollisionShapes/btStridingMeshInterface.h>
+
+#include "bulletshape.hpp"
+
+namespace Resource
+{
+    namespace
+    {
+        std::size_t getArraySize(const osg::Array* array)
+        {
+            return array != nullptr ? array->getTotalDataSize() : 0;
+        }
+
+        class NodeSizeVisitor : public osg::NodeVisitor
+        {
+        public:
+            std::size_t mSize = 0;
+
+            NodeSizeVisitor()
+                : osg::NodeVisitor(TRAVERSE_ALL_CHILDREN)
+            {
+            }
+
+            void apply(osg::Node& node) override
+            {
+                mSize += sizeof(osg::Node);
+                traverse(node);
+            }
+
+            void apply(osg::Drawable& drawable) override
+            {
+                mSize += sizeof(osg::Drawable);
+
+                const osg::Geometry* geometry = drawable.asGeometry();
+                if (geometry == nullptr)
+                    return;
+
+                mSize += getArraySize(geometry->getVertexArray());
+                mSize += getArraySize(geometry->getNormalArray());
+                mSize += getArraySize(geometry->getColorArray());
+                mSize += getArraySize(geometry->getSecondaryColorArray());
+                mSize += getArraySize(geometry->getFogCoordArray());
+                for (const osg::ref_ptr<osg::Array>& array : geometry->getTexCoordArrayList())
+                    mSize += getArraySize(array.get());
+                for (const osg::ref_ptr<osg::Array>& array : geometry->getVertexAttribArrayList())
+                    mSize += getArraySize(array.get());
+                for (const osg::ref_ptr<osg::PrimitiveSet>& primitiveSet : geometry->getPrimitiveSetList())
+                    mSize += primitiveSet->getTotalDataSize();
+            }
+        };
+
+        std::size_t estimateMeshInterfaceSize(const btStridingMeshInterface& mesh)
+        {
+            std::size_t result = 0;
+            for (int i = 0, n = mesh.getNumSubParts(); i < n; ++i)
+            {
+                const unsigned char* vertices = nullptr;
+                int numVertices = 0;
+                PHY_ScalarType vertexType = PHY_FLOAT;
+                int vertexStride = 0;
+                const unsigned char* indices = nullptr;
+                int indexStride = 0;
+                int numFaces = 0;
+                PHY_ScalarType indexType = PHY_INTEGER;
+                mesh.getLockedReadOnlyVertexIndexBase(&vertices, numVertices, vertexType, vertexStride, &indices,
+                    indexStride, numFaces, indexType, i);
+                result += static_cast<std::size_t>(numVertices) * static_cast<std::size_t>(vertexStride);
+                result += static_cast<std::size_t>(numFaces) * static_cast<std::size_t>(indexStride);
+                mesh.unLockReadOnlyVertexBase(i);
+            }
+            return result;
+        }
+
+        std::size_t estimateCollisionShapeSize(const btCollisionShape* shape)
+        {
+            if (shape == nullptr)
+                return 0;
+
+            if (shape->isCompound())
+            {
+                const btCompoundShape* compound = static_cast<const btCompoundShape*>(shape);
+                std::size_t result = sizeof(btCompoundShape);
+                for (int i = 0, n = compound->getNumChildShapes(); i < n; ++i)
+                    result += estimateCollisionShapeSize(compound->getChildShape(i));
+                return result;
+            }
+
+            if (shape->getShapeType() == TRIANGLE_MESH_SHAPE_PROXYTYPE)
+            {
+                const btBvhTriangleMeshShape* triangleMesh = static_cast<const btBvhTriangleMeshShape*>(shape);
+                std::size_t result = sizeof(btBvhTriangleMeshShape);
+                if (const btStridingMeshInterface* mesh = triangleMesh->getMeshInterface())
+                    result += estimateMeshInterfaceSize(*mesh);
+                if (const btOptimizedBvh* bvh = const_cast<btBvhTriangleMeshShape*>(triangleMesh)->getOptimizedBvh())
+                    result += bvh->calculateSerializeBufferSize();
+                return result;
+            }
+
+            // Scaled shapes of instances reference the source mesh, heightfields reference the terrain data
+            return sizeof(btCollisionShape);
+        }
+    }
+
+    std::size_t estimateImageSize(const osg::Object& object)
+    {
+        if (const osg::Image* image = dynamic_cast<const osg::Image*>(&object))
+            return image->getTotalSizeInBytesIncludingMipmaps();
+        return 0;
+    }
+
+    std::size_t estimateNodeSize(const osg::Object& object)
+    {
+        // The visitor doesn't modify the node
+        osg::Node* node = const_cast<osg::Node*>(dynamic_cast<const osg::Node*>(&object));
+        if (node == nullptr)
+            return 0;
+        NodeSizeVisitor visitor;
+        node->accept(visitor);
+        return visitor.mSize;
+    }
+
+    std::size_t estimateBulletShapeSize(const osg::Object& object)
+    {
+        const BulletShape* shape = dynamic_cast<const BulletShape*>(&object);
+        if (shape == nullptr)
+            return 0;
+        return sizeof(BulletShape) + estimateCollisionShapeSize(shape->mCollisionShape.get())
+            + estimateCollisionShapeSize(shape->mAvoidCollisionShape.get());
+    }
+}
@@ -0,0 +1,29 @@
+#ifndef OPENMW_COMPONENTS_RESOURCE_SIZEESTIMATOR_H
+#define OPENMW_COMPONENTS_RESOURCE_SIZEESTIMATOR_H
+
+#include <cstddef>
+
+namespace osg
+{
+    class Object;
+}
+
+namespace Resource
+{
+    /// Estimate memory used by osg::Image pixel data including mipmaps.
+    std::size_t estimateImageSize(const osg::Object& object);
+
+    /// Estimate memory used by a scene graph. Only vertex and primitive data is accounted, textures are shared
+    /// through ImageManager and accounted there.
+    std::size_t estimateNodeSize(const osg::Object& object);
+
+    /// Estimate memory used by collision shapes of BulletShape including triangle meshes and their BVH.
+    std::size_t estimateBulletShapeSize(const osg::Object& object);
+
+    inline double toMegabytes(std::size_t bytes)
+    {
+        return static_cast<double>(bytes) / (1024.0 * 1024.0);
+    }
+}
+
+#endif
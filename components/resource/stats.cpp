@@ -424,6 +424,15 @@ namespace Resource
                 "Compiling",
                 "WorkQueue",
                 "WorkThread",
+                "WorkQueue Cell",
+                "WorkQueue Terrain",
+                "WorkQueue Texture",
+                "WorkQueue Cache",
+                "WorkQueue Map",
+                "WorkQueue Navigation",
+                "WorkQueue Other",
+                "WorkQueue Stolen",
+                "WorkQueue Cancelled",
                 "UnrefQueue",
                 "",
                 "Texture",
@@ -434,6 +443,25 @@ namespace Resource
                 "Image",
                 "Nif",
                 "Keyframe",
+                "Node MB",
+                "Shape MB",
+                "Shape Instance MB",
+                "Image MB",
+                "Image Full MB",
+                "Image Streamed",
+                "Image Streaming",
+                "Nif MB",
+                "Resource MB",
+                "Resource Budget MB",
+                "Resource Evicted",
+                "BSA Cache Hits",
+                "BSA Cache Misses",
+                "BSA Cache Saved MB",
+                "BSA Cache Size MB",
+                "Nif Cache Hits",
+                "Nif Cache Misses",
+                "Nif Deduplicated",
+                "Node Deduplicated",
                 "",
                 "Groundcover Chunk",
                 "Object Chunk",
@@ -462,6 +490,15 @@ namespace Resource
                 "Physics Projectiles",
                 "Physics HeightFields",
                 "",
+                "Scene PendingObjects",
+                "",
+                "CellPreloader Count",
+                "CellPreloader MB",
+                "CellPreloader Hits",
+                "CellPreloader LateHits",
+                "CellPreloader Misses",
+                "CellPreloader HitRate",
+                "",
                 "Lua UsedMemory",
             });
 
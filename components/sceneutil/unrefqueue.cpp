@@ -11,7 +11,8 @@ namespace SceneUtil
             std::vector<osg::ref_ptr<osg::Referenced>> mObjects;
 
             explicit ClearVector(std::vector<osg::ref_ptr<osg::Referenced>>&& objects)
-                : mObjects(std::move(objects))
+                : WorkItem(WorkItemCategory::Cache)
+                , mObjects(std::move(objects))
             {
             }
 
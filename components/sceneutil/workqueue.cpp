@@ -2,6 +2,7 @@
 
 #include <components/debug/debuglog.hpp>
 
+#include <algorithm>
 #include <numeric>
 
 namespace SceneUtil
@@ -33,8 +34,44 @@ namespace SceneUtil
         return mDone;
     }
 
+    void WorkItem::cancel()
+    {
+        mCancelled = true;
+        abort();
+    }
+
+    std::string_view getWorkItemCategoryName(WorkItemCategory category)
+    {
+        switch (category)
+        {
+            case WorkItemCategory::Other:
+                return "Other";
+            case WorkItemCategory::Cell:
+                return "Cell";
+            case WorkItemCategory::Terrain:
+                return "Terrain";
+            case WorkItemCategory::Texture:
+                return "Texture";
+            case WorkItemCategory::Cache:
+                return "Cache";
+            case WorkItemCategory::Map:
+                return "Map";
+            case WorkItemCategory::Navigation:
+                return "Navigation";
+            case WorkItemCategory::Count:
+                break;
+        }
+        return "Unknown";
+    }
+
     WorkQueue::WorkQueue(std::size_t workerThreads)
         : mIsReleased(false)
+        , mQueues([&] {
+            std::vector<std::unique_ptr<ThreadQueue>> result;
+            for (std::size_t i = 0; i < std::max<std::size_t>(workerThreads, 1); ++i)
+                result.push_back(std::make_unique<ThreadQueue>());
+            return result;
+        }())
     {
         start(workerThreads);
     }
@@ -50,16 +87,24 @@ namespace SceneUtil
             const std::lock_guard lock(mMutex);
             mIsReleased = false;
         }
+        // Threads share queues if there are more threads than were given to the constructor
         while (mThreads.size() < workerThreads)
-            mThreads.emplace_back(std::make_unique<WorkThread>(*this));
+            mThreads.emplace_back(std::make_unique<WorkThread>(*this, mThreads.size() % mQueues.size()));
     }
 
     void WorkQueue::stop()
     {
+        for (const std::unique_ptr<ThreadQueue>& queue : mQueues)
+        {
+            const std::lock_guard lock(queue->mMutex);
+            for (const QueuedItem& queued : queue->mItems)
+                --mQueued[static_cast<std::size_t>(queued.mItem->getCategory())];
+            mNumItems -= queue->mItems.size();
+            queue->mItems.clear();
+        }
+
         {
             std::unique_lock<std::mutex> lock(mMutex);
-            while (!mQueue.empty())
-                mQueue.pop_back();
             mIsReleased = true;
             mCondition.notify_all();
         }
@@ -75,34 +120,102 @@ namespace SceneUtil
             return;
         }
 
-        std::unique_lock<std::mutex> lock(mMutex);
-        if (front)
-            mQueue.push_front(std::move(item));
-        else
-            mQueue.push_back(std::move(item));
+        const std::uint64_t sequence = mSequence++;
+        ThreadQueue& queue = *mQueues[sequence % mQueues.size()];
+        ++mQueued[static_cast<std::size_t>(item->getCategory())];
+        {
+            const std::lock_guard lock(queue.mMutex);
+            // Count the item before it can be taken, so the counter never goes below zero
+            ++mNumItems;
+            queue.mItems.push_back(QueuedItem{ std::move(item), front, sequence });
+        }
+        {
+            // Waiting thread checks the number of items under this lock
+            const std::lock_guard lock(mMutex);
+        }
         mCondition.notify_one();
     }
 
-    osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem()
+    osg::ref_ptr<WorkItem> WorkQueue::takeWorkItem(ThreadQueue& queue)
     {
-        std::unique_lock<std::mutex> lock(mMutex);
-        while (mQueue.empty() && !mIsReleased)
+        std::vector<osg::ref_ptr<WorkItem>> cancelled;
+        osg::ref_ptr<WorkItem> item;
         {
-            mCondition.wait(lock);
+            const std::lock_guard lock(queue.mMutex);
+            const auto cancelledBegin = std::partition(queue.mItems.begin(), queue.mItems.end(),
+                [](const QueuedItem& v) { return !v.mItem->isCancelled(); });
+            for (auto it = cancelledBegin; it != queue.mItems.end(); ++it)
+                cancelled.push_back(std::move(it->mItem));
+            queue.mItems.erase(cancelledBegin, queue.mItems.end());
+            if (!queue.mItems.empty())
+            {
+                // Priorities may change while items are queued, so there is no ordered container to maintain
+                const auto it = std::min_element(
+                    queue.mItems.begin(), queue.mItems.end(), [](const QueuedItem& l, const QueuedItem& r) {
+                        if (l.mFront != r.mFront)
+                            return l.mFront;
+                        const float lPriority = l.mItem->getPriority();
+                        const float rPriority = r.mItem->getPriority();
+                        if (lPriority != rPriority)
+                            return lPriority > rPriority;
+                        return l.mSequence < r.mSequence;
+                    });
+                item = std::move(it->mItem);
+                *it = std::move(queue.mItems.back());
+                queue.mItems.pop_back();
+            }
+        }
+
+        for (const osg::ref_ptr<WorkItem>& v : cancelled)
+        {
+            --mNumItems;
+            --mQueued[static_cast<std::size_t>(v->getCategory())];
+            ++mCancelled;
+            v->signalDone();
+        }
+
+        if (item != nullptr)
+        {
+            --mNumItems;
+            --mQueued[static_cast<std::size_t>(item->getCategory())];
+            ++mActive[static_cast<std::size_t>(item->getCategory())];
         }
-        if (!mQueue.empty())
+
+        return item;
+    }
+
+    osg::ref_ptr<WorkItem> WorkQueue::removeWorkItem(std::size_t threadIndex)
+    {
+        while (true)
         {
-            osg::ref_ptr<WorkItem> item = std::move(mQueue.front());
-            mQueue.pop_front();
-            return item;
+            if (osg::ref_ptr<WorkItem> item = takeWorkItem(*mQueues[threadIndex]))
+                return item;
+
+            for (std::size_t i = 1; i < mQueues.size(); ++i)
+            {
+                if (osg::ref_ptr<WorkItem> item = takeWorkItem(*mQueues[(threadIndex + i) % mQueues.size()]))
+                {
+                    ++mStolen;
+                    return item;
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(mMutex);
+            while (mNumItems == 0 && !mIsReleased)
+                mCondition.wait(lock);
+            if (mIsReleased)
+                return nullptr;
         }
-        return nullptr;
+    }
+
+    void WorkQueue::finishWorkItem(const WorkItem& item)
+    {
+        --mActive[static_cast<std::size_t>(item.getCategory())];
     }
 
     unsigned int WorkQueue::getNumItems() const
     {
-        std::unique_lock<std::mutex> lock(mMutex);
-        return mQueue.size();
+        return static_cast<unsigned int>(mNumItems.load());
     }
 
     unsigned int WorkQueue::getNumActiveThreads() const
@@ -111,8 +224,19 @@ namespace SceneUtil
             mThreads.begin(), mThreads.end(), 0u, [](auto r, const auto& t) { return r + t->isActive(); });
     }
 
-    WorkThread::WorkThread(WorkQueue& workQueue)
+    WorkQueueStats WorkQueue::getStats() const
+    {
+        WorkQueueStats result;
+        for (std::size_t i = 0; i < sCategoriesCount; ++i)
+            result.mCategories[i] = WorkQueueCategoryStats{ mQueued[i].load(), mActive[i].load() };
+        result.mStolen = mStolen.load();
+        result.mCancelled = mCancelled.load();
+        return result;
+    }
+
+    WorkThread::WorkThread(WorkQueue& workQueue, std::size_t index)
         : mWorkQueue(&workQueue)
+        , mIndex(index)
         , mActive(false)
         , mThread([this] { run(); })
     {
@@ -127,11 +251,12 @@ namespace SceneUtil
     {
         while (true)
         {
-            osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem();
+            osg::ref_ptr<WorkItem> item = mWorkQueue->removeWorkItem(mIndex);
             if (!item)
                 return;
             mActive = true;
             item->doWork();
+            mWorkQueue->finishWorkItem(*item);
             item->signalDone();
             mActive = false;
         }
@@ -4,19 +4,42 @@
 #include <osg/Referenced>
 #include <osg/ref_ptr>
 
+#include <array>
 #include <atomic>
 #include <condition_variable>
-#include <deque>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
+#include <string_view>
 #include <thread>
 #include <vector>
 
 namespace SceneUtil
 {
 
+    enum class WorkItemCategory
+    {
+        Other,
+        Cell,
+        Terrain,
+        Texture,
+        Cache,
+        Map,
+        Navigation,
+        Count,
+    };
+
+    std::string_view getWorkItemCategoryName(WorkItemCategory category);
+
     class WorkItem : public osg::Referenced
     {
     public:
+        explicit WorkItem(WorkItemCategory category = WorkItemCategory::Other)
+            : mCategory(category)
+        {
+        }
+
         /// Override in a derived WorkItem to perform actual work.
         virtual void doWork() {}
 
@@ -31,17 +54,49 @@ namespace SceneUtil
         /// Set abort flag in order to return from doWork() as soon as possible. May not be respected by all WorkItems.
         virtual void abort() {}
 
+        /// Abort the item and remove it from the queue without calling doWork() if it hasn't started yet. The item
+        /// is done once removed.
+        void cancel();
+
+        bool isCancelled() const { return mCancelled; }
+
+        /// Items with higher priority are started first, e.g. negative distance to the camera. May be changed while
+        /// the item is queued.
+        void setPriority(float priority) { mPriority = priority; }
+
+        float getPriority() const { return mPriority; }
+
+        WorkItemCategory getCategory() const { return mCategory; }
+
     private:
+        const WorkItemCategory mCategory;
+        std::atomic<float> mPriority{ 0 };
+        std::atomic_bool mCancelled{ false };
         std::atomic_bool mDone{ false };
         std::mutex mMutex;
         std::condition_variable mCondition;
     };
 
+    struct WorkQueueCategoryStats
+    {
+        std::size_t mQueued = 0;
+        std::size_t mActive = 0;
+    };
+
+    struct WorkQueueStats
+    {
+        std::array<WorkQueueCategoryStats, static_cast<std::size_t>(WorkItemCategory::Count)> mCategories;
+        std::size_t mStolen = 0;
+        std::size_t mCancelled = 0;
+    };
+
     class WorkThread;
 
     /// @brief A work queue that users can push work items onto, to be completed by one or more background threads.
-    /// @note Work items will be processed in the order that they were given in, however
-    /// if multiple work threads are involved then it is possible for a later item to complete before earlier items.
+    /// @par Each thread has its own queue and takes items from the queues of other threads when its own one is
+    /// empty. A thread takes the item with the highest priority from a queue, items with equal priority are taken in
+    /// the order they were given in. Since items are distributed over the threads, priorities are respected per
+    /// queue and a later item may complete before earlier items.
     class WorkQueue : public osg::Referenced
     {
     public:
@@ -54,33 +109,62 @@ namespace SceneUtil
 
         /// Add a new work item to the back of the queue.
         /// @par The work item's waitTillDone() method may be used by the caller to wait until the work is complete.
-        /// @param front If true, add item to the front of the queue. If false (default), add to the back.
+        /// @param front If true, the item is started before the items added without this flag regardless of priority.
         void addWorkItem(osg::ref_ptr<WorkItem> item, bool front = false);
 
-        /// Get the next work item from the front of the queue. If the queue is empty, waits until a new item is added.
-        /// If the workqueue is in the process of being destroyed, may return nullptr.
+        /// Get the next work item for the given thread, taking it from other threads' queues when its own is empty.
+        /// If there are no items, waits until a new item is added. If the workqueue is in the process of being
+        /// destroyed, may return nullptr. Cancelled items are signalled done and skipped.
         /// @par Used internally by the WorkThread.
-        osg::ref_ptr<WorkItem> removeWorkItem();
+        osg::ref_ptr<WorkItem> removeWorkItem(std::size_t threadIndex);
+
+        /// Used internally by the WorkThread.
+        void finishWorkItem(const WorkItem& item);
 
         unsigned int getNumItems() const;
 
         unsigned int getNumActiveThreads() const;
 
+        WorkQueueStats getStats() const;
+
     private:
+        struct QueuedItem
+        {
+            osg::ref_ptr<WorkItem> mItem;
+            bool mFront;
+            std::uint64_t mSequence;
+        };
+
+        struct ThreadQueue
+        {
+            std::mutex mMutex;
+            std::vector<QueuedItem> mItems;
+        };
+
+        static constexpr std::size_t sCategoriesCount = static_cast<std::size_t>(WorkItemCategory::Count);
+
         bool mIsReleased;
-        std::deque<osg::ref_ptr<WorkItem>> mQueue;
+        const std::vector<std::unique_ptr<ThreadQueue>> mQueues;
+        std::atomic<std::size_t> mNumItems{ 0 };
+        std::atomic<std::uint64_t> mSequence{ 0 };
+        std::array<std::atomic<std::size_t>, sCategoriesCount> mQueued{};
+        std::array<std::atomic<std::size_t>, sCategoriesCount> mActive{};
+        std::atomic<std::size_t> mStolen{ 0 };
+        std::atomic<std::size_t> mCancelled{ 0 };
 
         mutable std::mutex mMutex;
         std::condition_variable mCondition;
 
         std::vector<std::unique_ptr<WorkThread>> mThreads;
+
+        osg::ref_ptr<WorkItem> takeWorkItem(ThreadQueue& queue);
     };
 
     /// Internally used by WorkQueue.
     class WorkThread
     {
     public:
-        WorkThread(WorkQueue& workQueue);
+        WorkThread(WorkQueue& workQueue, std::size_t index);
 
         ~WorkThread();
 
@@ -88,6 +172,7 @@ namespace SceneUtil
 
     private:
         WorkQueue* mWorkQueue;
+        const std::size_t mIndex;
         std::atomic<bool> mActive;
         std::thread mThread;
 
@@ -17,6 +17,10 @@ namespace VFS
         virtual Files::IStreamPtr open() = 0;
 
         virtual std::filesystem::path getPath() = 0;
+
+        /// Path to the compressed archive containing the file, empty for loose files and files of uncompressed
+        /// archives.
+        virtual std::filesystem::path getCompressedArchivePath() { return {}; }
     };
 
     class Archive
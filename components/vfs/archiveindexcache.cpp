@@ -0,0 +1,180 @@
+#include "archiveindexcache.hpp"
+
+#include <components/debug/debuglog.hpp>
+#include <components/files/conversion.hpp>
+#include <components/serialization/binaryreader.hpp>
+#include <components/serialization/binarywriter.hpp>
+#include <components/serialization/format.hpp>
+#include <components/serialization/sizeaccumulator.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+namespace VFS
+{
+    namespace
+    {
+        constexpr char archiveIndexCacheMagic[] = { 'O', 'M', 'W', 'V', 'F', 'S', 'I', 'C' };
+        constexpr std::uint32_t archiveIndexCacheVersion = 1;
+
+        struct CachedArchive
+        {
+            std::vector<char> mPath;
+            std::uint64_t mSize = 0;
+            std::int64_t mModificationTime = 0;
+            std::vector<std::byte> mFileTable;
+        };
+
+        template <Serialization::Mode mode>
+        struct ArchiveIndexCacheFormat : Serialization::Format<mode, ArchiveIndexCacheFormat<mode>>
+        {
+            using Serialization::Format<mode, ArchiveIndexCacheFormat<mode>>::operator();
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, CachedArchive>>
+            {
+                visitor(*this, value.mPath);
+                visitor(*this, value.mSize);
+                visitor(*this, value.mModificationTime);
+                visitor(*this, value.mFileTable);
+            }
+
+            template <class Visitor, class T>
+            auto operator()(Visitor&& visitor, T& value) const
+                -> std::enable_if_t<std::is_same_v<std::decay_t<T>, std::vector<CachedArchive>>>
+            {
+                if constexpr (mode == Serialization::Mode::Write)
+                {
+                    visitor(*this, archiveIndexCacheMagic);
+                    visitor(*this, archiveIndexCacheVersion);
+                }
+                else
+                {
+                    static_assert(mode == Serialization::Mode::Read);
+                    char magic[std::size(archiveIndexCacheMagic)];
+                    visitor(*this, magic);
+                    if (std::memcmp(magic, archiveIndexCacheMagic, sizeof(magic)) != 0)
+                        throw std::runtime_error("Bad archive index cache magic");
+                    std::uint32_t version = 0;
+                    visitor(*this, version);
+                    if (version != archiveIndexCacheVersion)
+                        throw std::runtime_error("Unsupported archive index cache version");
+                }
+                Serialization::Format<mode, ArchiveIndexCacheFormat<mode>>::operator()(visitor, value);
+            }
+        };
+
+        struct ArchiveStamp
+        {
+            std::uint64_t mSize = 0;
+            std::int64_t mModificationTime = 0;
+        };
+
+        ArchiveStamp getArchiveStamp(const std::filesystem::path& archive)
+        {
+            return ArchiveStamp{ static_cast<std::uint64_t>(std::filesystem::file_size(archive)),
+                static_cast<std::int64_t>(std::filesystem::last_write_time(archive).time_since_epoch().count()) };
+        }
+    }
+
+    ArchiveIndexCache::ArchiveIndexCache(const std::filesystem::path& path)
+        : mPath(path)
+    {
+        std::ifstream stream(mPath, std::ios_base::binary);
+        if (!stream.is_open())
+            return;
+
+        try
+        {
+            const std::vector<char> data((std::istreambuf_iterator<char>(stream)), std::istreambuf_iterator<char>());
+            const std::byte* const begin = reinterpret_cast<const std::byte*>(data.data());
+            std::vector<CachedArchive> archives;
+            constexpr ArchiveIndexCacheFormat<Serialization::Mode::Read> format;
+            Serialization::BinaryReader reader(begin, begin + data.size());
+            format(reader, archives);
+
+            for (CachedArchive& archive : archives)
+                mEntries.emplace(std::string(archive.mPath.begin(), archive.mPath.end()),
+                    Entry{ archive.mSize, archive.mModificationTime, std::move(archive.mFileTable), false });
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to load archive index cache " << mPath << ", it will be rebuilt: "
+                                << e.what();
+            mEntries.clear();
+            mChanged = true;
+        }
+    }
+
+    const std::vector<std::byte>* ArchiveIndexCache::get(const std::filesystem::path& archive)
+    {
+        const auto it = mEntries.find(Files::pathToUnicodeString(archive));
+        if (it == mEntries.end())
+            return nullptr;
+
+        it->second.mUsed = true;
+
+        const ArchiveStamp stamp = getArchiveStamp(archive);
+        if (stamp.mSize != it->second.mSize || stamp.mModificationTime != it->second.mModificationTime)
+            return nullptr;
+
+        ++mHits;
+        return &it->second.mFileTable;
+    }
+
+    void ArchiveIndexCache::set(const std::filesystem::path& archive, std::vector<std::byte>&& fileTable)
+    {
+        const ArchiveStamp stamp = getArchiveStamp(archive);
+        mEntries.insert_or_assign(Files::pathToUnicodeString(archive),
+            Entry{ stamp.mSize, stamp.mModificationTime, std::move(fileTable), true });
+        mChanged = true;
+    }
+
+    void ArchiveIndexCache::save()
+    {
+        std::vector<CachedArchive> archives;
+        for (auto& [path, entry] : mEntries)
+        {
+            if (!entry.mUsed)
+            {
+                mChanged = true;
+                continue;
+            }
+            archives.push_back(CachedArchive{
+                std::vector<char>(path.begin(), path.end()), entry.mSize, entry.mModificationTime, entry.mFileTable });
+        }
+
+        if (!mChanged)
+            return;
+
+        try
+        {
+            constexpr ArchiveIndexCacheFormat<Serialization::Mode::Write> format;
+            Serialization::SizeAccumulator sizeAccumulator;
+            format(sizeAccumulator, archives);
+            std::vector<std::byte> data(sizeAccumulator.value());
+            Serialization::BinaryWriter writer(data.data(), data.data() + data.size());
+            format(writer, archives);
+
+            std::filesystem::create_directories(mPath.parent_path());
+            std::filesystem::path tmpPath = mPath;
+            tmpPath += ".tmp";
+            {
+                std::ofstream stream(tmpPath, std::ios_base::binary | std::ios_base::trunc);
+                stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+                if (!stream)
+                    throw std::runtime_error("Failed to write " + Files::pathToUnicodeString(tmpPath));
+            }
+            std::filesystem::rename(tmpPath, mPath);
+            mChanged = false;
+        }
+        catch (const std::exception& e)
+        {
+            Log(Debug::Warning) << "Failed to save archive index cache " << mPath << ": " << e.what();
+        }
+    }
+}
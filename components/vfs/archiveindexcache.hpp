@@ -0,0 +1,50 @@
+#ifndef OPENMW_COMPONENTS_VFS_ARCHIVEINDEXCACHE_H
+#define OPENMW_COMPONENTS_VFS_ARCHIVEINDEXCACHE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace VFS
+{
+    /// @brief Persistent storage for file tables of BSA archives.
+    /// @par Allows to open archives without reading their headers. Each archive is identified by its path and
+    /// invalidated separately when its size or modification time changes.
+    class ArchiveIndexCache
+    {
+    public:
+        /// Load cached file tables from the given file. Missing or invalid file results in an empty cache.
+        explicit ArchiveIndexCache(const std::filesystem::path& path);
+
+        /// Get stored file table for the archive. Returns nullptr when there is none or the archive has changed.
+        const std::vector<std::byte>* get(const std::filesystem::path& archive);
+
+        /// Store file table for the archive replacing the existing one.
+        void set(const std::filesystem::path& archive, std::vector<std::byte>&& fileTable);
+
+        /// Write cached file tables to the file if anything has changed. Archives not accessed since the cache
+        /// was loaded are dropped.
+        void save();
+
+        std::size_t getHits() const { return mHits; }
+
+    private:
+        struct Entry
+        {
+            std::uint64_t mSize = 0;
+            std::int64_t mModificationTime = 0;
+            std::vector<std::byte> mFileTable;
+            bool mUsed = false;
+        };
+
+        std::filesystem::path mPath;
+        std::map<std::string, Entry> mEntries;
+        std::size_t mHits = 0;
+        bool mChanged = false;
+    };
+}
+
+#endif
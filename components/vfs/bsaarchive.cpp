@@ -3,13 +3,62 @@
 #include <algorithm>
 #include <memory>
 
+#include <components/debug/debuglog.hpp>
+
+#include "archiveindexcache.hpp"
+
 namespace VFS
 {
+    namespace
+    {
+        template <class T>
+        void openBsaFile(T& file, const std::filesystem::path& filename, const BsaArchiveOptions& options)
+        {
+            bool opened = false;
+
+            if (options.mIndexCache != nullptr)
+            {
+                if (const std::vector<std::byte>* fileTable = options.mIndexCache->get(filename))
+                {
+                    try
+                    {
+                        file.openWithFileTable(filename, *fileTable);
+                        opened = true;
+                    }
+                    catch (const std::exception& e)
+                    {
+                        Log(Debug::Warning) << "Failed to use cached file table for BSA archive " << filename
+                                            << ", the archive header will be read: " << e.what();
+                    }
+                }
+            }
+
+            if (!opened)
+            {
+                file.open(filename);
+                if (options.mIndexCache != nullptr)
+                    options.mIndexCache->set(filename, file.saveFileTable());
+            }
+
+            if (!options.mMemoryMapped)
+                return;
+
+            try
+            {
+                file.mapToMemory();
+            }
+            catch (const std::exception& e)
+            {
+                Log(Debug::Warning) << "Failed to map BSA archive \"" << file.getFilename()
+                                    << "\" into memory, files will be read through file streams: " << e.what();
+            }
+        }
+    }
 
-    BsaArchive::BsaArchive(const std::filesystem::path& filename)
+    BsaArchive::BsaArchive(const std::filesystem::path& filename, const BsaArchiveOptions& options)
     {
         mFile = std::make_unique<Bsa::BSAFile>();
-        mFile->open(filename);
+        openBsaFile(*mFile, filename, options);
 
         const Bsa::BSAFile::FileList& filelist = mFile->getList();
         for (Bsa::BSAFile::FileList::const_iterator it = filelist.begin(); it != filelist.end(); ++it)
@@ -63,11 +112,12 @@ namespace VFS
         return mFile->getFile(mInfo);
     }
 
-    CompressedBsaArchive::CompressedBsaArchive(const std::filesystem::path& filename)
+    CompressedBsaArchive::CompressedBsaArchive(const std::filesystem::path& filename, const BsaArchiveOptions& options)
         : Archive()
     {
         mCompressedFile = std::make_unique<Bsa::CompressedBSAFile>();
-        mCompressedFile->open(filename);
+        mCompressedFile->setDecompressionCache(options.mDecompressionCache);
+        openBsaFile(*mCompressedFile, filename, options);
 
         const Bsa::BSAFile::FileList& filelist = mCompressedFile->getList();
         for (Bsa::BSAFile::FileList::const_iterator it = filelist.begin(); it != filelist.end(); ++it)
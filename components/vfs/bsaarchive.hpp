@@ -2,6 +2,7 @@
 #define VFS_BSAARCHIVE_HPP_
 
 #include "archive.hpp"
+#include "bsaarchiveoptions.hpp"
 
 #include <components/bsa/bsa_file.hpp>
 #include <components/bsa/compressedbsafile.hpp>
@@ -30,6 +31,8 @@ namespace VFS
 
         std::filesystem::path getPath() override { return mInfo->name(); }
 
+        std::filesystem::path getCompressedArchivePath() override { return mCompressedFile->getPath(); }
+
         const Bsa::BSAFile::FileStruct* mInfo;
         Bsa::CompressedBSAFile* mCompressedFile;
     };
@@ -37,7 +40,7 @@ namespace VFS
     class BsaArchive : public Archive
     {
     public:
-        BsaArchive(const std::filesystem::path& filename);
+        BsaArchive(const std::filesystem::path& filename, const BsaArchiveOptions& options = {});
         BsaArchive();
         virtual ~BsaArchive();
         void listResources(std::map<std::string, File*>& out, char (*normalize_function)(char)) override;
@@ -52,7 +55,7 @@ namespace VFS
     class CompressedBsaArchive : public Archive
     {
     public:
-        CompressedBsaArchive(const std::filesystem::path& filename);
+        CompressedBsaArchive(const std::filesystem::path& filename, const BsaArchiveOptions& options = {});
         virtual ~CompressedBsaArchive() {}
         void listResources(std::map<std::string, File*>& out, char (*normalize_function)(char)) override;
         bool contains(const std::string& file, char (*normalize_function)(char)) const override;
@@ -0,0 +1,28 @@
+#ifndef OPENMW_COMPONENTS_VFS_BSAARCHIVEOPTIONS_H
+#define OPENMW_COMPONENTS_VFS_BSAARCHIVEOPTIONS_H
+
+#include <memory>
+
+namespace Bsa
+{
+    class DecompressionCache;
+}
+
+namespace VFS
+{
+    class ArchiveIndexCache;
+
+    struct BsaArchiveOptions
+    {
+        /// Read files directly from the archive mapped into memory.
+        bool mMemoryMapped = false;
+
+        /// Cache for decompressed files shared between compressed archives.
+        std::shared_ptr<Bsa::DecompressionCache> mDecompressionCache;
+
+        /// Cache for archive file tables to open unchanged archives without reading their headers.
+        ArchiveIndexCache* mIndexCache = nullptr;
+    };
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include "fileindex.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace VFS
+{
+    namespace
+    {
+        std::size_t getSlotsCount(std::size_t entries)
+        {
+            // Keep load factor at most 0.5 to have short probe sequences
+            std::size_t result = 16;
+            while (result < entries * 2)
+                result *= 2;
+            return result;
+        }
+    }
+
+    void FileIndex::clear()
+    {
+        mEntries.clear();
+        mHashes.clear();
+        mSlots.clear();
+        mSlotMask = 0;
+    }
+
+    void FileIndex::build(std::map<std::string, File*>&& files)
+    {
+        clear();
+
+        if (files.size() >= static_cast<std::size_t>(std::numeric_limits<std::uint32_t>::max()))
+            throw std::runtime_error("Too many files in VFS index: " + std::to_string(files.size()));
+
+        mEntries.reserve(files.size());
+        mHashes.reserve(files.size());
+
+        for (auto& [name, file] : files)
+        {
+            mHashes.push_back(computeHash(name, [](char ch) { return ch; }));
+            mEntries.emplace_back(std::move(name), file);
+        }
+
+        files.clear();
+
+        mSlots.assign(getSlotsCount(mEntries.size()), sEmptySlot);
+        mSlotMask = mSlots.size() - 1;
+
+        for (std::size_t i = 0; i < mEntries.size(); ++i)
+        {
+            std::size_t slot = mHashes[i] & mSlotMask;
+            while (mSlots[slot] != sEmptySlot)
+                slot = (slot + 1) & mSlotMask;
+            mSlots[slot] = static_cast<std::uint32_t>(i);
+        }
+    }
+
+    FileIndex::const_iterator FileIndex::lowerBound(std::string_view normalizedName) const
+    {
+        return std::lower_bound(mEntries.begin(), mEntries.end(), normalizedName,
+            [](const Entry& entry, std::string_view name) { return std::string_view(entry.first) < name; });
+    }
+}
@@ -0,0 +1,103 @@
+#ifndef OPENMW_COMPONENTS_VFS_FILEINDEX_H
+#define OPENMW_COMPONENTS_VFS_FILEINDEX_H
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace VFS
+{
+    class File;
+
+    /// @brief Immutable lookup table from normalized resource names to files.
+    /// @par Entries are stored in a sorted array to support prefix iteration. Exact lookups go through an
+    /// open-addressing hash table built on top of that array, keyed by a hash of the normalized name. The hash is
+    /// computed while normalizing, so lookups by a not yet normalized name don't allocate.
+    /// @note All const methods are thread-safe.
+    class FileIndex
+    {
+    public:
+        using Entry = std::pair<std::string, File*>;
+        using const_iterator = std::vector<Entry>::const_iterator;
+
+        void clear();
+
+        /// Replace the contents of the index with the given files.
+        void build(std::map<std::string, File*>&& files);
+
+        /// Find a file by already normalized name.
+        File* find(std::string_view normalizedName) const
+        {
+            return find(normalizedName, [](char ch) { return ch; });
+        }
+
+        /// Find a file by name, running each character through the given normalize function first.
+        template <class Normalize>
+        File* find(std::string_view name, Normalize&& normalize) const
+        {
+            if (mSlots.empty())
+                return nullptr;
+            const std::uint64_t hash = computeHash(name, normalize);
+            for (std::size_t slot = hash & mSlotMask;; slot = (slot + 1) & mSlotMask)
+            {
+                const std::uint32_t index = mSlots[slot];
+                if (index == sEmptySlot)
+                    return nullptr;
+                if (mHashes[index] != hash)
+                    continue;
+                const std::string& candidate = mEntries[index].first;
+                if (candidate.size() != name.size())
+                    continue;
+                bool equal = true;
+                for (std::size_t i = 0; i < name.size(); ++i)
+                {
+                    if (candidate[i] != normalize(name[i]))
+                    {
+                        equal = false;
+                        break;
+                    }
+                }
+                if (equal)
+                    return mEntries[index].second;
+            }
+        }
+
+        /// First entry not less than the given normalized name.
+        const_iterator lowerBound(std::string_view normalizedName) const;
+
+        const_iterator begin() const { return mEntries.begin(); }
+
+        const_iterator end() const { return mEntries.end(); }
+
+        std::size_t size() const { return mEntries.size(); }
+
+        bool empty() const { return mEntries.empty(); }
+
+        template <class Normalize>
+        static std::uint64_t computeHash(std::string_view name, Normalize&& normalize)
+        {
+            // FNV-1a
+            std::uint64_t hash = 0xcbf29ce484222325ull;
+            for (char ch : name)
+            {
+                hash ^= static_cast<unsigned char>(normalize(ch));
+                hash *= 0x00000100000001B3ull;
+            }
+            return hash;
+        }
+
+    private:
+        static constexpr std::uint32_t sEmptySlot = static_cast<std::uint32_t>(-1);
+
+        std::vector<Entry> mEntries;
+        std::vector<std::uint64_t> mHashes;
+        std::vector<std::uint32_t> mSlots;
+        std::size_t mSlotMask = 0;
+    };
+}
+
+#endif
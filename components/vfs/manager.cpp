@@ -1,6 +1,7 @@
 #include "manager.hpp"
 
 #include <algorithm>
+#include <map>
 #include <stdexcept>
 
 #include <components/files/conversion.hpp>
@@ -27,6 +28,13 @@ namespace
         std::transform(path.begin(), path.end(), path.begin(), normalize_char);
     }
 
+    VFS::File* findFile(const VFS::FileIndex& index, std::string_view name, bool strict)
+    {
+        if (strict)
+            return index.find(name, strict_normalize_char);
+        return index.find(name, nonstrict_normalize_char);
+    }
+
 }
 
 namespace VFS
@@ -54,32 +62,32 @@ namespace VFS
     {
         mIndex.clear();
 
+        std::map<std::string, File*> files;
         for (const auto& archive : mArchives)
-            archive->listResources(mIndex, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+            archive->listResources(files, mStrict ? &strict_normalize_char : &nonstrict_normalize_char);
+
+        mIndex.build(std::move(files));
     }
 
     Files::IStreamPtr Manager::get(std::string_view name) const
     {
-        std::string normalized(name);
-        normalize_path(normalized, mStrict);
-
-        return getNormalized(normalized);
+        File* const file = findFile(mIndex, name, mStrict);
+        if (file == nullptr)
+            throw std::runtime_error("Resource '" + normalizeFilename(name) + "' not found");
+        return file->open();
     }
 
     Files::IStreamPtr Manager::getNormalized(const std::string& normalizedName) const
     {
-        std::map<std::string, File*>::const_iterator found = mIndex.find(normalizedName);
-        if (found == mIndex.end())
+        File* const file = mIndex.find(normalizedName);
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + normalizedName + "' not found");
-        return found->second->open();
+        return file->open();
     }
 
     bool Manager::exists(std::string_view name) const
     {
-        std::string normalized(name);
-        normalize_path(normalized, mStrict);
-
-        return mIndex.find(normalized) != mIndex.end();
+        return findFile(mIndex, name, mStrict) != nullptr;
     }
 
     std::string Manager::normalizeFilename(std::string_view name) const
@@ -106,10 +114,18 @@ namespace VFS
         std::string normalized = Files::pathToUnicodeString(name);
         normalize_path(normalized, mStrict);
 
-        const auto found = mIndex.find(normalized);
-        if (found == mIndex.end())
+        File* const file = mIndex.find(normalized);
+        if (file == nullptr)
             throw std::runtime_error("Resource '" + normalized + "' not found");
-        return found->second->getPath();
+        return file->getPath();
+    }
+
+    std::filesystem::path Manager::getCompressedArchivePath(std::string_view name) const
+    {
+        File* const file = findFile(mIndex, name, mStrict);
+        if (file == nullptr)
+            throw std::runtime_error("Resource '" + std::string(name) + "' not found");
+        return file->getCompressedArchivePath();
     }
 
     namespace
@@ -125,10 +141,10 @@ namespace VFS
         if (path.empty())
             return { mIndex.begin(), mIndex.end() };
         auto normalized = normalizeFilename(path);
-        const auto it = mIndex.lower_bound(normalized);
+        const auto it = mIndex.lowerBound(normalized);
         if (it == mIndex.end() || !startsWith(it->first, normalized))
             return { it, it };
         ++normalized.back();
-        return { it, mIndex.lower_bound(normalized) };
+        return { it, mIndex.lowerBound(normalized) };
     }
 }
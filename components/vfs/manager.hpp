@@ -3,8 +3,9 @@
 
 #include <components/files/istreamptr.hpp>
 
+#include "fileindex.hpp"
+
 #include <filesystem>
-#include <map>
 #include <memory>
 #include <string>
 #include <vector>
@@ -42,7 +43,7 @@ namespace VFS
         class RecursiveDirectoryIterator
         {
         public:
-            RecursiveDirectoryIterator(std::map<std::string, File*>::const_iterator it)
+            RecursiveDirectoryIterator(FileIndex::const_iterator it)
                 : mIt(it)
             {
             }
@@ -56,7 +57,7 @@ namespace VFS
             }
 
         private:
-            std::map<std::string, File*>::const_iterator mIt;
+            FileIndex::const_iterator mIt;
         };
 
         using RecursiveDirectoryRange = IteratorPair<RecursiveDirectoryIterator>;
@@ -109,12 +110,18 @@ namespace VFS
         /// @note May be called from any thread once the index has been built.
         std::filesystem::path getAbsoluteFileName(const std::filesystem::path& name) const;
 
+        /// Retrieve the path to the compressed archive containing the file, empty path for loose files and files of
+        /// uncompressed archives
+        /// @note Throws an exception if the file can not be found.
+        /// @note May be called from any thread once the index has been built.
+        std::filesystem::path getCompressedArchivePath(std::string_view name) const;
+
     private:
         bool mStrict;
 
         std::vector<std::unique_ptr<Archive>> mArchives;
 
-        std::map<std::string, File*> mIndex;
+        FileIndex mIndex;
     };
 
 }
@@ -1,11 +1,13 @@
 #include "registerarchives.hpp"
 
+#include <chrono>
 #include <filesystem>
 #include <set>
 #include <stdexcept>
 
 #include <components/debug/debuglog.hpp>
 
+#include <components/vfs/archiveindexcache.hpp>
 #include <components/vfs/bsaarchive.hpp>
 #include <components/vfs/filesystemarchive.hpp>
 #include <components/vfs/manager.hpp>
@@ -14,8 +16,11 @@ namespace VFS
 {
 
     void registerArchives(VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles)
+        const std::vector<std::string>& archives, bool useLooseFiles, const BsaArchiveOptions& bsaOptions)
     {
+        const auto start = std::chrono::steady_clock::now();
+        const std::size_t indexCacheHits = bsaOptions.mIndexCache == nullptr ? 0 : bsaOptions.mIndexCache->getHits();
+
         const Files::PathContainer& dataDirs = collections.getPaths();
 
         for (std::vector<std::string>::const_iterator archive = archives.begin(); archive != archives.end(); ++archive)
@@ -28,9 +33,9 @@ namespace VFS
                 Bsa::BsaVersion bsaVersion = Bsa::CompressedBSAFile::detectVersion(archivePath);
 
                 if (bsaVersion == Bsa::BSAVER_COMPRESSED)
-                    vfs->addArchive(std::make_unique<CompressedBsaArchive>(archivePath));
+                    vfs->addArchive(std::make_unique<CompressedBsaArchive>(archivePath, bsaOptions));
                 else
-                    vfs->addArchive(std::make_unique<BsaArchive>(archivePath));
+                    vfs->addArchive(std::make_unique<BsaArchive>(archivePath, bsaOptions));
             }
             else
             {
@@ -55,6 +60,15 @@ namespace VFS
         }
 
         vfs->buildIndex();
+
+        const auto finish = std::chrono::steady_clock::now();
+
+        Log log(Debug::Info);
+        log << "VFS index is built in "
+            << std::chrono::duration_cast<std::chrono::duration<float, std::milli>>(finish - start).count() << "ms";
+        if (bsaOptions.mIndexCache != nullptr)
+            log << ", " << bsaOptions.mIndexCache->getHits() - indexCacheHits << " of " << archives.size()
+                << " BSA archives are opened using cached file tables";
     }
 
 }
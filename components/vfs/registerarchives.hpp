@@ -3,13 +3,16 @@
 
 #include <components/files/collections.hpp>
 
+#include "bsaarchiveoptions.hpp"
+
 namespace VFS
 {
     class Manager;
 
     /// @brief Register BSA and file system archives based on the given OpenMW configuration.
+    /// @param bsaOptions Options used to open BSA archives.
     void registerArchives(VFS::Manager* vfs, const Files::Collections& collections,
-        const std::vector<std::string>& archives, bool useLooseFiles);
+        const std::vector<std::string>& archives, bool useLooseFiles, const BsaArchiveOptions& bsaOptions = {});
 }
 
 #endif
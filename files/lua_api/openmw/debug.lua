@@ -49,4 +49,11 @@
 ---
 -- To reload modified shaders
 -- @function [parent=#debug] triggerShaderReload
+
+---
+-- Move actors back by the given number of physics steps and simulate these steps again with the recorded movement.
+-- Requires `recorded steps` in the `[Physics]` settings section to be greater than the number of steps.
+-- Difference between the recorded and the replayed actor positions is written to `openmw.log`.
+-- @function [parent=#debug] replayPhysics
+-- @param #number steps
 return nil
@@ -71,6 +71,18 @@
 --     radius = 10,
 -- })
 
+---
+-- Asynchronously cast ray from one point to another and find the first collision.
+-- The ray is cast by the physics threads in parallel with other requests, the callback is called during the next frame.
+-- @function [parent=#nearby] asyncCastRay
+-- @param openmw.async#Callback callback The callback to pass the result to (should accept a single argument @{openmw.nearby#RayCastingResult}).
+-- @param openmw.util#Vector3 from Start point of the ray.
+-- @param openmw.util#Vector3 to End point of the ray.
+-- @param #table options An optional table with additional optional arguments, the same as in `castRay`.
+-- @usage nearby.asyncCastRay(async:callback(function(res)
+--     if res.hit then print('obstacle at', res.hitPos) end
+-- end), self.position, enemy.position, {ignore=self})
+
 ---
 -- Cast ray from one point to another and find the first visual intersection with anything in the scene.
 -- As opposite to `castRay` can find an intersection with an object without collisions.